@@ -67,8 +67,12 @@ void ClingoApp::initOptions(ProgramOptions::OptionContext& root) {
          "      [no-]file-included:         #include \"a.lp\". #include \"a.lp\".\n"
          "      [no-]operation-undefined:   p(1/0).\n"
          "      [no-]variable-unbounded:    $x > 10.\n"
-         "      [no-]global-variable:       :- #count { X } = 1, X = 1.\n")
+         "      [no-]global-variable:       :- #count { X } = 1, X = 1.\n"
+         "      [no-]query-ignored:         #query p. { p }.\n")
         ("rewrite-minimize"         , flag(grOpts_.rewriteMinimize = false), "Rewrite minimize constraints into rules")
+        ("translate-csp"            , flag(grOpts_.translateCsp = false), "Translate linear constraints into rules instead of propagating them")
+        ("native-aggregates"        , flag(grOpts_.nativeAggregates = false), "Pass aggregates to the solver as weight constraints")
+        ("dedup-rules"              , storeTo(grOpts_.dedupRules = 0)->arg("<n>"), "Drop duplicate and subsumed rules among the last %A rules of a step")
         ("foobar,@4"                , storeTo(grOpts_.foobar, parseFoobar) , "Foobar")
         ;
     root.add(gringo);
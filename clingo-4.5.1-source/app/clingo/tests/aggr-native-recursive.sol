@@ -0,0 +1,5 @@
+Step: 1
+d e g h
+e g h
+h
+SAT
@@ -0,0 +1 @@
+--native-aggregates
@@ -0,0 +1,4 @@
+Step: 1
+m q(2)
+q(1) q(4)
+SAT
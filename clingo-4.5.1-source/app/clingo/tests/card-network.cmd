@@ -0,0 +1 @@
+--trans-ext=large --project
@@ -0,0 +1,4 @@
+Step: 1
+
+all
+SAT
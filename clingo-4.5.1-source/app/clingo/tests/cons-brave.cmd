@@ -0,0 +1 @@
+-t 4 --enum-mode=brave --quiet=1
@@ -0,0 +1,3 @@
+Step: 1
+p(1) p(2) p(3) p(4) p(5) p(6) q r
+SAT
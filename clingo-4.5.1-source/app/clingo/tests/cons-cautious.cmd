@@ -0,0 +1 @@
+-t 4 --enum-mode=cautious --quiet=1
@@ -0,0 +1,3 @@
+Step: 1
+q
+SAT
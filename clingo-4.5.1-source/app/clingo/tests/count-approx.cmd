@@ -0,0 +1 @@
+--count=approx --seed=1 --quiet=2
@@ -0,0 +1,3 @@
+Step: 1
+SAT
+Count: approximate
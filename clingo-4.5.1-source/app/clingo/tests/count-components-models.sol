@@ -0,0 +1,20 @@
+Step: 1
+a(1) a(3) b(1)
+a(1) a(3) b(1) b(2)
+a(1) a(3) b(2)
+a(1) b(1)
+a(1) b(1) b(2)
+a(1) b(2)
+a(2) a(3) b(1)
+a(2) a(3) b(1) b(2)
+a(2) a(3) b(2)
+a(2) b(1)
+a(2) b(1) b(2)
+a(2) b(2)
+a(3) b(1)
+a(3) b(1) b(2)
+a(3) b(2)
+b(1)
+b(1) b(2)
+b(2)
+SAT
@@ -0,0 +1,9 @@
+Step: 1
+p(1)
+p(1) p(2)
+p(1) p(2) p(3)
+p(1) p(3)
+p(2)
+p(2) p(3)
+p(3)
+SAT
@@ -0,0 +1 @@
+--count=exact --quiet=2 --project
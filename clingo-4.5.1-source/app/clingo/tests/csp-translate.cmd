@@ -0,0 +1 @@
+--translate-csp
@@ -0,0 +1,5 @@
+Step: 1
+p x=1 y=2
+p x=2 y=1
+x=1 y=1
+SAT
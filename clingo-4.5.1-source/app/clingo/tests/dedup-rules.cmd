@@ -0,0 +1 @@
+--dedup-rules=1000
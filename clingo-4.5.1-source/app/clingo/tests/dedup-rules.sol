@@ -0,0 +1,9 @@
+Step: 1
+
+q(1) q(2) r
+q(1) q(3) r
+q(1) r
+q(2) q(3) r
+q(2) r
+q(3) r
+SAT
@@ -0,0 +1,10 @@
+Step: 1
+a c x
+a c y
+a x
+a y
+c x
+c y
+x
+y
+SAT
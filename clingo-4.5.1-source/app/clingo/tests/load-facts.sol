@@ -0,0 +1,3 @@
+Step: 1
+p(-2,"x;y","007") p(1,a,"b,c") q(3,c) q(a,b) r(-2) r(1)
+SAT
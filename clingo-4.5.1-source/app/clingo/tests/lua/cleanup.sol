@@ -0,0 +1,3 @@
+Step: 1
+domain(a(1),true,false) domain(a(2),true,false) domain(a(3),true,false) domain(b(1),false,false) domain(b(3),false,false) domain(c(1),false,false) domain(c(3),false,false) domain(e(1),false,true) domain(e(2),false,true)
+UNKNOWN
@@ -0,0 +1,5 @@
+Step: 1
+b
+Step: 2
+b d
+SAT
@@ -0,0 +1,16 @@
+Step: 1
+a
+Step: 2
+a
+a c
+c
+Step: 3
+a c x
+a c y
+a x
+a y
+c x
+c y
+x
+y
+SAT
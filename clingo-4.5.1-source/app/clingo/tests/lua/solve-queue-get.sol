@@ -0,0 +1,3 @@
+Step: 1
+large(false) negative(false) sat(true)
+SAT
@@ -0,0 +1,7 @@
+Step: 1
+a b c
+a c
+b c
+c
+hasA(false) hasA(false) hasA(true) hasA(true) model(a,b,c) model(a,c) model(b,c) model(c)
+SAT
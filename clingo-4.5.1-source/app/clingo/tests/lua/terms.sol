@@ -0,0 +1,3 @@
+Step: 1
+args(1) args(2) args(a) args(b) arity(c,0) arity(f(1,a),2) arity(f(2,b),2) first(f(1,a),1) first(f(2,b),2) p(c) p(f(1,a)) p(f(2,b)) same(c,0) same(f(1,a),1) same(f(2,b),0)
+SAT
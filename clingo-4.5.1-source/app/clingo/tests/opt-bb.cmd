@@ -0,0 +1 @@
+--opt-strategy=bb --quiet=1
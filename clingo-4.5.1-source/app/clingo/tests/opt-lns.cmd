@@ -0,0 +1 @@
+--opt-strategy=lns,1 --opt-lns=50,20 --quiet=1
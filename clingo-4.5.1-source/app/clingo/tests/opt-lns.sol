@@ -0,0 +1,3 @@
+Step: 1
+cover(3) cover(4) cover(6) cover(8)
+OPTIMUM FOUND
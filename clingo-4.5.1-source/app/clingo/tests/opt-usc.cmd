@@ -0,0 +1 @@
+--opt-strategy=usc,8 --quiet=1
@@ -0,0 +1 @@
+prefetch-a.inc prefetch-missing.inc prefetch-b.inc
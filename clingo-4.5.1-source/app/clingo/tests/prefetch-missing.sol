@@ -0,0 +1 @@
+ERROR
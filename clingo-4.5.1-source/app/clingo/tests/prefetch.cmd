@@ -0,0 +1 @@
+prefetch-a.inc prefetch-b.inc - prefetch-a.inc
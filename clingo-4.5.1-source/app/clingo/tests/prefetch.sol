@@ -0,0 +1,3 @@
+Step: 1
+p(0) p(1) p(2) p(3) p(4) q(1) q(2) q(3) q(4)
+SAT
@@ -0,0 +1,3 @@
+Step: 1
+huge(2) lookup(p(2),true,false,true) lookup(p(4),false,false,false) lookup(q(1),true,true,false) negative(false) scan(p(1),true,false) scan(p(2),false,true) scan(p(3),false,false)
+UNKNOWN
@@ -0,0 +1,3 @@
+Step: 1
+sat(true) size(-1,false) size(65537,false)
+SAT
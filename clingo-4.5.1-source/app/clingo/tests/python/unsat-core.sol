@@ -0,0 +1,7 @@
+Step: 1
+a
+Step: 2
+Step: 3
+Step: 4
+core(b,true) core(c,true) min(b,true) min(c,true) next(a,true) next(b,true) sat(0)
+UNSAT
@@ -0,0 +1,3 @@
+Step: 1
+path(b,a) path(b,b) path(b,c)
+SAT
@@ -0,0 +1,2 @@
+Step: 1
+UNSAT
@@ -8,6 +8,7 @@ function normalize() {
     current=( )
     step=0
     result="ERROR"
+    count=""
     while read line; do
         if [[ next -eq 1 ]]; then
             if [[ step -gt 0 ]]; then
@@ -42,9 +43,17 @@ function normalize() {
         elif [[ "$line" =~ "^OPTIMUM FOUND" ]]; then
             result="OPTIMUM FOUND"
             next=1
+        elif [[ "$line" =~ "^ *Count *: " ]]; then
+            count=${line#*: }
         fi
     done
     print "$result"
+    # approximate counts depend on the hash functions drawn
+    if [[ "$count" == *" (exact)" ]]; then
+        print "Count: ${count% (exact)}"
+    elif [[ -n "$count" ]]; then
+        print "Count: approximate"
+    fi
 }
 
 function usage() {
@@ -81,6 +90,8 @@ else
     clingo="$1"
     shift
 fi
+# tests are run in the test directory
+[[ "$clingo" == */* ]] && clingo=${clingo:A}
 if [[ $# > 0 && "$1" != "--" ]] then
     usage
     exit 1
@@ -93,12 +104,16 @@ if [[ $norm == 1 ]]; then
         opts=$(cat "$name.cmd")
         opts=(${(s: :)opts})
     fi
-    $clingo 0 "${opts[@]}" "$file" "$@" | normalize
+    input=/dev/null
+    [[ -e "$name.stdin" ]] && input="$name.stdin"
+    $clingo 0 "${opts[@]}" "$file" "$@" < "$input" | normalize
     exit 0
 else
     run=0
     fail=0
     failures=()
+    # input files given in .cmd files are relative to the test directory
+    cd "$wd"
     for x in $wd/**/*.lp; do
         run=$[run+1]
         name=${x%.lp}
@@ -107,7 +122,9 @@ else
             opts=$(cat "$name.cmd")
             opts=(${(s: :)opts})
         fi
-        if $clingo 0 $x -Wno-operation-undefined -Wno-atom-undefined "${opts[@]}" "$@" | normalize | diff - "$name.sol"; then
+        input=/dev/null
+        [[ -e "$name.stdin" ]] && input="$name.stdin"
+        if $clingo 0 $x -Wno-operation-undefined -Wno-atom-undefined "${opts[@]}" "$@" < "$input" | normalize | diff - "$name.sol"; then
             print -n "."
         else
             print -n "F"
@@ -52,7 +52,9 @@ struct GringoOptions {
     bool                        wNoFileIncluded       = false;
     bool                        wNoVariableUnbounded  = false;
     bool                        wNoGlobalVariable     = false;
+    bool                        wNoQueryIgnored       = false;
     bool                        rewriteMinimize       = false;
+    unsigned                    dedupRules            = 0;
     Foobar foobar;
 };
 
@@ -94,6 +96,7 @@ struct IncrementalControl : Gringo::Control, Gringo::GringoModule {
         if (opts.wNoFileIncluded)       { message_printer()->disable(W_FILE_INCLUDED); }
         if (opts.wNoVariableUnbounded)  { message_printer()->disable(W_VARIABLE_UNBOUNDED); }
         if (opts.wNoGlobalVariable)     { message_printer()->disable(W_GLOBAL_VARIABLE); }
+        if (opts.wNoQueryIgnored)       { message_printer()->disable(W_QUERY_IGNORED); }
         for (auto &x : opts.defines) { 
             LOG << "define: " << x << std::endl;
             parser.parseDefine(x);
@@ -164,6 +167,10 @@ struct IncrementalControl : Gringo::Control, Gringo::GringoModule {
         parser.pushFile(std::string(filename));
         parse();
     }
+    virtual void loadFacts(std::string const &filename, Gringo::FWString predicate, std::string const &format, bool header) {
+        parser.loadFacts(filename, predicate, format, header);
+        parsed = true;
+    }
     virtual void onModel(Gringo::Model const &) { }
     virtual bool blocked() { return false; }
     virtual Gringo::SolveResult solve(ModelHandler, Assumptions &&ass) {
@@ -175,7 +182,7 @@ struct IncrementalControl : Gringo::Control, Gringo::GringoModule {
         out.finish();
         return Gringo::SolveResult::UNKNOWN;
     }
-    virtual Gringo::SolveIter *solveIter(Assumptions &&) { 
+    virtual Gringo::SolveIter *solveIter(Assumptions &&, unsigned) { 
         throw std::runtime_error("solving not supported in gringo");
     }
     virtual Gringo::SolveFuture *solveAsync(ModelHandler, FinishHandler, Assumptions &&) { throw std::runtime_error("solving not supported in gringo"); }
@@ -195,6 +202,7 @@ struct IncrementalControl : Gringo::Control, Gringo::GringoModule {
     virtual Control *newControl(int, char const **) { throw std::logic_error("creating new control instances not supported in gringo"); }
     virtual void freeControl(Control *) { throw std::logic_error("creating new control instances not supported in gringo"); }
     virtual void cleanupDomains() { }
+    virtual Assumptions unsatCore(bool, double) { throw std::runtime_error("solving not supported in gringo"); }
 
     Gringo::Input::GroundTermParser        termParser;
     Gringo::Output::OutputBase            &out;
@@ -226,6 +234,8 @@ static bool parseWarning(const std::string& str, GringoOptions& out) {
     if (str ==    "variable-unbounded")  { out.wNoVariableUnbounded  = false; return true; }
     if (str == "no-global-variable")     { out.wNoGlobalVariable     = true;  return true; }
     if (str ==    "global-variable")     { out.wNoGlobalVariable     = false; return true; }
+    if (str == "no-query-ignored")       { out.wNoQueryIgnored       = true;  return true; }
+    if (str ==    "query-ignored")       { out.wNoQueryIgnored       = false; return true; }
     return false;
 }
 
@@ -257,8 +267,10 @@ protected:
              "      [no-]file-included:         #include \"a.lp\". #include \"a.lp\".\n"
              "      [no-]operation-undefined:   p(1/0).\n"
              "      [no-]variable-unbounded:    $x > 10.\n"
-             "      [no-]global-variable:       :- #count { X } = 1, X = 1.\n")
+             "      [no-]global-variable:       :- #count { X } = 1, X = 1.\n"
+             "      [no-]query-ignored:         #query p. { p }.\n")
             ("rewrite-minimize"         , flag(grOpts_.rewriteMinimize = false), "Rewrite minimize constraints into rules")
+            ("dedup-rules"              , storeTo(grOpts_.dedupRules = 0)->arg("<n>"), "Drop duplicate and subsumed rules among the last %A rules of a step")
             ("foobar,@4"                , storeTo(grOpts_.foobar, parseFoobar), "Foobar")
             ;
         root.add(gringo);
@@ -336,8 +348,9 @@ protected:
             ground(out);
         }
         else {
-            Output::PlainLparseOutputter plo(std::cout);
-            Output::OutputBase out(std::move(outPreds), plo);
+            Output::ULparseOutputter plo(new Output::PlainLparseOutputter(std::cout));
+            if (grOpts_.dedupRules > 0) { plo.reset(new Output::DedupLparseOutputter(std::move(plo), grOpts_.dedupRules)); }
+            Output::OutputBase out(std::move(outPreds), *plo);
             ground(out);
         }
     }
@@ -0,0 +1,31 @@
+#!/bin/bash
+# usage: compare.sh OLD_CLINGO NEW_CLINGO [RUNS]
+#
+# Grounds arith.lp and deep.lp RUNS times (default 5) with both binaries and
+# prints the median grounding time of each together with the relative change.
+
+if [[ $# -lt 2 ]]; then
+    echo "usage: $0 OLD_CLINGO NEW_CLINGO [RUNS]" >&2
+    exit 1
+fi
+
+old=$1
+new=$2
+runs=${3:-5}
+dir=$(dirname "$0")
+
+median() {
+    local bin=$1; shift
+    for ((i = 0; i < runs; ++i)); do
+        "$bin" "$dir/bench.lp" "$@" -q 2>/dev/null | sed -n 's/^Ground *: *\([0-9.]*\)s$/\1/p'
+    done | sort -n | awk '{ t[NR] = $1 } END { print t[int((NR + 1) / 2)] }'
+}
+
+printf "%-24s %10s %10s %8s\n" "encoding" "old" "new" "change"
+for args in "arith.lp" "arith.lp -c n=800" "deep.lp" "deep.lp -c n=200000"; do
+    set -- $args
+    file=$1; shift
+    a=$(median "$old" "$dir/$file" "$@")
+    b=$(median "$new" "$dir/$file" "$@")
+    printf "%-24s %9.3fs %9.3fs %7.1f%%\n" "$args" "$a" "$b" "$(awk -v a="$a" -v b="$b" 'BEGIN { print (a > 0 ? 100 * (b - a) / a : 0) }')"
+done
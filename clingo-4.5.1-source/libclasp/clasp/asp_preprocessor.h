@@ -112,10 +112,12 @@ private:
 	}
 	// ------------------------------------------------------------------------
 	typedef PodVector<BodyExtra>::type BodyData;
+	typedef PodVector<PrgEdge>::type   EdgeVec;
 	LogicProgram* prg_;      // program to preprocess
 	VarVec        follow_;   // bodies yet to classify
 	BodyData      bodyInfo_; // information about the program nodes
 	VarVec        litToNode_;// the roots of our equivalence classes
+	EdgeVec       heads_;    // heads of the body added to upper
 	uint32        pass_;     // current iteration number
 	uint32        maxPass_;  // force stop after maxPass_ iterations
 	EqType        type_;     // type of eq-preprocessing
@@ -31,6 +31,10 @@ namespace Clasp {
 //! Enumerator for computing the brave/cautious consequences of a logic program.
 /*!
  * \ingroup enumerator
+ * 
+ * In parallel solving, the solvers share the set of atoms that are already decided,
+ * partition the remaining atoms among themselves, and prefer (and, on their root level, 
+ * assume) values that would decide atoms of their own partition.
  */
 class CBConsequences : public Enumerator {
 public:
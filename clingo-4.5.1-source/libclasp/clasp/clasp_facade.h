@@ -56,6 +56,7 @@ namespace Clasp {
 	struct SolveOptions : Clasp::BasicSolveOptions, EnumOptions {};
 }
 #endif
+#include <clasp/model_counter.h>
 
 /*!
  * \file 
@@ -151,6 +152,8 @@ public:
 		bool                 unsat()        const { return result.unsat(); }
 		bool                 complete()     const { return result.exhausted(); }
 		const char*          consequences() const;
+		//! Returns the counter of the run if models were counted (see EnumOptions::countMode).
+		const ModelCounter*  counter()      const;
 		bool                 optimize()     const;
 		const Model*         model()        const;
 		const SumVec*        costs()        const { return model() ? model()->costs : 0; }
@@ -327,6 +330,16 @@ public:
 	int                step()                const { return (int)step_.step;}
 	//! Returns the result of the active step. (unknown if run is not yet completed).
 	Result             result()              const { return step_.result; }
+	//! Returns the assumptions of the active step.
+	const LitVec&      assumptions()         const { return assume_; }
+	//! Returns the subset of assumptions() on which the unsatisfiability of the active step depends.
+	/*!
+	 * \return The unsatisfiable core or 0 if the step is not (yet) unsatisfiable
+	 *         or the active solve algorithm does not support core extraction.
+	 */
+	const LitVec*      unsatCore()           const;
+	//! Returns the model counter of the active step or 0 if models are enumerated.
+	const ModelCounter* counter()            const;
 	//! Returns the active program or 0 if it was already released.
 	ProgramBuilder*    program()             const { return builder_.get(); }
 	Enumerator*        enumerator()          const;
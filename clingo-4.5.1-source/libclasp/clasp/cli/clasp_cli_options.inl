@@ -75,7 +75,7 @@
 #if defined(CLASP_CONTEXT_OPTIONS)
 #define SELF CLASP_CONTEXT_OPTIONS
 GROUP_BEGIN(SELF)
-OPTION(stats, ",s"  , ARG(implicit("1")->arg("{0..2}")), "Maintain {0=no|1=basic|2=extended} statistics", STORE_LEQ(SELF.stats,2u), toString(SELF.stats))
+OPTION(stats, ",s"  , ARG(implicit("1")->arg("{0..3}")), "Maintain {0=no|1=basic|2=extended|3=propagation} statistics", STORE_LEQ(SELF.stats,3u), toString(SELF.stats))
 OPTION(share, "!,@1", ARG(defaultsTo("auto")->state(Value::value_defaulted), DEFINE_ENUM_MAPPING(ContextParams::ShareMode, \
        MAP("no"  , ContextParams::share_no)  , MAP("all", ContextParams::share_all),\
        MAP("auto", ContextParams::share_auto), MAP("problem", ContextParams::share_problem),\
@@ -103,20 +103,31 @@ GROUP_END(SELF)
 #define SELF CLASP_SOLVER_OPTIONS
 GROUP_BEGIN(SELF)
 OPTION(opt_strategy , ""  , ARG(arg("<arg>")->implicit("1"), DEFINE_ENUM_MAPPING(MinimizeMode_t::Strategy,\
-       MAP("bb", MinimizeMode_t::opt_bb), MAP("usc", MinimizeMode_t::opt_usc))),  "Configure optimization strategy\n" \
-       "      %A: {bb|usc}[,<n>]\n" \
+       MAP("bb", MinimizeMode_t::opt_bb), MAP("usc", MinimizeMode_t::opt_usc), MAP("lns", MinimizeMode_t::opt_lns))),  "Configure optimization strategy\n" \
+       "      %A: {bb|usc|lns}[,<n>]\n" \
        "        bb : branch and bound based optimization with <n = {0..3}>\n"  \
        "          1: hierarchical steps\n"                                     \
        "          2: exponentially increasing steps\n"                         \
        "          3: exponentially decreasing steps\n"                         \
-       "        usc: unsatisfiable-core based optimization with <n = {0..7}>\n"\
+       "        usc: unsatisfiable-core based optimization with <n = {0..15}>\n"\
        "          1: disjoint-core preprocessing\n"                            \
        "          2: implications instead of equivalences\n"                   \
-       "          4: clauses instead of cardinality constraints"               \
+       "          4: clauses instead of cardinality constraints\n"             \
+       "          8: stratify weights, trim and exhaust cores, share cores\n"   \
+       "        lns: large neighborhood search (see opt-lns) with <n = {0..2}>\n"\
+       "          0: free random atoms\n"                                     \
+       "          1: free atoms of random predicates\n"                       \
+       "          2: free atoms of random constraints"                         \
        , FUN(str) { ARG_T(MinimizeMode_t::Strategy, uint32) arg(MinimizeMode_t::opt_bb, 0); uint32 n;\
-         return ITE(stringTo(str, arg), SET(SELF.optStrat, (uint32)arg.first) && SET(SELF.optParam, arg.second) && (arg.first != 0 || arg.second < 4),\
+         return ITE(stringTo(str, arg), SET(SELF.optStrat, (uint32)arg.first) && SET(SELF.optParam, arg.second) && (arg.first == MinimizeMode_t::opt_usc || arg.second < (arg.first == MinimizeMode_t::opt_bb ? 4u : 3u)),\
                     stringTo(str, n) && SET(SELF.optStrat, uint32(n>3)) && SET(SELF.optParam, (n > 3 ? n - 4:n)) && n <= 11u);}\
        , toString(static_cast<MinimizeMode_t::Strategy>(SELF.optStrat), SELF.optParam))
+OPTION(opt_lns      , ""  , ARG(arg("<fix>[,<n>]")), "Configure large neighborhood search\n" \
+       "      Fix <fix>%% of the atoms of the best model and search\n"       \
+       "      the other atoms for at most <n> conflicts (initially)"          \
+       , FUN(str) { ARG_T(uint32, uint32) arg(80, 1000);\
+         return stringTo(str, arg) && arg.first <= 100u && SET(SELF.lnsFix, arg.first) && SET_OR_FILL(SELF.lnsConf, arg.second);}\
+       , toString(SELF.lnsFix, SELF.lnsConf))
 OPTION(opt_heuristic, ""  , ARG(implicit("1")->arg("{0..3}")), "Use opt. in {1=sign|2=model|3=both} heuristics", STORE_LEQ(SELF.optHeu,  3u), toString(SELF.optHeu))
 OPTION(restart_on_model, "", ARG(flag()), "Restart after each model\n", STORE_FLAG(SELF.restartOnModel), toString(SELF.restartOnModel))
 OPTION(lookahead    , "!", ARG(implicit("atom"), DEFINE_ENUM_MAPPING(Lookahead::Type, \
@@ -321,16 +332,18 @@ OPTION(trans_ext  , "!", ARG(arg("<mode>"), DEFINE_ENUM_MAPPING(Asp::LogicProgra
        MAP("no"    , Asp::LogicProgram::mode_native)          , MAP("all" , Asp::LogicProgram::mode_transform),\
        MAP("choice", Asp::LogicProgram::mode_transform_choice), MAP("card", Asp::LogicProgram::mode_transform_card),\
        MAP("weight", Asp::LogicProgram::mode_transform_weight), MAP("scc" , Asp::LogicProgram::mode_transform_scc),\
-       MAP("integ" , Asp::LogicProgram::mode_transform_integ) , MAP("dynamic", Asp::LogicProgram::mode_transform_dynamic))),\
+       MAP("integ" , Asp::LogicProgram::mode_transform_integ) , MAP("dynamic", Asp::LogicProgram::mode_transform_dynamic),\
+       MAP("large" , Asp::LogicProgram::mode_transform_large))),\
        "Configure handling of Lparse-like extended rules\n"\
-       "      %A: {all|choice|card|weight|integ|dynamic}\n"\
+       "      %A: {all|choice|card|weight|integ|dynamic|large}\n"\
        "        all    : Transform all extended rules to basic rules\n"\
        "        choice : Transform choice rules, but keep cardinality and weight rules\n"\
        "        card   : Transform cardinality rules, but keep choice and weight rules\n"\
        "        weight : Transform cardinality and weight rules, but keep choice rules\n"\
        "        scc    : Transform \"recursive\" cardinality and weight rules\n"\
        "        integ  : Transform cardinality integrity constraints\n"\
-       "        dynamic: Transform \"simple\" extended rules, but keep more complex ones", STORE(SELF.erMode), toString((Asp::LogicProgram::ExtendedRuleMode)SELF.erMode))
+       "        dynamic: Transform \"simple\" extended rules, but keep more complex ones\n"\
+       "        large  : Transform large cardinality and weight rules to sorting networks", STORE(SELF.erMode), toString((Asp::LogicProgram::ExtendedRuleMode)SELF.erMode))
 GROUP_END(SELF)
 #undef CLASP_ASP_OPTIONS
 #undef SELF
@@ -417,6 +430,17 @@ OPTION(opt_bound, "!" , ARG(arg("<opt>...")), "Initialize objective function(s)"
        TO_STR_IF(!SELF.optBound.empty(), SELF.optBound))
 OPTION(opt_sat  , ""  , ARG(flag())         , "Treat DIMACS input as MaxSAT optimization problem", STORE(SELF.maxSat), toString(SELF.maxSat))
 OPTION(project , ""  , ARG(implicit("6"))  , "Project models to named atoms", STORE_LEQ(SELF.project,7u), toString(SELF.project))
+OPTION(count   , ""  , ARG(arg("<arg>")->implicit("exact"), DEFINE_ENUM_MAPPING(SolveOptions::CountMode, \
+       MAP("no", SolveOptions::count_no), MAP("exact", SolveOptions::count_exact), MAP("approx", SolveOptions::count_approx))), \
+       "Count (projected) models instead of enumerating them\n" \
+       "      %A: {no|exact|approx}[,<e>,<d>]\n" \
+       "        exact : Count components of the problem and cache their counts\n" \
+       "        approx: Count with xor hashing s.t. with probability 1-<d>\n" \
+       "                the count is within a factor of 1+<e> [0.8,0.2]" \
+       , FUN(str) { ARG_T(SolveOptions::CountMode, double, double) arg(SolveOptions::count_exact, 0.8, 0.2);\
+         return stringTo(str, arg) && arg.second > 0.0 && arg.third > 0.0 && arg.third < 1.0 \
+           && SET(SELF.countMode, (uint32)arg.first) && ((SELF.countEps = arg.second), (SELF.countDelta = arg.third), true);}\
+       , toString((SolveOptions::CountMode)SELF.countMode, SELF.countEps, SELF.countDelta))
 OPTION(models  , ",n", ARG(arg("<n>"))     , "Compute at most %A models (0 for all)\n", STORE(SELF.numModels), toString(SELF.numModels))
 GROUP_END(SELF)
 #undef CLASP_SOLVE_OPTIONS
@@ -125,6 +125,7 @@ public:
 	virtual void visitCoreSolverStats(double cpuTime, uint64 models, const SolverStats& stats, bool accu) = 0;
 	virtual void visitExtSolverStats(const ExtendedStats& stats, bool accu) = 0;
 	virtual void visitJumpStats(const JumpStats& stats, bool accu) = 0;
+	virtual void visitPropStats(const PropStats& stats, bool accu) = 0;
 	virtual void accuStats(const SharedContext& ctx, SolverStats& out) const;
 
 	bool accu;
@@ -152,6 +153,7 @@ private:
 	virtual void visitCoreSolverStats(double cpuTime, uint64 models, const SolverStats& stats, bool accu);
 	virtual void visitExtSolverStats(const ExtendedStats& stats, bool accu);
 	virtual void visitJumpStats(const JumpStats& stats, bool accu);
+	virtual void visitPropStats(const PropStats& stats, bool accu);
 	enum ObjType { type_object, type_array };
 	void pushObject(const char* k = 0, ObjType t = type_object);
 	char popObject();
@@ -232,6 +234,7 @@ protected:
 	virtual void visitCoreSolverStats(double cpuTime, uint64 models, const SolverStats& stats, bool accu);
 	virtual void visitExtSolverStats(const ExtendedStats& stats, bool accu);
 	virtual void visitJumpStats(const JumpStats& stats, bool accu);
+	virtual void visitPropStats(const PropStats& stats, bool accu);
 	virtual void visitThreads(const SharedContext& ctx)      { startSection("Thread");   StatsVisitor::visitThreads(ctx); }
 	virtual void visitThread(uint32 i, const SolverStats& s)  { startObject("Thread", i); StatsVisitor::visitThread(i, s); }
 	virtual void visitHccs(const SharedContext& ctx)         { startSection("Tester");   StatsVisitor::visitHccs(ctx);    }
@@ -63,6 +63,22 @@ struct Constraint_t {
 };  
 typedef Constraint_t::Type ConstraintType;
 typedef Constraint_t::Set  TypeSet;
+
+//! Propagator classes distinguished in propagation statistics.
+struct Propagator_t {
+	enum Class {
+		prop_short     = 0, /**< short implications (binary and ternary clauses) */
+		prop_clause    = 1, /**< clause watches                                  */
+		prop_weight    = 2, /**< cardinality and weight constraints              */
+		prop_minimize  = 3, /**< minimize constraints                            */
+		prop_other     = 4, /**< any other constraint                            */
+		prop_unfounded = 5, /**< unfounded set checking                          */
+		prop_lookahead = 6, /**< lookahead                                       */
+		prop_post      = 7, /**< any other post propagator                       */
+		max_value      = prop_post
+	};
+};
+typedef Propagator_t::Class PropagatorClass;
 //! Type storing a constraint's activity.
 struct Activity {
 	enum { LBD_SHIFT = 7, MAX_LBD = (1 << LBD_SHIFT)-1, MAX_ACT = (1 << (32-LBD_SHIFT))-1 };
@@ -169,6 +185,12 @@ public:
 	 */
 	virtual ClauseHead* clause();
 
+	//! Returns the propagator class to which propagation statistics of this constraint are attributed.
+	/*!
+	 * The default implementation returns Propagator_t::prop_other.
+	 */
+	virtual PropagatorClass propClass() const;
+
 	//! Shall return whether the constraint is valid (i.e. not conflicting) w.r.t the current assignment in s.
 	/*!
 	 * \pre The assignment in s is not conflicting and fully propagated.
@@ -286,6 +308,9 @@ public:
 	 */
 	virtual uint32 priority() const = 0;
 
+	//! Returns Propagator_t::prop_post.
+	virtual PropagatorClass propClass() const;
+
 	//! Called during initialization of s.
 	/*!
 	 * \note During initialization a post propagator may assign variables
@@ -32,6 +32,7 @@ namespace Clasp {
 class Solver;
 class SharedContext;
 class SharedDependencyGraph;
+class BasicSolve;
 struct SolverStats;
 struct SolveTestEvent : SolveEvent<SolveTestEvent> {
 	SolveTestEvent(const Solver& s, uint32 scc, bool partial);
@@ -54,6 +55,10 @@ struct SolveTestEvent : SolveEvent<SolveTestEvent> {
  * PBDAG is static and read-only and thus can be shared between multiple solvers.
  *
  * \note Initialization is *not* thread-safe, i.e. must be done only once by one thread.
+ * \note The adjacency lists of nodes added in one call to addSccs() are stored in
+ *       a few contiguous memory blocks. For large programs, these lists are filled
+ *       by up to ctx.concurrency() threads.
+ * \note Atoms of one SCC have consecutive ids.
  */
 class SharedDependencyGraph {
 public:
@@ -69,6 +74,11 @@ public:
 	typedef Asp::AtomList     AtomList;
 
 	//! Type for storing a non head-cycle-free component of a disjunctive program.
+	/*!
+	 * Tests are run on one persistent tester solver per generator thread.
+	 * Learnt constraints, search state, and the longest still valid prefix
+	 * of the tester's root path are kept from one test to the next.
+	 */
 	class NonHcfComponent {
 	public:
 		explicit NonHcfComponent(const SharedDependencyGraph& dep, SharedContext& generator, uint32 scc, const VarVec& atoms, const VarVec& bodies);
@@ -83,8 +93,11 @@ public:
 		NonHcfComponent(const NonHcfComponent&);
 		NonHcfComponent& operator=(const NonHcfComponent&);
 		class ComponentMap;
+		typedef PodVector<BasicSolve*>::type SolveVec;
+		void addSolve();
 		SharedContext* prg_;
 		ComponentMap*  comp_;
+		SolveVec       solve_; // one search object per tester solver
 	};
 	typedef std::pair<uint32, NonHcfComponent*> ComponentPair;
 	typedef const ComponentPair* NonHcfIter;
@@ -276,22 +289,27 @@ private:
 	typedef PodVector<AtomNode>::type      AtomVec;
 	typedef PodVector<BodyNode>::type      BodyVec;
 	typedef PodVector<ComponentPair>::type ComponentMap;
+	typedef PodVector<NodeId*>::type       BlockVec;
+	typedef PodVector<PrgBody*>::type      BodyList;
+	class NodeBuilder;
 	SharedDependencyGraph(const SharedDependencyGraph&);
 	SharedDependencyGraph& operator=(const SharedDependencyGraph&);
 	inline bool      relevantPrgAtom(const Solver& s, PrgAtom* a) const;
 	inline bool      relevantPrgBody(const Solver& s, PrgBody* b) const;
 	NodeId           createBody(PrgBody* b, uint32 bScc);
 	NodeId           createAtom(Literal lit, uint32 aScc);
-	NodeId           addBody(const LogicProgram& prg, PrgBody*);
-	NodeId           addDisj(const LogicProgram& prg, PrgDisj*);
+	NodeId           addBody(const LogicProgram& prg, PrgBody*, BodyList& newBodies);
+	NodeId           addDisj(const LogicProgram& prg, PrgDisj*, BodyList& newBodies);
 	uint32           addHeads(const LogicProgram& prg, PrgBody*, VarVec& atoms) const;
 	uint32           getAtoms(const LogicProgram& prg, PrgDisj*, VarVec& atoms) const;
 	void             addPreds(const LogicProgram& prg, PrgBody*, uint32 bScc, VarVec& preds) const;
-	void             initBody(uint32 id, const VarVec& preds, const VarVec& atHeads);
-	void             initAtom(uint32 id, uint32 prop, const VarVec& adj, uint32 preds);
+	void             initBody(uint32 id, const NodeId* preds, uint32 numPreds, const NodeId* atHeads, uint32 numHeads, NodeId* mem);
+	void             initAtom(uint32 id, const NodeId* adj, uint32 size, uint32 numPreds, NodeId* mem);
+	void             buildNodes(NodeBuilder* b, uint32 num);
 	void             addNonHcf(SharedContext& ctx, uint32 scc);
 	AtomVec        atoms_;
 	BodyVec        bodies_;
+	BlockVec       blocks_; // storage for adjacency lists of nodes
 	ComponentMap   components_;
 	uint32         seenComponents_;
 	Configuration* config_;
@@ -62,7 +62,8 @@ struct Model {
 struct EnumOptions {  
 	typedef MinimizeMode OptMode;
 	enum EnumType { enum_auto = 0, enum_bt  = 1, enum_record  = 2, enum_dom_record = 3, enum_consequences = 4, enum_brave = 5, enum_cautious = 6, enum_user = 8 };
-	EnumOptions() : numModels(-1), enumMode(enum_auto), optMode(MinimizeMode_t::optimize), project(0), maxSat(false) {}
+	enum CountMode{ count_no  = 0, count_exact = 1, count_approx = 2 };
+	EnumOptions() : numModels(-1), enumMode(enum_auto), optMode(MinimizeMode_t::optimize), project(0), countMode(count_no), countEps(0.8), countDelta(0.2), maxSat(false) {}
 	static Enumerator* createModelEnumerator(const EnumOptions& opts);
 	static Enumerator* createConsEnumerator(const EnumOptions& opts);
 	static Enumerator* nullEnumerator();
@@ -70,10 +71,14 @@ struct EnumOptions {
 	bool     consequences() const { return (enumMode & enum_consequences) != 0; }
 	bool     models()       const { return (enumMode < enum_consequences); }
 	bool     optimize()     const { return ((optMode  & MinimizeMode_t::optimize) != 0); }
+	bool     counting()     const { return countMode != count_no; }
 	int      numModels; /*!< Number of models to compute. */
 	EnumType enumMode;  /*!< Enumeration type to use.     */
 	OptMode  optMode;   /*!< Optimization mode to use.    */
 	uint32   project;   /*!< Options for projection.      */
+	uint32   countMode; /*!< One of CountMode.            */
+	double   countEps;  /*!< Tolerance of approximate counts.  */
+	double   countDelta;/*!< Error probability of approximate counts. */
 	SumVec   optBound;  /*!< Initial bound for optimize statements. */
 	bool     maxSat;    /*!< Treat DIMACS input as MaxSat */
 };
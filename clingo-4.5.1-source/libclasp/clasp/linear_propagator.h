@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2015, Benjamin Kaufmann
+//
+// This file is part of Clasp. See http://www.cs.uni-potsdam.de/clasp/
+//
+// Clasp is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Clasp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Clasp; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+//
+#ifndef CLASP_LINEAR_PROPAGATOR_H_INCLUDED
+#define CLASP_LINEAR_PROPAGATOR_H_INCLUDED
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#include <clasp/constraint.h>
+#include <clasp/util/atomic.h>
+#include <vector>
+
+namespace Clasp {
+
+//! Linear constraints over order encoded integer variables.
+/*!
+ * \ingroup constraint
+ * An integer variable x with domain v_0 < ... < v_n is given by
+ * order literals o_1, ..., o_n s.th. o_i is true iff x < v_i.
+ * A constraint is of the form h == c_1*x_1 + ... + c_m*x_m <= b,
+ * where h is a literal, b and each c_i are integers, and each x_i is a variable.
+ *
+ * Objects of this class are shared between the propagators of all solvers
+ * and must not be changed once a propagator was created.
+ */
+class SharedLinearData {
+public:
+	typedef SharedLinearData ThisType;
+	//! A term c*x of a linear constraint.
+	struct Term {
+		Term(weight_t c, uint32 x) : coef(c), var(x) {}
+		weight_t coef;
+		uint32   var;
+	};
+	typedef PodVector<Term>::type TermVec;
+	//! A linear constraint h == sum(terms) <= bound.
+	struct Con {
+		Con(Literal h, weight_t b, uint32 f, uint32 l) : head(h), bound(b), first(f), last(l) {}
+		Literal  head;
+		weight_t bound;
+		uint32   first; // index of first term
+		uint32   last;  // index one past last term
+	};
+	SharedLinearData();
+	//! Increases the reference count of this object.
+	ThisType* share()   { ++count_; return this; }
+	//! Decreases the object's reference count and destroys it if reference count drops to 0.
+	void      release() { if (--count_ == 0) { delete this; } }
+
+	//! Adds a variable with domain dom[0] < ... < dom[size-1].
+	/*!
+	 * \pre size > 0
+	 * \param order Literals s.th. order[i] is true iff the variable is less than dom[i].
+	 *              The literal order[0] is ignored.
+	 * \return The id of the new variable.
+	 */
+	uint32 addVar(const weight_t* dom, const Literal* order, uint32 size);
+	//! Adds the constraint head == sum(terms) <= bound.
+	/*!
+	 * Terms with a zero coefficient are ignored.
+	 * \pre The variables in terms were added via addVar().
+	 */
+	void   addConstraint(Literal head, const Term* first, const Term* last, weight_t bound);
+
+	uint32          numVars()             const { return static_cast<uint32>(varBegin_.size() - 1); }
+	uint32          numConstraints()      const { return static_cast<uint32>(cons_.size()); }
+	//! Number of order literals of all variables.
+	uint32          numOrder()            const { return static_cast<uint32>(values_.size()); }
+	//! Index of the first value of x.
+	uint32          begin(uint32 x)       const { return varBegin_[x]; }
+	//! Size of the domain of x.
+	uint32          size(uint32 x)        const { return varBegin_[x+1] - varBegin_[x]; }
+	//! The i-th value of x.
+	weight_t        value(uint32 x, uint32 i) const { return values_[varBegin_[x] + i]; }
+	//! The values of x in ascending order.
+	const weight_t* domain(uint32 x)      const { return &values_[0] + varBegin_[x]; }
+	//! The i-th order literal of x, i.e. x < value(x, i).
+	Literal         order(uint32 x, uint32 i) const { return order_[varBegin_[x] + i]; }
+	//! The variable with the order literal at index g.
+	uint32          varOf(uint32 g)       const;
+	const Con&      constraint(uint32 c)  const { return cons_[c]; }
+	const Term*     termBegin(uint32 c)   const { return terms_.begin() + cons_[c].first; }
+	const Term*     termEnd(uint32 c)     const { return terms_.begin() + cons_[c].last; }
+	//! Constraints in which x occurs.
+	const VarVec&   occurrences(uint32 x) const { return occurs_[x]; }
+private:
+	SharedLinearData(const SharedLinearData&);
+	SharedLinearData& operator=(const SharedLinearData&);
+	~SharedLinearData();
+	typedef Clasp::atomic<uint32> Atomic;
+	typedef PodVector<Con>::type  ConVec;
+	WeightVec           values_;   // domains of all variables
+	LitVec              order_;    // order literals of all variables
+	VarVec              varBegin_; // index of first value of each variable (+ sentinel)
+	ConVec              cons_;
+	TermVec             terms_;
+	std::vector<VarVec> occurs_;
+	Atomic              count_;
+};
+
+//! Propagates the linear constraints of a SharedLinearData object.
+/*!
+ * \ingroup constraint
+ * The propagator maintains the bounds of the variables implied by their order literals.
+ * Let min (max) be the smallest (largest) value of sum(terms) w.r.t these bounds. Then
+ * - if min > bound, h is set to false,
+ * - if max <= bound, h is set to true,
+ * - if h is true (false), the bounds of the variables are tightened s.th.
+ *   sum(terms) <= bound (sum(terms) > bound) remains satisfiable.
+ * .
+ * Order literals are only assigned when they are implied; the reason of an implied
+ * literal consists of h and the order literals that establish the bounds used to derive it.
+ * No clauses are added for the constraints.
+ */
+class LinearPropagator : public Constraint {
+public:
+	typedef SharedLinearData SharedData;
+	//! Creates a new propagator for the constraints in data and attaches it to s.
+	/*!
+	 * \return The new propagator or 0 if the constraints are conflicting w.r.t the
+	 *         assignment of s.
+	 * \note The returned object is not added to s.
+	 */
+	static LinearPropagator* create(Solver& s, SharedData* data);
+
+	// constraint interface
+	Constraint* cloneAttach(Solver& other);
+	void        destroy(Solver* s, bool detach);
+	PropResult  propagate(Solver& s, Literal p, uint32& data);
+	void        reason(Solver& s, Literal p, LitVec& lits);
+	void        undoLevel(Solver& s);
+	uint32      estimateComplexity(const Solver& s) const;
+
+	const SharedData* shared() const { return data_; }
+	//! Smallest value of x w.r.t the current assignment.
+	weight_t lower(uint32 x) const { return data_->value(x, bounds_[x].lo); }
+	//! Largest value of x w.r.t the current assignment.
+	weight_t upper(uint32 x) const { return data_->value(x, bounds_[x].hi); }
+private:
+	enum { head_flag = 1u << 31 };
+	// range of domain indices
+	struct Bound {
+		Bound(uint32 l = 0, uint32 h = 0) : lo(l), hi(h) {}
+		uint32 lo;
+		uint32 hi;
+	};
+	struct Undo {
+		Undo(uint32 x, const Bound& b) : var(x), old(b) {}
+		uint32 var;
+		Bound  old;
+	};
+	struct Level {
+		Level(uint32 d, uint32 u, uint32 r) : dl(d), undo(u), reason(r) {}
+		uint32 dl;
+		uint32 undo;
+		uint32 reason;
+	};
+	typedef PodVector<Bound>::type BoundVec;
+	typedef PodVector<Undo>::type  UndoVec;
+	typedef PodVector<Level>::type LevelVec;
+	explicit LinearPropagator(SharedData* data);
+	~LinearPropagator();
+	bool    init(Solver& s);
+	void    mark(Solver& s);
+	void    setBound(Solver& s, uint32 x, const Bound& b);
+	bool    propagateCon(Solver& s, uint32 c);
+	bool    tighten(Solver& s, uint32 c, int sign, wsum_t bound, wsum_t min, Literal h);
+	bool    force(Solver& s, Literal p, uint32 c, int sign, uint32 skip, Literal h);
+	Literal lowerLit(uint32 x) const;
+	Literal upperLit(uint32 x) const;
+	SharedData* data_;
+	BoundVec    bounds_;  // current bounds of variables
+	UndoVec     undo_;    // old bounds to restore on backtracking
+	LevelVec    levels_;  // decision levels with changes
+	LitVec      reasons_; // reasons of implied literals: [size, lits...]
+};
+
+}
+#endif
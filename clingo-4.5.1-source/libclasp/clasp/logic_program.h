@@ -30,7 +30,9 @@
 #include <clasp/util/misc_types.h>
 #include <map>
 
-namespace Clasp { namespace Asp {
+namespace Clasp {
+class SharedLinearData;
+namespace Asp {
 //! Program statistics for *one* incremental step.
 class LpStats {
 public:
@@ -56,6 +58,8 @@ public:
 	uint32 nonHcfs;         /**< How many non head-cycle free components?*/
 	uint32 gammas;          /**< How many non-hcf gamma rules */
 	uint32 ufsNodes;        /**< How many nodes in the positive BADG? */
+	uint32 dupRules;        /**< How many duplicate or subsumed rules were dropped by the front end? */
+	double prepTime;        /**< Time spent in preprocessing (in seconds) */
 private:
 	uint32 eqs_[3];         /**< How many equivalences?: eqs[0]: Atom-Atom, eqs[1]: Body-Body, eqs[2]: Other */
 	RPair  rules_[NUM_RULE_TYPES]; /**< Number of rules before/after translation. */
@@ -88,7 +92,8 @@ public:
 		mode_transform_scc    = 5, /**< Transform recursive cardinality- and weight rules to normal rules. */
 		mode_transform_nhcf   = 6, /**< Transform cardinality- and weight rules in non-hcf components to normal rules. */
 		mode_transform_integ  = 7, /**< Transform cardinality-based integrity constraints.       */
-		mode_transform_dynamic= 8  /**< Heuristically decide whether or not to transform a particular extended rule. */
+		mode_transform_dynamic= 8, /**< Heuristically decide whether or not to transform a particular extended rule. */
+		mode_transform_large  = 9  /**< Transform large cardinality- and weight rules to sorting networks.     */
 	};
 
 	//! Options for the Asp-Preprocessor.
@@ -266,6 +271,35 @@ public:
 	 *       as an integrity constraint. 
 	 */
 	LogicProgram& addRule(const Rule& r);
+
+	//! Adds an integer variable to the linear constraints of this step.
+	/*!
+	 * \pre values.size() == atoms.size() and values is sorted in ascending order.
+	 * \param values The domain of the variable.
+	 * \param atoms  Order atoms s.th. atoms[i] holds iff the variable is less than values[i].
+	 *               The first atom is ignored.
+	 * \return The id of the new variable.
+	 * \note The variable is only valid in the current step.
+	 */
+	uint32 addOrderVar(const WeightVec& values, const VarVec& atoms);
+
+	//! Adds the linear constraint head == sum(coefs[i]*vars[i]) <= bound.
+	/*!
+	 * \pre vars are ids returned by addOrderVar() in the current step.
+	 * \note The constraint does not define head. Instead, the head and the order
+	 *       atoms of vars must be defined by rules of the program (e.g. choice rules).
+	 *       The constraint is handled by a LinearPropagator.
+	 */
+	LogicProgram& addLinearConstraint(Var head, const WeightVec& coefs, const VarVec& vars, weight_t bound);
+
+	//! Adds the constraint head == (sum(lits) >= bound).
+	/*!
+	 * Literals refer to atoms and weights may be negative.
+	 * \note As for addLinearConstraint(), the constraint does not define head.
+	 *       It is handled by a WeightConstraint and hence must not be used
+	 *       for aggregates that are part of a positive loop.
+	 */
+	LogicProgram& addSumConstraint(Var head, const WeightLitVec& lits, weight_t bound);
 	
 	//@}
 
@@ -396,6 +430,8 @@ public:
 	HeadIter   atom_end()          const { return atom_begin() + (numAtoms()+1); }
 	VarIter    unfreeze_begin()    const { return incData_?incData_->update.begin() : activeHead_.end(); }
 	VarIter    unfreeze_end()      const { return incData_?incData_->update.end()   : activeHead_.end(); }
+	VarIter    frontier_begin()    const { return incData_?incData_->frontier.begin() : activeHead_.end(); }
+	VarIter    frontier_end()      const { return incData_?incData_->frontier.end()   : activeHead_.end(); }
 	const char*getAtomName(Var id) const;
 	RuleType   simplifyRule(const Rule& r, VarVec& head, BodyInfo& info);
 	VarVec&    getSupportedBodies(bool sorted);
@@ -421,11 +457,12 @@ private:
 	LogicProgram(const LogicProgram&);
 	LogicProgram& operator=(const LogicProgram&);	
 	typedef PodVector<Rule*>::type RuleList;
-	typedef std::multimap<uint32, uint32>   IndexMap; // hash -> vec[offset]
-	typedef IndexMap::iterator              IndexIter;
-	typedef std::pair<IndexIter, IndexIter> IndexRange;
+	typedef NodeIndex                       IndexMap; // hash -> vec[offset]
+	typedef IndexMap::Range                 IndexRange;
 	typedef PodVector<uint8>::type          SccMap;
 	struct MinimizeRule;
+	struct SumConstraint;
+	typedef PodVector<SumConstraint*>::type SumList;
 	// ------------------------------------------------------------------------
 	// virtual overrides
 	bool doStartProgram();
@@ -438,17 +475,19 @@ private:
 	// Program definition
 	bool     isNew(Var atomId) const { return atomId >= startAtom(); }
 	PrgAtom* resize(Var atomId);
+	void     useAtom(Var atomId);
 	PrgAtom* setExternal(Var atomId, ValueRep v);
 	void     addRuleImpl(RuleType t,    const VarVec& head, BodyInfo& body);
 	bool     handleNatively(RuleType t, const BodyInfo& i) const;
 	bool     transformNoAux(RuleType t, const BodyInfo& i) const;
+	bool     transformNet(RuleType t, const BodyInfo& i) const;
 	void     transformExtended();
 	void     transformIntegrity(uint32 nAtoms, uint32 maxAux);
 	PrgBody* getBodyFor(BodyInfo& body, bool addDeps = true);
 	PrgDisj* getDisjFor(const VarVec& heads, uint32 headHash);
 	PrgBody* assignBodyFor(BodyInfo& body, EdgeType x, bool strongSimp);
 	uint32   findEqBody(PrgBody* b, uint32 hash);
-	uint32   equalBody(const IndexRange& range, BodyInfo& info) const;
+	uint32   equalBody(IndexRange range, BodyInfo& info) const;
 	RuleType simplifyBody(const Rule& r, BodyInfo& info);
 	uint32   removeBody(PrgBody* b, uint32 oldHash);
 	Literal  getEqAtomLit(Literal lit, const BodyList& supports, Preprocessor& p, const SccMap& x);
@@ -476,6 +515,8 @@ private:
 	void prepareComponents();
 	void simplifyMinimize();
 	bool addConstraints();
+	bool addLinearConstraints();
+	bool addSumConstraints();
 	// ------------------------------------------------------------------------
 	bool transform(const PrgBody& body, BodyInfo& out)  const;
 	void transform(const MinimizeRule&, BodyInfo& out)  const;
@@ -491,6 +532,7 @@ private:
 	IndexMap       disjIndex_;   // hash -> disjunction
 	BodyList       bodies_;      // all bodies
 	AtomList       atoms_;       // all atoms
+	AtomAlloc      atomAlloc_;   // storage for atoms
 	AtomList       sccAtoms_;    // atoms that are strongly connected
 	DisjList       disjunctions_;// all (head) disjunctions
 	VarVec         initialSupp_; // bodies that are (initially) supported
@@ -501,12 +543,16 @@ private:
 		WeightLitVec lits_;
 		MinimizeRule* next_;
 	}*             minimize_;    // list of minimize-rules
+	SharedLinearData* linear_;   // linear constraints over atoms of this step
+	SumList        sums_;        // sum constraints over atoms of this step
 	struct Incremental  {
 		Incremental();
 		uint32  startAtom;// first atom of current iteration
 		uint32  startScc; // first valid scc number in this iteration
 		VarVec  frozen;   // list of frozen atoms
 		VarVec  update;   // list of atoms to be updated (freeze/unfreeze) in this step
+		VarVec  frontier; // atoms from previous steps that are used in this step
+		PodVector<uint8>::type used; // used[a] != 0 iff a is in frontier
 	}*             incData_;     // additional state to handle incrementally defined programs 
 	AspOptions     opts_;        // preprocessing 
 	uint32         startAux_;    // first aux atom
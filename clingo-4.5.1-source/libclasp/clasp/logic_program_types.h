@@ -213,8 +213,13 @@ public:
 		AdaptBuilder x(prg);
 		return transformNoAux(x, rule);
 	}
+	uint32 transformNet(LogicProgram& prg, Rule& rule) {
+		AdaptBuilder x(prg);
+		return transformNet(x, rule);
+	}
 	uint32 transform(ProgramAdapter& prg, Rule& rule);
 	uint32 transformNoAux(ProgramAdapter& prg, Rule& rule);
+	uint32 transformNet(ProgramAdapter& prg, Rule& rule);
 	static weight_t prepareRule(Rule& rule, weight_t* sumVec);
 private:
 	RuleTransform(const RuleTransform&);
@@ -307,6 +312,55 @@ private:
 	uint8 headFlag(PrgEdge t) const  { return 1u << ((t.rep>>1) & 7u); }
 	StateVec state_;
 };
+
+//! Maps hash values to ids of program nodes.
+/*!
+ * A compact replacement for std::multimap<uint32, uint32>.
+ * Entries are stored in one open-addressing table so that an entry
+ * needs 8 bytes instead of a separately allocated tree node.
+ */
+class NodeIndex {
+	struct Entry { uint32 hash; uint32 id; };
+public:
+	//! Range of entries with a given hash value.
+	class Range {
+	public:
+		bool   empty()    const { return pos_ == noPos; }
+		//! Id of the current entry.
+		uint32 front()    const { return index_->tab_[pos_].id; }
+		void   popFront()       { pos_ = index_->find(hash_, pos_ + 1); }
+	private:
+		friend class NodeIndex;
+		Range(const NodeIndex* x, uint32 h) : index_(x), hash_(h), pos_(x->first(h)) {}
+		const NodeIndex* index_;
+		uint32           hash_;
+		uint32           pos_;
+	};
+	NodeIndex() : used_(0), dead_(0) {}
+	bool   empty()              const { return used_ == 0; }
+	uint32 size()               const { return used_; }
+	//! Returns the range of entries with hash value h.
+	Range  equalRange(uint32 h) const { return Range(this, h); }
+	//! Adds the entry (h, id).
+	void   insert(uint32 h, uint32 id);
+	//! Removes the current entry of r.
+	void   erase(const Range& r);
+	//! Removes all entries and releases the table.
+	void   clear();
+private:
+	static const uint32 noPos   = UINT32_MAX;
+	static const uint32 emptyId = UINT32_MAX;
+	static const uint32 deadId  = UINT32_MAX - 1;
+	typedef PodVector<Entry>::type EntryVec;
+	uint32 mask()               const { return tab_.size() - 1; }
+	uint32 slot(uint32 h)       const { return ((h * 0x9E3779B9u) >> 7) & mask(); }
+	uint32 first(uint32 h)      const { return !tab_.empty() ? find(h, slot(h)) : noPos; }
+	uint32 find(uint32 h, uint32 pos) const;
+	void   rehash(uint32 cap);
+	EntryVec tab_;  // table with size 0 or 2^n
+	uint32   used_; // number of entries
+	uint32   dead_; // number of erased entries still in table
+};
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 //! A node of a program-dependency graph.
 /*!
@@ -491,6 +545,8 @@ public:
 	void         setScc(uint32 scc) { data_ = scc; }
 	void         markFrozen(ValueRep v){ freeze_ = v + freeze_free; }
 	void         clearFrozen()         { freeze_ = freeze_no; markDirty(); }
+	//! Removes all supports and dependencies and releases their memory.
+	void         releaseEdges()        { EdgeVec().swap(supports_); LitVec().swap(deps_); }
 	//@}
 private:
 	LitVec deps_; // bodies depending on this atom
@@ -664,6 +720,40 @@ private:
 	PrgEdge atoms_[0]; // atoms in disjunction
 };
 
+//! Allocates the atoms of a logic program in blocks.
+/*!
+ * A program may contain millions of atoms. Allocating them in blocks
+ * avoids the per-object overhead of the global allocator.
+ */
+class AtomAlloc {
+public:
+	AtomAlloc() : blocks_(0), freeList_(0) {}
+	~AtomAlloc() { release(); }
+	PrgAtom* create(uint32 id, bool checkScc = true);
+	//! Destroys an atom created via create().
+	void     destroy(PrgAtom* a);
+	//! Frees all blocks.
+	/*!
+	 * \pre All atoms created by this object were destroyed.
+	 */
+	void     release();
+private:
+	AtomAlloc(const AtomAlloc&);
+	AtomAlloc& operator=(const AtomAlloc&);
+	union Chunk {
+		Chunk*        next; // enforce ptr alignment
+		unsigned char mem[sizeof(PrgAtom)];
+	};
+	struct Block {
+		enum { num_chunks = 1023 };
+		Block* next;
+		Chunk  chunk[num_chunks];
+	};
+	void   allocBlock();
+	Block* blocks_;
+	Chunk* freeList_;
+};
+
 inline ValueRep getMergeValue(const PrgNode* lhs, const PrgNode* rhs) {
 	return static_cast<ValueRep>(std::min(static_cast<ValueRep>(lhs->value()-1), static_cast<ValueRep>(rhs->value()-1)) + 1);
 }
@@ -173,6 +173,7 @@ public:
 	bool    propagateFixpoint(Solver& s, PostPropagator*);
 	//! Returns PostPropagator::priority_reserved_look.
 	uint32  priority() const;
+	PropagatorClass propClass() const { return Propagator_t::prop_lookahead; }
 	void    destroy(Solver* s, bool detach);
 	//! Updates state with lookahead result.
 	ScoreLook score;
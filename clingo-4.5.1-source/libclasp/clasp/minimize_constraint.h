@@ -52,6 +52,7 @@ struct MinimizeMode_t {
 	enum Strategy {
 		opt_bb = 0, /*!< branch and bound based optimization.   */
 		opt_usc= 1, /*!< unsatisfiable-core based optimization. */
+		opt_lns= 2, /*!< large neighborhood search on top of branch and bound. */
 	};
 	//! Options for branch and bound based optimization.
 	enum BBOption {
@@ -65,12 +66,19 @@ struct MinimizeMode_t {
 		usc_preprocess = 1u, /*!< enable (disjoint) preprocessing. */
 		usc_imp_only   = 2u, /*!< only add constraints for one direction (instead of eq). */
 		usc_clauses    = 4u, /*!< only add clauses (instead of cardinality constraints).  */
+		usc_stratify   = 8u, /*!< stratify weights, trim and exhaust cores, and share cores. */
+	};
+	//! Options for large neighborhood search, i.e. how to select the atoms to free.
+	enum LnsOption {
+		lns_random     = 0u, /*!< free randomly selected atoms. */
+		lns_predicate  = 1u, /*!< free all atoms of randomly selected predicates. */
+		lns_constraint = 2u, /*!< free the atoms of randomly selected problem constraints. */
 	};
 	enum Heuristic {
 		heu_sign  = 1,  /*!< Use optimize statements in sign heuristic. */ 
 		heu_model = 2,  /*!< Apply model heuristic when optimizing.     */
 	};
-	static bool supportsSplitting(Strategy s) { return s != opt_usc; }
+	static bool supportsSplitting(Strategy s) { return s == opt_bb; }
 };
 typedef MinimizeMode_t::Mode MinimizeMode;
 
@@ -321,6 +329,7 @@ public:
 	// base interface
 	void         destroy(Solver*, bool);
 	Constraint*  cloneAttach(Solver&) { return 0; }
+	PropagatorClass propClass() const { return Propagator_t::prop_minimize; }
 protected:
 	MinimizeConstraint(SharedData* s);
 	~MinimizeConstraint();
@@ -409,11 +418,12 @@ public:
 
 	// FOR TESTING ONLY!
 	wsum_t sum(uint32 i, bool adjust) const { return sum()[i] + (adjust ? shared_->adjust(i):0); }
+protected:
+	~DefaultMinimize();
 private:
 	enum PropMode  { propagate_new_sum, propagate_new_opt };
 	union UndoInfo;
 	typedef const WeightLiteral* Iter;
-	~DefaultMinimize();
 	// bound operations
 	wsum_t* opt() const { return bounds_; }
 	wsum_t* sum() const { return bounds_ + size_; }
@@ -445,6 +455,58 @@ private:
 	}            step_;
 };
 
+//! Minimization via large neighborhood search (LNS).
+/*!
+ * Searches like DefaultMinimize until a first model is found. Afterwards, a
+ * percentage of the atoms is fixed to their values in the best model found
+ * by this solver and the remaining neighborhood is searched for a better model
+ * under a conflict budget. Each improvement is published via the shared data 
+ * object and starts a new neighborhood around the new model.
+ *
+ * Neighborhoods that are proven to contain no better model are widened, while
+ * neighborhoods that exceed their budget are narrowed and get a larger budget.
+ * Once the fixed part drops below a minimum, the constraint falls back
+ * to complete branch and bound search for the rest of the solve call.
+ * 
+ * \note The atoms to free are selected according to one of MinimizeMode_t::LnsOption.
+ */
+class LnsMinimize : public DefaultMinimize {
+public:
+	bool       attach(Solver& s);
+	bool       relax(Solver& s, bool reset);
+	bool       handleModel(Solver& s);
+	bool       handleUnsat(Solver& s, bool up, LitVec& out);
+	bool       supportsSplitting() const { return false; }
+	void       destroy(Solver*, bool);
+private:
+	friend class SharedMinimizeData;
+	explicit LnsMinimize(SharedData* d, uint32 options = 0u);
+	~LnsMinimize();
+	class Budget;
+	enum StopReason { stop_none = 0, stop_model = 1, stop_budget = 2 };
+	typedef PodVector<uint8>::type FlagVec;
+	bool   checkStop(Solver& s);
+	void   initVars(const Solver& s);
+	void   selectFree(const Solver& s, uint32 num);
+	uint32 randomIndex(uint32 size) { return ((rng_.rand() << 15) | rng_.rand()) % size; }
+	ValueVec best_;     // best model found by this solver
+	VarVec   vars_;     // atoms that may be fixed (grouped by predicate)
+	VarVec   groups_;   // start of predicate groups in vars_
+	FlagVec  free_;     // free_[v] != 0 iff v is not fixed in the next neighborhood
+	LitVec   temp_;     // temporary: literals of a problem constraint
+	RNG      rng_;      // for selecting neighborhoods
+	Budget*  budget_;   // post propagator checking the conflict budget
+	uint64   limit_;    // conflict limit for the active neighborhood
+	uint32   conf_;     // conflict budget for the next neighborhood
+	uint32   root_;     // root level below the active neighborhood
+	uint32   fix_;      // percentage of atoms to fix in the next neighborhood
+	uint32   type_ : 2; // one of MinimizeMode_t::LnsOption
+	uint32   hood_ : 1; // neighborhood active?
+	uint32   stop_ : 2; // one of StopReason
+	uint32   init_ : 1; // vars_ initialized?
+	uint32   done_ : 1; // fall back to complete search?
+};
+
 //! Minimization via unsat cores.
 class UncoreMinimize : public MinimizeConstraint {
 public:
@@ -485,6 +547,12 @@ private:
 		weight_t          bound;
 		weight_t          weight;
 	};
+	struct LessWeight {
+		explicit LessWeight(const PodVector<LitData>::type& d) : data(&d) {}
+		template <class P>
+		bool operator()(const P& lhs, const P& rhs) const { return (*data)[lhs.id-1].weight < (*data)[rhs.id-1].weight; }
+		const PodVector<LitData>::type* data;
+	};
 	struct WCTemp {
 		typedef WeightLitVec WLitVec;
 		void     start(weight_t b){ lits.clear(); bound = b; }
@@ -507,6 +575,10 @@ private:
 	bool     addCore(Solver& s, const WCTemp& wc, weight_t w);
 	bool     addClauses(Solver& s, const LitPair* lits, uint32 size, weight_t weight);
 	bool     closeCore(Solver& s, LitData& x, bool sat);
+	bool     exhaust(Solver& s, Literal assume);
+	uint32   trimCore(Solver& s, uint32 cs, weight_t& minW, LitVec& poppedOther);
+	void     shareCore(Solver& s, uint32 cs);
+	bool     nextStratum();
 	uint32   allocCore(WeightConstraint* con, weight_t bound, weight_t weight, bool open);
 	enum CompType { comp_disj = 0, comp_conj = 1 };
 	bool     add(CompType t, Solver& s, Literal head, Literal body1, Literal body2);
@@ -535,6 +607,7 @@ private:
 	ConTable  closed_;    // closed cores represented as weight constraints
 	LitSet    assume_;    // current set of assumptions
 	LitSet    todo_;      // core(s) not yet represented as constraint
+	LitSet    strat_;     // literals of active level not yet assumed (sorted by weight)
 	LitVec    fix_;       // set of fixed literals
 	LitVec    conflict_;  // current conflict
 	WCTemp    temp_;      // temporary: used for creating weight constraints
@@ -543,13 +616,14 @@ private:
 	uint32    auxInit_;   // number of solver aux vars on attach
 	uint32    auxAdd_;    // number of aux vars added for cores
 	uint32    gen_;       // active generation
-	uint32    level_ : 26;// active level
+	uint32    level_ : 25;// active level
 	uint32    valid_ :  1;// valid w.r.t active generation?
 	uint32    sat_   :  1;// update because of model
 	uint32    pre_   :  1;// preprocessing active?
 	uint32    path_  :  1;// push path?
 	uint32    next_  :  1;// assume next level?
 	uint32    init_  :  1;// init constraint?
+	uint32    pure_  :  1;// last core derived without fixed literals and external assumptions?
 	uint32    eRoot_;     // saved root level of solver (initial gp)
 	uint32    aTop_;      // saved assumption level (added by us)
 	uint32    freeOpen_;  // head of open core free list
@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2015, Benjamin Kaufmann
+//
+// This file is part of Clasp. See http://www.cs.uni-potsdam.de/clasp/
+//
+// Clasp is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Clasp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Clasp; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+//
+#ifndef CLASP_MODEL_COUNTER_H_INCLUDED
+#define CLASP_MODEL_COUNTER_H_INCLUDED
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#include <clasp/solve_algorithms.h>
+#include <clasp/constraint.h>
+#include <string>
+
+/*!
+ * \file
+ * Defines algorithms for counting (projected) models without enumerating them.
+ */
+namespace Clasp {
+struct EnumOptions;
+
+//! An arbitrary precision unsigned integer used for storing model counts.
+class ModelCount {
+public:
+	ModelCount(uint64 n = 0);
+	bool        zero() const { return limbs_.empty(); }
+	//! Returns -1, 0, or 1 if this is less than, equal to, or greater than other.
+	int         compare(const ModelCount& other) const;
+	ModelCount& operator+=(const ModelCount& other);
+	ModelCount& operator*=(const ModelCount& other);
+	//! Multiplies this count by 2^n.
+	ModelCount& shift(uint32 n);
+	//! Returns the approximate value of this count.
+	double      toDouble() const;
+	//! Returns the decimal representation of this count.
+	std::string toString() const;
+	bool operator<(const ModelCount& other)  const { return compare(other) < 0; }
+	bool operator==(const ModelCount& other) const { return compare(other) == 0; }
+private:
+	typedef PodVector<uint32>::type LimbVec;
+	void    trim();
+	LimbVec limbs_; // least significant limb first, no leading zeros
+};
+
+//! A parity constraint x_1 ^ ... ^ x_n = rhs over boolean variables.
+/*!
+ * \ingroup constraint
+ * The constraint watches two of its variables in both polarities and
+ * forces the last free variable once all other variables are assigned.
+ * Parity constraints are solver-local and do not support cloning.
+ */
+class ParityConstraint : public Constraint {
+public:
+	//! Creates a new parity constraint and attaches it to s.
+	/*!
+	 * \param s    The solver to which the constraint is added.
+	 * \param vars The variables of the constraint (each variable at most once).
+	 * \param rhs  Required parity of the number of true variables in vars.
+	 * \param[out] out The new constraint.
+	 * \return false if the constraint is violated under the current assignment.
+	 * \note The caller is responsible for destroying the returned constraint.
+	 */
+	static bool create(Solver& s, const VarVec& vars, bool rhs, ParityConstraint*& out);
+	Constraint* cloneAttach(Solver&) { return 0; }
+	PropResult  propagate(Solver& s, Literal p, uint32& data);
+	void        reason(Solver& s, Literal p, LitVec& lits);
+	void        destroy(Solver* s, bool detach);
+	uint32      size() const { return (uint32)vars_.size(); }
+private:
+	ParityConstraint(const VarVec& vars, bool rhs);
+	void   watch(Solver& s, uint32 slot);
+	bool   parity(const Solver& s, uint32 skip) const;
+	VarVec vars_; // vars_[0] and vars_[1] are watched
+	bool   rhs_;
+};
+
+//! Counts the (projected) models of a problem.
+/*!
+ * \ingroup enumerator
+ * Instead of enumerating models, the counter first searches for one
+ * model (which is reported like any other model) and then counts the
+ * models of the problem. If projection is enabled, models are counted
+ * w.r.t the projection variables, otherwise w.r.t all problem variables.
+ *
+ * In exact mode, the counter splits the problem into independent
+ * components of the constraint graph and counts components separately
+ * by branching on the solver's assignment, where the count of each component
+ * is cached. Branches not covered by a known model are checked by the solver.
+ *
+ * In approximate mode, the counter partitions the models into cells by
+ * random parity constraints (xor hashing) so that a cell contains at most
+ * a small number of models. The constraints of a cell are reduced by Gauss-Jordan
+ * elimination before they are added to the solver. The result is within a
+ * factor of 1+epsilon of the exact count with probability at least 1-delta.
+ *
+ * \note Counting is limited to one solver.
+ */
+class ModelCounter : public SequentialSolve {
+public:
+	explicit ModelCounter(const EnumOptions& opts, Enumerator* enumerator = 0, const SolveLimits& limit = SolveLimits());
+	~ModelCounter();
+	//! Returns the result of the last count (only valid if counted() is true).
+	const ModelCount& count()   const { return count_; }
+	//! Returns whether the last call to solve() completed its count.
+	bool              counted() const { return counted_; }
+	//! Returns whether count() is exact or an approximation.
+	bool              exact()   const { return exact_; }
+	double            epsilon() const { return eps_; }
+	double            delta()   const { return delta_; }
+protected:
+	virtual bool doSolve(SharedContext& ctx, const LitVec& assume);
+private:
+	class  Exact;
+	typedef PodVector<Constraint*>::type ConVec;
+	bool     countApprox(Solver& s, BasicSolve& solve, const VarVec& proj, ConVec& keep);
+	ValueRep countCell(Solver& s, BasicSolve& solve, const VarVec& proj, const VarVec& rows, uint32 numRows, uint32 limit, uint32& out, ConVec& keep);
+	void     addHash(Solver& s, uint32 numVars, VarVec& rows);
+	ModelCount count_;
+	double     eps_;
+	double     delta_;
+	uint32     mode_;
+	bool       project_;
+	bool       counted_;
+	bool       exact_;
+};
+
+}
+#endif
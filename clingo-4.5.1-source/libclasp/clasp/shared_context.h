@@ -431,11 +431,13 @@ public:
 	//! Configures the statistic object of attached solvers.
 	/*!
 	 * The level determines the amount of extra statistics.
-	 * Currently two levels are supported:
+	 * Currently three levels are supported:
 	 *  - Level 1 enables ExtendedStats
 	 *  - Level 2 enables ExtendedStats and JumpStats
+	 *  - Level 3 additionally enables PropStats
 	 * \see ExtendedStats
 	 * \see JumpStats
+	 * \see PropStats
    */
 	void       enableStats(uint32 level);
 	void       accuStats();
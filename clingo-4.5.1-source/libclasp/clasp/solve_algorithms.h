@@ -86,6 +86,14 @@ public:
 	 * \param init Call InitParams::randomize() before starting search?
 	 */
 	bool     satisfiable(const LitVec& assumptions, bool init);
+	//! Computes the subset of the given assumptions on which the last unsatisfiable result depends.
+	/*!
+	 * \pre The last call to assume(), solve(), or satisfiable() with the given
+	 *      assumptions failed and the solver was not backtracked since.
+	 * \param assumptions The assumptions of the failed call.
+	 * \param[out] out    The assumptions responsible for the failure.
+	 */
+	void     unsatCore(const LitVec& assumptions, LitVec& out) const;
 
 	//! Resets the internal solving state while keeping the solver and the solving options.
 	void     reset(bool reinit = false);
@@ -153,6 +161,13 @@ public:
 	 * in assumptions are assumed to be true during search but are undone before solve returns.
 	 */
 	bool solve(SharedContext& ctx, const LitVec& assume = LitVec(), ModelHandler* onModel = 0);
+
+	//! Returns the assumptions on which the unsatisfiability of the last call to solve() depends.
+	/*!
+	 * \return The unsatisfiable core or 0 if the last call to solve() found a model
+	 *         or the algorithm does not support core extraction.
+	 */
+	const LitVec* unsatCore() const { return core_.get(); }
 	
 	//! Resets solving state and sticky messages like terminate.
 	/*!
@@ -180,11 +195,13 @@ protected:
 	Enumerator&   enumerator() { return *enum_;  }
 	uint64        maxModels() const { return enumLimit_; }
 	bool          moreModels(const Solver& s) const;
+	void          setCore(LitVec* core) { core_ = core; }
 private:
 	SolveLimits   limits_;
 	Enumerator*   enum_;
 	ModelHandler* onModel_;
 	uint64        enumLimit_;
+	SingleOwnerPtr<LitVec> core_;
 };
 
 class SequentialSolve : public SolveAlgorithm {
@@ -197,6 +214,9 @@ public:
 protected:
 	virtual bool doSolve(SharedContext& ctx, const LitVec& assume);
 	virtual bool doInterrupt();
+	//! Attaches the interrupt handler (if any) to s and returns false if solving was already interrupted.
+	bool attachInterrupt(Solver& s);
+	void detachInterrupt();
 private:
 	struct InterruptHandler;
 	InterruptHandler* term_;
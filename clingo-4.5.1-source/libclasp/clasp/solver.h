@@ -516,6 +516,16 @@ public:
 	 */
 	bool backtrack();
 
+	//! Resolves the given literals back to the decisions they depend on.
+	/*!
+	 * \pre All literals in lits are true w.r.t the current assignment.
+	 * \param[in,out] lits On input, the literals to resolve. On output, the
+	 *                 decisions (e.g. assumptions on levels [1, rootLevel()])
+	 *                 from which the input literals follow.
+	 * \note Literals assigned on decision level 0 are ignored.
+	 */
+	void resolveToCore(LitVec& lits);
+
 	enum UndoMode { undo_default = 0u, undo_pop_bt_level = 1u, undo_save_phases = 2u };
 	//! Undoes all assignments up to (but not including) decision level dl.
 	/*!
@@ -672,6 +682,8 @@ public:
 	 * \note returns 0, if hasWatch(p, c) == false
 	 */
 	GenericWatch* getWatch(Literal p, Constraint* c) const;
+	//! Returns the clause and constraint watches of the literal p.
+	const WatchList& watches(Literal p)              const { assert(validWatch(p)); return watches_[p.index()]; }
 	//! Adds c to the watch-list of p.
 	/*!
 	 * When p becomes true, c->propagate(p, data, *this) is called.
@@ -852,6 +864,8 @@ private:
 	void    freeMem();
 	bool    simplifySAT();
 	bool    unitPropagate();
+	template <class P>
+	bool    unitPropagate(P& profile);
 	void    cancelPropagation() { assign_.qReset(); post_.cancel(); }
 	uint32  undoUntilImpl(uint32 dl, bool sp);
 	void    undoLevel(bool sp);
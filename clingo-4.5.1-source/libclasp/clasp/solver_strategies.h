@@ -167,8 +167,7 @@ struct SolverParams : SolverStrategies  {
 	uint32 heuParam  : 16; /*!< Extra parameter for heuristic with meaning depending on type */
 	uint32 lookOps   : 16; /*!< Max. number of lookahead operations (0: no limit).           */
 	// 32-bit
-	uint32 optStrat  : 1;  /*!< Optimization strategy (see MinimizeMode_t::Strategy).*/
-	uint32 optParam  : 3;  /*!< Parameter for optimization strategy (see MinimizeMode_t::BBOption / MinimizeMode_t::UscOption). */
+	uint32 optParam  : 4;  /*!< Parameter for optimization strategy (see MinimizeMode_t::BBOption / MinimizeMode_t::UscOption / MinimizeMode_t::LnsOption). */
 	uint32 optHeu    : 2;  /*!< Set of optimize heuristics. */
 	uint32 heuId     : 3;  /*!< Type of decision heuristic.   */
 	uint32 heuScore  : 2;  /*!< Type of scoring during resolution. */ 
@@ -181,6 +180,10 @@ struct SolverParams : SolverStrategies  {
 	uint32 forgetSet : 4;  /*!< What to forget on (incremental step). */ 
 	uint32 domPref   : 5;  /*!< Only for domain heuristic. */
 	uint32 domMod    : 3;  /*!< Only for domain heuristic. */
+	// 32-bit
+	uint32 optStrat  : 2;  /*!< Optimization strategy (see MinimizeMode_t::Strategy).*/
+	uint32 lnsFix    : 7;  /*!< Only for lns: percentage of atoms to fix in a neighborhood. */
+	uint32 lnsConf   : 23; /*!< Only for lns: initial conflict budget of a neighborhood. */
 };
 
 typedef Range<uint32> Range32;
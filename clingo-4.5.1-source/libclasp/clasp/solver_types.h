@@ -205,6 +205,60 @@ struct JumpStats {
 	CLASP_JUMP_STATS(CLASP_STAT_DEFINE,NO_ARG,NO_ARG)
 };
 
+//! A struct for holding (optional) propagation statistics.
+/*!
+ * For each propagator class, the struct stores the CycleTime ticks spent in
+ * propagation and the number of propagator calls, where a call is the propagation
+ * of one literal in the short implication graph, a visited watch, or one call to
+ * PostPropagator::propagateFixpoint(). Ticks are attributed to the innermost
+ * propagator, e.g. unit propagation triggered by the unfounded set checker is
+ * not attributed to the latter.
+ */
+struct PropStats {
+	typedef PropagatorClass class_t;
+	enum { num_classes = Propagator_t::max_value + 1 };
+	typedef uint64 Array[num_classes];
+#define CLASP_PROP_STATS(STAT, SELF, OTHER)     \
+	STAT(Array ticks; /**< ticks per class */, "ticks"           , SELF.total()                          , NO_ARG) \
+	STAT(Array calls; /**< calls per class */, "calls"           , SELF.totalCalls()                     , NO_ARG) \
+	STAT(NO_ARG , "short_ticks"     , SELF.ticks[Propagator_t::prop_short]    , SELF.ticks[0] += OTHER.ticks[0]) \
+	STAT(NO_ARG , "short_calls"     , SELF.calls[Propagator_t::prop_short]    , SELF.calls[0] += OTHER.calls[0]) \
+	STAT(NO_ARG , "clause_ticks"    , SELF.ticks[Propagator_t::prop_clause]   , SELF.ticks[1] += OTHER.ticks[1]) \
+	STAT(NO_ARG , "clause_calls"    , SELF.calls[Propagator_t::prop_clause]   , SELF.calls[1] += OTHER.calls[1]) \
+	STAT(NO_ARG , "weight_ticks"    , SELF.ticks[Propagator_t::prop_weight]   , SELF.ticks[2] += OTHER.ticks[2]) \
+	STAT(NO_ARG , "weight_calls"    , SELF.calls[Propagator_t::prop_weight]   , SELF.calls[2] += OTHER.calls[2]) \
+	STAT(NO_ARG , "minimize_ticks"  , SELF.ticks[Propagator_t::prop_minimize] , SELF.ticks[3] += OTHER.ticks[3]) \
+	STAT(NO_ARG , "minimize_calls"  , SELF.calls[Propagator_t::prop_minimize] , SELF.calls[3] += OTHER.calls[3]) \
+	STAT(NO_ARG , "other_ticks"     , SELF.ticks[Propagator_t::prop_other]    , SELF.ticks[4] += OTHER.ticks[4]) \
+	STAT(NO_ARG , "other_calls"     , SELF.calls[Propagator_t::prop_other]    , SELF.calls[4] += OTHER.calls[4]) \
+	STAT(NO_ARG , "unfounded_ticks" , SELF.ticks[Propagator_t::prop_unfounded], SELF.ticks[5] += OTHER.ticks[5]) \
+	STAT(NO_ARG , "unfounded_calls" , SELF.calls[Propagator_t::prop_unfounded], SELF.calls[5] += OTHER.calls[5]) \
+	STAT(NO_ARG , "lookahead_ticks" , SELF.ticks[Propagator_t::prop_lookahead], SELF.ticks[6] += OTHER.ticks[6]) \
+	STAT(NO_ARG , "lookahead_calls" , SELF.calls[Propagator_t::prop_lookahead], SELF.calls[6] += OTHER.calls[6]) \
+	STAT(NO_ARG , "post_ticks"      , SELF.ticks[Propagator_t::prop_post]     , SELF.ticks[7] += OTHER.ticks[7]) \
+	STAT(NO_ARG , "post_calls"      , SELF.calls[Propagator_t::prop_post]     , SELF.calls[7] += OTHER.calls[7])
+
+	PropStats() { reset(); }
+	void reset() { std::memset(this, 0, sizeof(*this)); }
+	void accu(const PropStats& o) {
+		CLASP_PROP_STATS(CLASP_STAT_ACCU, (*this), o)
+	}
+	double operator[](const char* key) const {
+		CLASP_PROP_STATS(CLASP_STAT_GET, (*this), NO_ARG)
+		return -1.0;
+	}
+	static const char* keys(const char* path) {
+		if (!path || !*path) { return CLASP_PROP_STATS(CLASP_STAT_KEY,NO_ARG,NO_ARG); }
+		return 0;
+	}
+	void   add(class_t c, uint64 t, uint32 n) { ticks[c] += t; calls[c] += n; }
+	uint64 total()          const { return std::accumulate(ticks, ticks+num_classes, uint64(0)); }
+	uint64 totalCalls()     const { return std::accumulate(calls, calls+num_classes, uint64(0)); }
+	double share(class_t c) const { return percent(ticks[c], total()); }
+	double avgTicks(class_t c) const { return ratio(ticks[c], calls[c]); }
+	CLASP_PROP_STATS(CLASP_STAT_DEFINE,NO_ARG,NO_ARG)
+};
+
 struct QueueImpl {
 	explicit QueueImpl(uint32 size) : maxSize(size), wp(0), rp(0) {}
 	bool    full()  const { return size() == maxSize; }
@@ -285,16 +339,17 @@ private:
 
 //! A struct for aggregating statistics maintained in a solver object.
 struct SolverStats : public CoreStats {
-	SolverStats() : queue(0), extra(0), jumps(0) {}
-	SolverStats(const SolverStats& o) : CoreStats(o), queue(0), extra(0), jumps(0) {
+	SolverStats() : queue(0), extra(0), jumps(0), props(0) {}
+	SolverStats(const SolverStats& o) : CoreStats(o), queue(0), extra(0), jumps(0), props(0) {
 		if (o.queue) enableQueue(o.queue->maxSize());
 		enableStats(o);
 	}
-	~SolverStats() { delete jumps; delete extra; if (queue) queue->destroy(); }
+	~SolverStats() { delete props; delete jumps; delete extra; if (queue) queue->destroy(); }
 	bool enableStats(const SolverStats& other);
-	int  level() const { return (extra != 0) + (jumps != 0); }
+	int  level() const { return (extra != 0) + (jumps != 0) + (props != 0); }
 	bool enableExtended();
 	bool enableJump();
+	bool enableProps();
 	void enableQueue(uint32 size);
 	void reset();
 	void accu(const SolverStats& o);
@@ -303,6 +358,12 @@ struct SolverStats : public CoreStats {
 	const char* subKeys(const char* p) const;
 	const char* keys(const char* path) const {
 		if (!path || !*path) {
+			if (props) {
+				if (jumps && extra) { return "props.\0jumps.\0extra.\0" CLASP_CORE_STATS(CLASP_STAT_KEY,NO_ARG,NO_ARG); }
+				if (extra)          { return "props.\0extra.\0" CLASP_CORE_STATS(CLASP_STAT_KEY,NO_ARG,NO_ARG); }
+				if (jumps)          { return "props.\0jumps.\0" CLASP_CORE_STATS(CLASP_STAT_KEY,NO_ARG,NO_ARG); }
+				return "props.\0" CLASP_CORE_STATS(CLASP_STAT_KEY,NO_ARG,NO_ARG);
+			}
 			if (jumps && extra) { return "jumps.\0extra.\0" CLASP_CORE_STATS(CLASP_STAT_KEY,NO_ARG,NO_ARG); }
 			if (extra)          { return "extra.\0" CLASP_CORE_STATS(CLASP_STAT_KEY,NO_ARG,NO_ARG); }
 			if (jumps)          { return "jumps.\0" CLASP_CORE_STATS(CLASP_STAT_KEY,NO_ARG,NO_ARG); }
@@ -326,6 +387,7 @@ struct SolverStats : public CoreStats {
 	SumQueue*      queue; /**< Optional queue for running averages. */
 	ExtendedStats* extra; /**< Optional extended statistics.        */
 	JumpStats*     jumps; /**< Optional jump statistics.            */
+	PropStats*     props; /**< Optional propagation statistics.     */
 private: SolverStats& operator=(const SolverStats&);
 };
 inline void SolverStats::addLearnt(uint32 size, ConstraintType t)  { if (extra) { extra->addLearnt(size, t); } }
@@ -354,6 +416,7 @@ inline void SolverStats::updateJumps(uint32 dl, uint32 uipLevel, uint32 bLevel,
 #undef CLASP_CORE_STATS
 #undef CLASP_EXTENDED_STATS
 #undef CLASP_JUMP_STATS
+#undef CLASP_PROP_STATS
 #undef NO_ARG
 ///////////////////////////////////////////////////////////////////////////////
 // Clauses
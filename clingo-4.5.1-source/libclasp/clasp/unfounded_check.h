@@ -72,6 +72,7 @@ public:
 
 	// base interface
 	uint32 priority() const { return uint32(priority_reserved_ufs); }
+	PropagatorClass propClass() const { return Propagator_t::prop_unfounded; }
 	bool   init(Solver&);
 	void   reset();
 	bool   propagateFixpoint(Solver& s, PostPropagator* ctx);
@@ -105,7 +106,7 @@ private:
 		const BodyNode* node;
 		uint32          id;
 	};
-	// data for extended bodies
+	// data for extended bodies - stored inline in extended_
 	struct ExtData {
 		ExtData(weight_t bound, uint32 preds) : lower(bound) {
 			for (uint32 i = 0; i != flagSize(preds); ++i) { flags[i] = 0; }
@@ -129,6 +130,7 @@ private:
 			}
 		}
 		static   uint32 flagSize(uint32 preds) { return (preds+31)/32; }
+		static   uint32 wordSize(uint32 preds) { return (sizeof(ExtData)/sizeof(uint32)) + flagSize(preds); }
 		weight_t lower;
 		uint32   flags[0];
 	};
@@ -184,7 +186,8 @@ private:
 	void reason(Solver& s, Literal, LitVec&);
 	// -------------------------------------------------------------------------------------------
 	// initialization
-	BodyPtr getBody(NodeId bId) const { return BodyPtr(&graph_->getBody(bId), bId); }
+	BodyPtr  getBody(NodeId bId) const { return BodyPtr(&graph_->getBody(bId), bId); }
+	ExtData* getExt(NodeId bId)        { return reinterpret_cast<ExtData*>(&extended_[bodies_[bId].lower_or_ext]); }
 	void    initBody(const BodyPtr& n);
 	void    initExtBody(const BodyPtr& n);
 	void    initSuccessors(const BodyPtr& n, weight_t lower);
@@ -265,7 +268,7 @@ private:
 	// -------------------------------------------------------------------------------------------  
 	typedef PodVector<AtomData>::type       AtomVec;
 	typedef PodVector<BodyData>::type       BodyVec;
-	typedef PodVector<ExtData*>::type       ExtVec;
+	typedef PodVector<uint32>::type         ExtVec;
 	typedef PodVector<ExtWatch>::type       WatchVec;
 	typedef PodQueue<NodeId>                IdQueue;
 	typedef SingleOwnerPtr<MinimalityCheck> MiniPtr;
@@ -275,11 +278,11 @@ private:
 	MiniPtr          mini_;        // minimality checker (only for DLPs)
 	AtomVec          atoms_;       // data for each atom       
 	BodyVec          bodies_;      // data for each body
-	IdQueue          todo_;        // ids of atoms that recently lost their source
+	IdQueue          todo_;        // ids of atoms that recently lost their source (processed in scc order)
 	IdQueue          ufs_;         // ids of atoms that are unfounded wrt the current assignment (limited to one scc)
 	VarVec           invalidQ_;    // ids of invalid elements to be processed
 	VarVec           sourceQ_;     // source-pointer propagation queue
-	ExtVec           extended_;    // data for each extended body
+	ExtVec           extended_;    // data for all extended bodies in one contiguous block
 	WatchVec         watches_;     // watches for handling choice-, cardinality- and weight rules
 	VarVec           pickedExt_;   // extended bodies visited during reason computation
 	LitVec           loopAtoms_;   // only used if strategy_ == shared_reason
@@ -24,6 +24,14 @@
 #ifdef _MSC_VER
 #pragma once
 #endif
+#include <clasp/util/platform.h>
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#pragma intrinsic(__rdtsc)
+#define CLASP_HAS_CYCLE_COUNTER 1
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define CLASP_HAS_CYCLE_COUNTER 1
+#endif
 
 namespace Clasp {
 
@@ -38,6 +46,27 @@ struct ThreadTime {
 struct RealTime {
 	static double getTime();
 };
+
+//! Cheap, high resolution counter for measuring short time intervals.
+/*!
+ * On x86 platforms, ticks are read from the processor's time-stamp counter.
+ * Otherwise, ticks are nanoseconds derived from RealTime.
+ * \note Ticks are only comparable within one thread.
+ */
+struct CycleTime {
+	static uint64 getTicks();
+};
+#if defined(CLASP_HAS_CYCLE_COUNTER)
+#if defined(_MSC_VER)
+inline uint64 CycleTime::getTicks() { return __rdtsc(); }
+#else
+inline uint64 CycleTime::getTicks() {
+	uint32 lo, hi;
+	__asm__ __volatile__ ("rdtsc" : "=a"(lo), "=d"(hi));
+	return (static_cast<uint64>(hi) << 32) | lo;
+}
+#endif
+#endif
 	
 template <class TimeType>
 class Timer {
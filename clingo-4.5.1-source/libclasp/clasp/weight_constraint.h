@@ -122,6 +122,7 @@ public:
 	bool minimize(Solver& s, Literal p, CCMinRecursive* r);
 	void undoLevel(Solver& s);
 	uint32 estimateComplexity(const Solver& s) const;
+	PropagatorClass propClass() const { return Propagator_t::prop_weight; }
 	/*!
 	 * Logically, we distinguish two constraints: 
 	 * FFB_BTB for handling forward false body and backward true body and
@@ -81,9 +81,12 @@ bool Preprocessor::preprocessEq(uint32 maxIters) {
 	bodyInfo_.resize( prg_->numBodies() + 1 );
 	do {
 		if (++pass_ > 1) {
-			for (HeadIter it = prg_->atom_begin(), end = atoms.second; it != end; ) {
-				while (it != atoms.first){ (*it)->setInUpper(false); ++it; }
-				while (it != end)        { (*it)->clearLiteral(false); (*it)->setInUpper(false); ++it; }
+			for (LogicProgram::VarIter it = prg_->frontier_begin(), end = prg_->frontier_end(); it != end; ++it) {
+				prg_->getAtom(*it)->setInUpper(false);
+			}
+			for (HeadIter it = atoms.first, end = atoms.second; it != end; ++it) {
+				(*it)->clearLiteral(false);
+				(*it)->setInUpper(false);
 			}
 			for (HeadIter it = prg_->disj_begin(), end = prg_->disj_end(); it != end; ++it) {
 				(*it)->clearLiteral(false);
@@ -234,7 +237,11 @@ bool Preprocessor::addHeadsToUpper(PrgBody* body) {
 	PrgEdge  support;
 	bool ok  = !prg_->hasConflict();
 	int dirty= 0;
-	for (PrgBody::head_iterator it = body->heads_begin(), end = body->heads_end(); it != end && ok; ++it) {
+	// iterate over a copy because propagating a head may remove
+	// heads that became false from body; removed heads are skipped
+	heads_.assign(body->heads_begin(), body->heads_end());
+	for (EdgeVec::const_iterator it = heads_.begin(), end = heads_.end(); it != end && ok; ++it) {
+		if (std::find(body->heads_begin(), body->heads_end(), *it) == body->heads_end()) { continue; }
 		head   = prg_->getHead(*it);
 		support= PrgEdge::newEdge(body->id(), it->type(), PrgEdge::BODY_NODE);
 		if (head->relevant() && head->value() != value_false) {
@@ -21,6 +21,7 @@
 #include <clasp/solver.h>
 #include <clasp/clause.h>
 #include <clasp/util/mutex.h>
+#include <clasp/util/atomic.h>
 #include <stdio.h> // sprintf
 #ifdef _MSC_VER
 #pragma warning (disable : 4996) // sprintf may be unfase
@@ -30,9 +31,25 @@ namespace Clasp {
 /////////////////////////////////////////////////////////////////////////////////////////
 // CBConsequences::SharedConstraint
 /////////////////////////////////////////////////////////////////////////////////////////
+// In addition to the current constraint, the shared constraint stores the set of 
+// decided atoms, i.e. atoms that are known to be (brave) or not to be (cautious)
+// consequences, as a bitset over the enumerator's consequence literals. 
+// The bitset is only extended while models are committed but it is read 
+// without locking by the solvers when they select their next target.
 class CBConsequences::SharedConstraint {
 public:
-	SharedConstraint() : current(0) {}
+	typedef Clasp::atomic<uint32> Word;
+	explicit SharedConstraint(const LitVec& cons, bool brave) : current(0), decided(0), numWords((static_cast<uint32>(cons.size()) + 31) / 32) {
+		decided = new Word[numWords];
+		for (uint32 i = 0; i != numWords; ++i) { decided[i] = 0; }
+		if (uint32 x = static_cast<uint32>(cons.size()) & 31u) { decided[numWords-1] = ~((uint32(1) << x) - 1); }
+		target.reserve(cons.size());
+		for (LitVec::const_iterator it = cons.begin(), end = cons.end(); it != end; ++it) {
+			Literal p = *it; p.clearWatch();
+			target.push_back(brave ? p : ~p);
+		}
+	}
+	~SharedConstraint() { delete [] decided; }
 	SharedLiterals* fetch_if_neq(SharedLiterals* last) const {
 		Clasp::lock_guard<Clasp::spin_mutex> lock(mutex);
 		return last != current ? current->share() : 0;
@@ -42,7 +59,19 @@ public:
 		{ Clasp::lock_guard<Clasp::spin_mutex> lock(mutex); current = newLits; }
 		if (old) { old->release(); }
 	}
+	void   setDecided(uint32 i)        { fetch_and_or(decided[i / 32], uint32(1) << (i & 31)); }
+	uint32 decidedWord(uint32 w) const { return decided[w]; }
+	// returns the target of the first open atom in word w that is free in s or 0 if no such atom exists
+	Literal freeTarget(const Solver& s, uint32 w, uint32 open) const {
+		for (const Literal* x = &target[0] + (w * 32); open; ++x, open >>= 1) {
+			if ((open & 1u) != 0 && s.value(x->var()) == value_free) { return *x; }
+		}
+		return posLit(0);
+	}
 	SharedLiterals*           current;
+	Word*                     decided;  // bitset of decided atoms
+	uint32                    numWords; // size of decided
+	LitVec                    target;   // literals to make true in order to decide atoms
 	mutable Clasp::spin_mutex mutex;
 };
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -53,16 +82,20 @@ public:
 	typedef CBConsequences::SharedConstraint  SharedCon;
 	typedef Solver::ConstraintDB              ConstraintDB;
 	typedef SharedLiterals                    SharedLits;
+	typedef PodVector<uint32>::type           WordVec;
 	explicit CBFinder(SharedCon* sh) : EnumerationConstraint(), shared(sh), last(0) {}
 	ConPtr clone() { return new CBFinder(shared); }
 	void   doCommitModel(Enumerator& ctx, Solver& s) { static_cast<CBConsequences&>(ctx).addCurrent(s, current, s.model); }
 	void   destroy(Solver* s, bool detach);
 	bool   doUpdate(Solver& s);
+	bool   selectTarget(Solver& s);
 	void   pushLocked(Solver& s, ClauseHead* h);
 	LitVec       current;
 	SharedCon*   shared;
 	SharedLits*  last;
 	ConstraintDB locked;
+	WordVec      seen;  // decided atoms already processed by this solver
+	ValueVec     prefs; // preferences replaced by target values
 };
 /////////////////////////////////////////////////////////////////////////////////////////
 // CBConsequences
@@ -104,7 +137,7 @@ EnumerationConstraint* CBConsequences::doInit(SharedContext& ctx, SharedMinimize
 		it->asUint() |= m;
 	}
 	delete shared_;
-	shared_ = ctx.concurrency() > 1 ? new SharedConstraint() : 0;
+	shared_ = ctx.concurrency() > 1 ? new SharedConstraint(cons_, type_ == brave_consequences) : 0;
 	setIgnoreSymmetric(true);
 	return new CBFinder(shared_);
 }
@@ -119,6 +152,7 @@ void CBConsequences::addCurrent(Solver& s, LitVec& con, ValueVec& m) {
 			Literal& p = *it;
 			if (s.isTrue(p) || p.watched())  { 
 				m[p.var()] |= trueValue(p); 
+				if (shared_ && !p.watched()) { shared_->setDecided(static_cast<uint32>(it - cons_.begin())); }
 				p.watch();
 			}
 			else if (s.level(p.var())) {
@@ -131,6 +165,7 @@ void CBConsequences::addCurrent(Solver& s, LitVec& con, ValueVec& m) {
 			Literal& p = *it;
 			if (!s.isTrue(p) || !p.watched()) {
 				m[p.var()] &= ~trueValue(p);
+				if (shared_ && p.watched()) { shared_->setDecided(static_cast<uint32>(it - cons_.begin())); }
 				p.clearWatch();
 			}
 			else {
@@ -174,6 +209,45 @@ bool CBConsequences::CBFinder::doUpdate(Solver& s) {
 	}
 	if (ret.local) { pushLocked(s, ret.local); }
 	current.clear();
-	return ret.ok();
+	return ret.ok() && (!shared || selectTarget(s));
+}
+// Solvers partition the words of the shared bitset of decided atoms
+// round-robin. Each solver prefers the target values of the open atoms
+// in its partition and, if it is on its root level, assumes the first 
+// free one as a decision. Once its partition is decided, a solver 
+// helps with the open atoms of the other partitions. The previous 
+// preference of an atom is restored once the atom is decided.
+bool CBConsequences::CBFinder::selectTarget(Solver& s) {
+	const uint32 nw = shared->numWords, n = s.sharedContext()->concurrency();
+	const bool   first = seen.empty();
+	const bool   root  = s.decisionLevel() == s.rootLevel();
+	if (first) { seen.assign(nw, 0); prefs.assign(shared->target.size(), value_free); }
+	Literal t = posLit(0);
+	for (uint32 w = s.id(); w < nw; w += n) {
+		uint32 dec = shared->decidedWord(w);
+		uint32 upd = first ? ~dec : (dec & ~seen[w]);
+		for (uint32 b = 0; upd; ++b, upd >>= 1) {
+			if ((upd & 1u) != 0) {
+				uint32  i = (w * 32) + b;
+				Literal x = shared->target[i];
+				if (first) {
+					prefs[i] = s.pref(x.var()).get(ValueSet::pref_value);
+					s.setPref(x.var(), ValueSet::pref_value, trueValue(x));
+				}
+				else {
+					s.setPref(x.var(), ValueSet::pref_value, prefs[i]);
+				}
+			}
+		}
+		seen[w] = dec;
+		if (root && t.var() == 0) { t = shared->freeTarget(s, w, ~dec); }
+	}
+	for (uint32 w = 0; root && w != nw && t.var() == 0; ++w) {
+		t = shared->freeTarget(s, w, ~shared->decidedWord(w));
+	}
+	if (t.var() != 0 && s.propagate() && s.value(t.var()) == value_free) {
+		s.assume(t);
+	}
+	return !s.hasConflict();
 }
 }
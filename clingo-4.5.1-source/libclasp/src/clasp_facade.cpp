@@ -59,6 +59,7 @@ void ClaspConfig::prepare(SharedContext& ctx) {
 		ctx.report(warning(Event::subsystem_facade, clasp_format_error("Oversubscription: #Threads=%u exceeds logical CPUs=%u.", numS, solve.recommendedSolvers())));
 	}
 	if (std::abs(solve.numModels) != 1) { satPre.mode = SatPreParams::prepro_preserve_models; }
+	if (solve.counting())               { satPre.type = SatPreParams::sat_pre_no; }
 	solve.setSolvers(numS);
 	ctx.setConcurrency(solve.numSolver(), SharedContext::mode_resize);
 }
@@ -106,11 +107,12 @@ protected:
 struct ClaspFacade::SolveData {
 	typedef SingleOwnerPtr<SolveAlgorithm> AlgoPtr;
 	typedef SingleOwnerPtr<Enumerator>     EnumPtr;
-	SolveData() : en(0), algo(0), active(0), prepared(false), interruptible(false) { }
+	SolveData() : en(0), algo(0), counter(0), active(0), prepared(false), interruptible(false) { }
 	~SolveData() { reset(); }
-	void init(SolveAlgorithm* algo, Enumerator* en) {
+	void init(SolveAlgorithm* algo, Enumerator* en, ModelCounter* counter = 0) {
 		this->en = en;
 		this->algo = algo;
+		this->counter = counter;
 		this->algo->setEnumerator(*en);
 		if (interruptible) {
 			this->algo->enableInterrupts();
@@ -141,6 +143,7 @@ struct ClaspFacade::SolveData {
 	int                       modelType() const  { return en.get() ? en->modelType() : 0; }
 	EnumPtr        en;
 	AlgoPtr        algo;
+	ModelCounter*  counter; // algo if models are counted
 	SolveStrategy* active;
 	bool           prepared;
 	bool           interruptible;
@@ -297,9 +300,13 @@ void ClaspFacade::init(ClaspConfig& config, bool discard) {
 		ctx.report(warning(Event::subsystem_facade, "Reasoning mode requires domain heuristic and is ignored!"));
 		config_->solve.enumMode = EnumOptions::enum_auto;
 	}
+	if (config_->solve.counting() && config_->solve.consequences()) {
+		ctx.report(warning(Event::subsystem_facade, "Counting: reasoning mode ignored!"));
+		config_->solve.enumMode = EnumOptions::enum_auto;
+	}
 	SolveData::EnumPtr e(config.solve.createEnumerator(config.solve));
 	if (e.get() == 0) { e = EnumOptions::nullEnumerator(); }
-	if (config.solve.numSolver() > 1 && !e->supportsParallel()) {
+	if (config.solve.numSolver() > 1 && (!e->supportsParallel() || config.solve.counting())) {
 		ctx.report(warning(Event::subsystem_facade, "Selected reasoning mode implies #Threads=1."));
 		config.solve.setSolvers(1);
 	}
@@ -310,8 +317,9 @@ void ClaspFacade::init(ClaspConfig& config, bool discard) {
 		p->setNonHcfConfiguration(config.testerConfig());
 	}
 	if (!solve_.get()) { solve_ = new SolveData(); }
-	SolveData::AlgoPtr a(config.solve.createSolveObject());
-	solve_->init(a.release(), e.release());
+	ModelCounter* counter = config.solve.counting() ? new ModelCounter(config.solve, 0, config.solve.limit) : 0;
+	SolveData::AlgoPtr a(counter ? counter : config.solve.createSolveObject());
+	solve_->init(a.release(), e.release(), counter);
 	if (discard) { startStep(0); }
 }
 
@@ -410,7 +418,7 @@ bool ClaspFacade::prepare(EnumMode enumMode) {
 	if (prg && prg->endProgram()) {
 		assume_.clear();
 		prg->getAssumptions(assume_);
-		if ((m = en.optMode != MinimizeMode_t::ignore ? prg->getMinimizeConstraint(&en.optBound) : 0) != 0) {
+		if ((m = en.optMode != MinimizeMode_t::ignore && !en.counting() ? prg->getMinimizeConstraint(&en.optBound) : 0) != 0) {
 			if (!m->setMode(en.optMode, en.optBound)) {
 				assume_.push_back(~ctx.stepLiteral());
 			}
@@ -436,6 +444,12 @@ bool ClaspFacade::prepared()    const { return solve_.get() && solve_->prepared;
 bool ClaspFacade::solving()     const { return solve_.get() && solve_->solving(); }
 bool ClaspFacade::solved()      const { return step_.totalTime >= 0; }
 bool ClaspFacade::interrupted() const { return result().interrupted(); }
+const LitVec* ClaspFacade::unsatCore() const {
+	return result().unsat() && !solving() && solve_.get() && solve_->algo.get() ? solve_->algo->unsatCore() : 0;
+}
+const ModelCounter* ClaspFacade::counter() const {
+	return solve_.get() ? solve_->counter : 0;
+}
 
 const ClaspFacade::Summary& ClaspFacade::shutdown() {
 	if (solve_.get()) {
@@ -637,6 +651,10 @@ bool ClaspFacade::Summary::optimize()      const {
 	}
 	return false;
 }
+const ModelCounter* ClaspFacade::Summary::counter() const {
+	const ModelCounter* c = facade->counter();
+	return c && c->counted() ? c : 0;
+}
 const char* ClaspFacade::Summary::consequences() const {
 	int mt = facade->solve_.get() ? facade->solve_->modelType() : 0;
 	if ((mt & CBConsequences::brave_consequences) == CBConsequences::brave_consequences)   { return "Brave"; }
@@ -201,6 +201,7 @@ void StatsVisitor::visitSolverStats(const Clasp::SolverStats& stats, bool accu)
 	visitCoreSolverStats(ext->cpuTime, ext->models, stats, accu);
 	if (stats.extra) { visitExtSolverStats(*stats.extra, accu); }
 	if (stats.jumps) { visitJumpStats(*stats.jumps, accu); }
+	if (stats.props) { visitPropStats(*stats.props, accu); }
 }
 
 void StatsVisitor::visitThreads(const SharedContext& ctx) {
@@ -353,6 +354,22 @@ void JsonOutput::visitJumpStats(const JumpStats& st, bool) {
 	popObject();
 	popObject();
 }
+void JsonOutput::visitPropStats(const PropStats& st, bool) {
+	const char* names[] = {"Short", "Clause", "Weight", "Minimize", "Other", "Unfounded", "Lookahead", "Post"};
+	static_assert(sizeof(names)/sizeof(names[0]) == PropStats::num_classes, "Unexpected number of propagator classes");
+	pushObject("Propagation");
+	printKeyValue("Ticks", st.total());
+	printKeyValue("Calls", st.totalCalls());
+	for (uint32 i = 0; i != PropStats::num_classes; ++i) {
+		PropagatorClass c = static_cast<PropagatorClass>(i);
+		pushObject(names[i]);
+		printKeyValue("Ticks", st.ticks[c]);
+		printKeyValue("Calls", st.calls[c]);
+		printKeyValue("Ratio", st.share(c));
+		popObject();
+	}
+	popObject();
+}
 void JsonOutput::visitLogicProgramStats(const Asp::LpStats& lp) {
 	using namespace Asp;
 	pushObject("LP");
@@ -382,6 +399,7 @@ void JsonOutput::visitLogicProgramStats(const Asp::LpStats& lp) {
 		}
 		popObject();
 	}
+	if (lp.dupRules) { printKeyValue("Duplicates", lp.dupRules); }
 	popObject(); // Rules
 	printKeyValue("Bodies", lp.bodies);
 	if      (lp.sccs == 0)              { printKeyValue("Tight", "yes"); }
@@ -399,6 +417,7 @@ void JsonOutput::visitLogicProgramStats(const Asp::LpStats& lp) {
 	printKeyValue("Body", lp.eqs(Var_t::body_var));
 	printKeyValue("Other", lp.eqs(Var_t::atom_body_var));
 	popObject();
+	printKeyValue("PreproTime", lp.prepTime);
 	popObject(); // LP
 }
 void JsonOutput::visitProblemStats(const ProblemStats& p) {
@@ -532,6 +551,11 @@ void JsonOutput::printSummary(const ClaspFacade::Summary& run, bool final) {
 		printKeyValue("Number", run.enumerated());
 		printKeyValue("More"  , run.complete() ? "no" : "yes");
 		if (run.sat()) {
+			if (const ModelCounter* c = run.counter()) {
+				printKey("Count");
+				printf("%s", c->count().toString().c_str());
+				printKeyValue("Exact", c->exact() ? "yes" : "no");
+			}
 			if (run.consequences()){ printKeyValue(run.consequences(), run.complete() ? "yes":"unknown"); }
 			if (run.optimize())    { 
 				printKeyValue("Optimum", run.optimum()?"yes":"unknown"); 
@@ -671,6 +695,10 @@ void TextOutput::printSummary(const ClaspFacade::Summary& run, bool final) {
 		buf[wr]=0;
 		printf("%-6s\n", buf);
 		if (run.sat()) {
+			if (const ModelCounter* c = run.counter()) {
+				printKey("  Count");
+				printf("%s (%s)\n", c->count().toString().c_str(), c->exact() ? "exact" : "approximate");
+			}
 			if (run.consequences()) { printLN(cat_comment, "  %-*s: %s", width_-2, run.consequences(), (run.complete()?"yes":"unknown")); }
 			if (run.costs())        { printKeyValue("  Optimum", "%s\n", run.optimum()?"yes":"unknown"); }
 			if (run.optimize())     {
@@ -864,6 +892,9 @@ void TextOutput::visitLogicProgramStats(const Asp::LpStats& lp) {
 		}
 	}
 	printf("%c\n", close);
+	if (lp.dupRules) {
+		printKeyValue("Duplicates", "%-8u\n", lp.dupRules);
+	}
 	printKeyValue("Bodies", "%-8u\n", lp.bodies);
 	if (lp.eqs() > 0) {
 		printKeyValue("Equivalences", "%-8u", lp.eqs());
@@ -877,6 +908,7 @@ void TextOutput::visitLogicProgramStats(const Asp::LpStats& lp) {
 	else if (lp.sccs != PrgNode::noScc) { printf("%-8s (SCCs: %u Non-Hcfs: %u Nodes: %u Gammas: %u)", "No", lp.sccs, lp.nonHcfs, lp.ufsNodes, lp.gammas); }
 	else                                 { printf("N/A"); }
 	printf("\n");
+	printKeyValue("Prepro Time", "%.3fs\n", lp.prepTime);
 }
 void TextOutput::visitProblemStats(const ProblemStats& ps) {
 	uint32 sum = ps.constraints + ps.constraints_binary + ps.constraints_ternary;
@@ -944,6 +976,18 @@ void TextOutput::visitJumpStats(const JumpStats& st, bool) {
 	printKeyValue("  Bounded", "%-8" PRIu64, st.bounded);
 	printf(" (Average: %5.2f Max: %3u Sum: %6" PRIu64" Ratio: %6.2f%%)\n", st.avgBound(), st.maxBound, st.boundSum, 100.0 - (st.jumpedRatio()*100.0));
 }
+void TextOutput::visitPropStats(const PropStats& st, bool) {
+	const char* names[] = {"  Short", "  Clause", "  Weight", "  Minimize", "  Other", "  Unfounded", "  Lookahead", "  Post"};
+	static_assert(sizeof(names)/sizeof(names[0]) == PropStats::num_classes, "Unexpected number of propagator classes");
+	printKeyValue("Prop. Ticks", "%-8" PRIu64, st.total());
+	printf(" (Calls: %" PRIu64")\n", st.totalCalls());
+	for (uint32 i = 0; i != PropStats::num_classes; ++i) {
+		PropagatorClass c = static_cast<PropagatorClass>(i);
+		if (!st.calls[c]) { continue; }
+		printKeyValue(names[i], "%-8" PRIu64, st.ticks[c]);
+		printf(" (Calls: %" PRIu64" Average: %.1f Ratio: %6.2f%%)\n", st.calls[c], st.avgTicks(c), st.share(c));
+	}
+}
 
 #undef printKeyValue
 #undef printKey
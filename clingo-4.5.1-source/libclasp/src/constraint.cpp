@@ -33,6 +33,7 @@ void Constraint::undoLevel(Solver&)       {}
 uint32 Constraint::estimateComplexity(const Solver&) const { return 1;  }
 bool Constraint::valid(Solver&)           { return true; }
 ClauseHead* Constraint::clause()          { return 0; } 
+PropagatorClass Constraint::propClass() const { return Propagator_t::prop_other; }
 LearntConstraint::~LearntConstraint()     {}
 LearntConstraint::LearntConstraint()      {}
 Activity LearntConstraint::activity() const{ return Activity(0,  (1u<<7)-1); }
@@ -46,6 +47,7 @@ PostPropagator::PostPropagator() : next(0)           {}
 PostPropagator::~PostPropagator()                    {}
 bool PostPropagator::init(Solver&)                   { return true; }
 void PostPropagator::reset()                         {}
+PropagatorClass PostPropagator::propClass() const    { return Propagator_t::prop_post; }
 bool PostPropagator::isModel(Solver& s)              { return valid(s); }
 void PostPropagator::reason(Solver&, Literal, LitVec&) {}
 Constraint::PropResult PostPropagator::propagate(Solver&, Literal, uint32&) { 
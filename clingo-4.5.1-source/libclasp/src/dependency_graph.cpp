@@ -26,6 +26,9 @@
 #include <clasp/clause.h>
 #include <clasp/solve_algorithms.h>
 #include <clasp/util/timer.h>
+#include <clasp/util/thread.h>
+#include <functional>
+#include <new>
 namespace Clasp {
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -34,17 +37,16 @@ namespace Clasp {
 SharedDependencyGraph::SharedDependencyGraph(Configuration* cfg) : config_(cfg) {
 	// add sentinal atom needed for disjunctions
 	createAtom(negLit(0), PrgNode::noScc);
-	VarVec adj;	adj.push_back(idMax);
-	initAtom(sentinel_atom, 0, adj, 0);
+	NodeId* mem = new NodeId[1];
+	blocks_.push_back(mem);
+	NodeId adj  = idMax;
+	initAtom(sentinel_atom, &adj, 1, 0, mem);
 	seenComponents_ = 0;
 }
 
 SharedDependencyGraph::~SharedDependencyGraph() {
-	for (AtomVec::size_type i = 0; i != atoms_.size(); ++i) {
-		delete [] atoms_[i].adj_;
-	}
-	for (AtomVec::size_type i = 0; i != bodies_.size(); ++i) {
-		delete [] bodies_[i].adj_;
+	for (BlockVec::size_type i = 0; i != blocks_.size(); ++i) {
+		delete [] blocks_[i];
 	}
 	while (!components_.empty()) {
 		delete components_.back().second;
@@ -59,6 +61,103 @@ bool SharedDependencyGraph::relevantPrgBody(const Solver& s, PrgBody* b) const {
 	return !s.isFalse(b->literal()); 
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+// class SharedDependencyGraph::NodeBuilder
+//
+// Initializes the adjacency lists of the nodes in [first, last).
+// A builder only writes to its own nodes and memory block. 
+// Hence, builders for disjoint ranges can run concurrently.
+/////////////////////////////////////////////////////////////////////////////////////////
+class SharedDependencyGraph::NodeBuilder {
+public:
+	typedef void (NodeBuilder::*InitFun)();
+	NodeBuilder() : graph(0), prg(0), bodies(0), adj(0), offs(0), preds(0), mem(0), first(0), last(0), init(0), error(false) {}
+	void run() {
+		try                           { (this->*init)(); }
+		catch (const std::bad_alloc&) { error = true; }
+	}
+	// Computes the preds and heads of all bodies in range and 
+	// stores them in one new block of memory.
+	void initBodies() {
+		VarVec lists, bPreds, bHeads;
+		for (uint32 id = first; id != last; ++id) {
+			PrgBody* b = bodies[id - first];
+			bPreds.clear(); bHeads.clear();
+			graph->addPreds(*prg, b, graph->bodies_[id].scc, bPreds);
+			graph->addHeads(*prg, b, bHeads);
+			lists.push_back(bPreds.size());
+			lists.push_back(bHeads.size());
+			lists.insert(lists.end(), bPreds.begin(), bPreds.end());
+			lists.insert(lists.end(), bHeads.begin(), bHeads.end());
+		}
+		mem = new NodeId[lists.size() - 2*(last - first)];
+		NodeId* m = mem;
+		for (const NodeId* it = lists.begin(), *end = lists.end(); it != end;) {
+			uint32 nPreds = *it++, nHeads = *it++;
+			graph->initBody(first++, it, nPreds, it + nPreds, nHeads, m);
+			m  += nPreds + nHeads;
+			it += nPreds + nHeads;
+		}
+	}
+	// Copies the staged adjacency lists of all atoms in range to their final place.
+	// Pre: mem points to the block reserved for the atom first.
+	void initAtoms() {
+		for (uint32 id = first, k = 0; id != last; ++id, ++k) {
+			graph->initAtom(id, adj + offs[k], offs[k+1] - offs[k], preds[k], mem + (offs[k] - offs[0]));
+		}
+	}
+	SharedDependencyGraph* graph;
+	const LogicProgram*    prg;
+	PrgBody* const*        bodies; // program bodies of nodes in range
+	const NodeId*          adj;    // staged adjacency lists of atoms
+	const uint32*          offs;   // offsets of atoms in range into adj
+	const uint32*          preds;  // number of preds of atoms in range
+	NodeId*                mem;    // memory block of nodes in range
+	uint32                 first;
+	uint32                 last;
+	InitFun                init;
+	bool                   error;
+};
+#if WITH_THREADS
+// Minimal number of nodes for which a separate builder thread is used.
+static const uint32 nodes_per_builder = 16384;
+#endif
+static uint32 numBuilders(const SharedContext& ctx, uint32 nodes) {
+#if WITH_THREADS
+	return std::max(std::min(ctx.concurrency(), nodes / nodes_per_builder), uint32(1));
+#else
+	(void)ctx; (void)nodes;
+	return 1;
+#endif
+}
+
+struct LessScc {
+	bool operator()(const Asp::PrgAtom* lhs, const Asp::PrgAtom* rhs) const { return lhs->scc() < rhs->scc(); }
+};
+
+// Runs the given builders - concurrently if possible.
+void SharedDependencyGraph::buildNodes(NodeBuilder* b, uint32 num) {
+#if WITH_THREADS
+	if (num > 1) {
+		Clasp::thread* t = new Clasp::thread[num - 1];
+		for (uint32 i = 1; i != num; ++i) {
+			Clasp::thread(std::mem_fun(&NodeBuilder::run), b + i).swap(t[i-1]);
+		}
+		b[0].run();
+		for (uint32 i = 1; i != num; ++i) { t[i-1].join(); }
+		delete [] t;
+	}
+	else
+#endif
+	for (uint32 i = 0; i != num; ++i) { b[i].run(); }
+	bool error = false;
+	for (uint32 i = 0; i != num; ++i) {
+		if (b[i].init == &NodeBuilder::initBodies && b[i].mem) { blocks_.push_back(b[i].mem); }
+		error |= b[i].error;
+	}
+	if (error) { throw std::bad_alloc(); }
+}
+
 // Creates a positive-body-atom-dependency graph (PBADG)
 // The PBADG contains a node for each atom A of a non-trivial SCC and
 // a node for each body B, s.th. there is a non-trivially connected atom A with
@@ -70,75 +169,124 @@ void SharedDependencyGraph::addSccs(LogicProgram& prg, const AtomList& sccAtoms,
 	atoms_.reserve(atoms_.size() + sccAtoms.size());
 	AtomList::size_type numBodies = 0;
 	SharedContext& ctx = *prg.ctx();
+	const uint32 firstAtom = numAtoms(), firstBody = (uint32)bodies_.size();
+	AtomList newAtoms;
 	for (AtomList::size_type i = 0, end = sccAtoms.size(); i != end; ++i) {
-		PrgAtom* a = sccAtoms[i];
-		if (relevantPrgAtom(*ctx.master(), a)) {
-			// add graph atom node and store link between program node and graph node for later lookup
-			a->resetId(createAtom(a->literal(), a->scc()), true);
-			// atom is defined by more than just a bunch of clauses
-			ctx.setFrozen(a->var(), true);
-			numBodies += a->supports();
-		}
+		if (relevantPrgAtom(*ctx.master(), sccAtoms[i])) { newAtoms.push_back(sccAtoms[i]); }
+	}
+	// atoms of one scc get consecutive ids so that their nodes and adjacency lists are contiguous
+	std::stable_sort(newAtoms.begin(), newAtoms.end(), LessScc());
+	for (AtomList::size_type i = 0, end = newAtoms.size(); i != end; ++i) {
+		PrgAtom* a = newAtoms[i];
+		// add graph atom node and store link between program node and graph node for later lookup
+		a->resetId(createAtom(a->literal(), a->scc()), true);
+		// atom is defined by more than just a bunch of clauses
+		ctx.setFrozen(a->var(), true);
+		numBodies += a->supports();
 	}
-	// Pass 2: Init atom nodes and create body nodes
-	VarVec adj, ext;
+	// Pass 2: Create body nodes and stage adjacency lists of atom nodes.
+	// Bodies are numbered in the order in which they are first reached.
+	VarVec adj, ext, offs, preds;
+	BodyList newBodies;
 	bodies_.reserve(bodies_.size() + numBodies/2);
+	offs.reserve(newAtoms.size() + 1);
+	preds.reserve(newAtoms.size());
 	PrgBody* prgBody; PrgDisj* prgDis;
-	for (AtomList::size_type i = 0, end = sccAtoms.size(); i != end; ++i) {
-		PrgAtom*   a  = sccAtoms[i];
-		if (relevantPrgAtom(*ctx.master(), a)) { 
-			uint32 prop = 0;
-			for (PrgAtom::sup_iterator it = a->supps_begin(), endIt = a->supps_end(); it != endIt; ++it) {
-				assert(it->isBody() || it->isDisj());
-				NodeId bId= PrgNode::maxVertex;
-				if (it->isBody() && !it->isGamma()) {
-					prgBody = prg.getBody(it->node());
-					bId     = relevantPrgBody(*ctx.master(), prgBody) ? addBody(prg, prgBody) : PrgNode::maxVertex;
+	for (AtomList::size_type i = 0, end = newAtoms.size(); i != end; ++i) {
+		PrgAtom*   a  = newAtoms[i];
+		uint32 prop   = 0;
+		uint32 start  = adj.size();
+		offs.push_back(start);
+		for (PrgAtom::sup_iterator it = a->supps_begin(), endIt = a->supps_end(); it != endIt; ++it) {
+			assert(it->isBody() || it->isDisj());
+			NodeId bId= PrgNode::maxVertex;
+			if (it->isBody() && !it->isGamma()) {
+				prgBody = prg.getBody(it->node());
+				bId     = relevantPrgBody(*ctx.master(), prgBody) ? addBody(prg, prgBody, newBodies) : PrgNode::maxVertex;
+			}
+			else if (it->isDisj()) {
+				prgDis  = prg.getDisj(it->node());
+				bId     = addDisj(prg, prgDis, newBodies);
+				prop   |= AtomNode::property_in_disj;
+				ctx.setInDisj(a->var(), true);
+			}
+			if (bId != PrgNode::maxVertex) {
+				if (!bodies_[bId].seen()) {
+					bodies_[bId].seen(true);
+					adj.push_back(bId);
 				}
-				else if (it->isDisj()) {
-					prgDis  = prg.getDisj(it->node());
-					bId     = addDisj(prg, prgDis);
-					prop   |= AtomNode::property_in_disj;
-					ctx.setInDisj(a->var(), true);
-				}
-				if (bId != PrgNode::maxVertex) {
-					if (!bodies_[bId].seen()) {
-						bodies_[bId].seen(true);
-						adj.push_back(bId);
-					}
-					if (it->isChoice()) {
-						// mark atom as in choice
-						prop |= AtomNode::property_in_choice;
-					}
+				if (it->isChoice()) {
+					// mark atom as in choice
+					prop |= AtomNode::property_in_choice;
 				}
 			}
-			uint32 nPred= (uint32)adj.size();
-			for (PrgAtom::dep_iterator it = a->deps_begin(), endIt = a->deps_end(); it != endIt; ++it) {
-				if (!it->sign()) {
-					prgBody = prg.getBody(it->var());
-					if (relevantPrgBody(*ctx.master(), prgBody) && prgBody->scc(prg) == a->scc()) {
-						NodeId bodyId = addBody(prg, prgBody);
-						if (!bodies_[bodyId].extended()) {
-							adj.push_back(bodyId);
-						}
-						else {
-							ext.push_back(bodyId);
-							ext.push_back(bodies_[bodyId].get_pred_idx(a->id()));
-							assert(bodies_[bodyId].get_pred(ext.back()) == a->id());
-							prop |= AtomNode::property_in_ext;
-						}
+		}
+		uint32 nPred= (uint32)adj.size() - start;
+		for (VarVec::const_iterator it = adj.begin() + start, endIt = adj.end(); it != endIt; ++it) {
+			bodies_[*it].seen(false);
+		}
+		for (PrgAtom::dep_iterator it = a->deps_begin(), endIt = a->deps_end(); it != endIt; ++it) {
+			if (!it->sign()) {
+				prgBody = prg.getBody(it->var());
+				if (relevantPrgBody(*ctx.master(), prgBody) && prgBody->scc(prg) == a->scc()) {
+					NodeId bodyId = addBody(prg, prgBody, newBodies);
+					if (!bodies_[bodyId].extended()) {
+						adj.push_back(bodyId);
+					}
+					else {
+						// position of atom in body is set once preds of body are known
+						ext.push_back(bodyId);
+						ext.push_back(idMax);
+						prop |= AtomNode::property_in_ext;
 					}
 				}
 			}
-			if (!ext.empty()) {
-				adj.push_back(idMax);
-				adj.insert(adj.end(), ext.begin(), ext.end());
-			}
+		}
+		if (!ext.empty()) {
 			adj.push_back(idMax);
-			initAtom(a->id(), prop, adj, nPred);
-			adj.clear(); ext.clear();
+			adj.insert(adj.end(), ext.begin(), ext.end());
 		}
-	}	
+		adj.push_back(idMax);
+		atoms_[a->id()].setProperties(prop);
+		preds.push_back(nPred);
+		ext.clear();
+	}
+	offs.push_back(adj.size());
+	// Pass 3: Fill adjacency lists of new bodies and then those of new atoms.
+	NodeBuilder* b = 0;
+	try {
+		uint32 nb   = (uint32)bodies_.size() - firstBody;
+		uint32 num  = numBuilders(ctx, nb);
+		b = new NodeBuilder[num];
+		for (uint32 i = 0, first = firstBody; i != num; ++i) {
+			b[i].graph  = this;
+			b[i].prg    = &prg;
+			b[i].bodies = nb ? &newBodies[0] + (first - firstBody) : 0;
+			b[i].first  = first;
+			b[i].last   = first = firstBody + static_cast<uint32>((uint64(nb) * (i+1)) / num);
+			b[i].init   = &NodeBuilder::initBodies;
+		}
+		buildNodes(b, num);
+		delete [] b; b = 0;
+		uint32 na   = numAtoms() - firstAtom;
+		NodeId* mem = new NodeId[adj.size()];
+		blocks_.push_back(mem);
+		num = numBuilders(ctx, na);
+		b   = new NodeBuilder[num];
+		for (uint32 i = 0, first = firstAtom; i != num; ++i) {
+			b[i].graph  = this;
+			b[i].adj    = adj.empty() ? 0 : &adj[0];
+			b[i].offs   = &offs[0] + (first - firstAtom);
+			b[i].preds  = na ? &preds[0] + (first - firstAtom) : 0;
+			b[i].mem    = mem + offs[first - firstAtom];
+			b[i].first  = first;
+			b[i].last   = first = firstAtom + static_cast<uint32>((uint64(na) * (i+1)) / num);
+			b[i].init   = &NodeBuilder::initAtoms;
+		}
+		buildNodes(b, num);
+		delete [] b;
+	}
+	catch (...) { delete [] b; throw; }
 	// "update" existing non-hcf components
 	for (NonHcfIter it = nonHcfBegin(), end = nonHcfEnd(); it != end; ++it) {
 		it->second->update(ctx);
@@ -159,22 +307,30 @@ uint32 SharedDependencyGraph::createAtom(Literal lit, uint32 aScc) {
 	return id;
 }
 
-void SharedDependencyGraph::initAtom(uint32 id, uint32 prop, const VarVec& adj, uint32 numPreds) {
+// Initializes the atom node with the given id from the staged list adj and
+// stores its preds and succs in mem.
+void SharedDependencyGraph::initAtom(uint32 id, const NodeId* adj, uint32 size, uint32 numPreds, NodeId* mem) {
 	AtomNode& ua = atoms_[id];
-	ua.setProperties(prop);
-	ua.adj_      = new NodeId[adj.size()];
+	ua.adj_      = mem;
 	ua.sep_      = ua.adj_ + numPreds;
 	NodeId* sExt = ua.adj_;
 	NodeId* sSame= sExt + numPreds;
 	uint32  aScc = ua.scc;
-	for (VarVec::const_iterator it = adj.begin(), end = adj.begin()+numPreds; it != end; ++it) {
-		BodyNode& bn = bodies_[*it];
+	for (const NodeId* it = adj, *end = adj + numPreds; it != end; ++it) {
+		const BodyNode& bn = bodies_[*it];
 		if (bn.scc != aScc) { *sExt++ = *it; }
 		else                { *--sSame= *it; }
-		bn.seen(false);
 	}
 	std::reverse(sSame, ua.adj_ + numPreds);
-	std::copy(adj.begin()+numPreds, adj.end(), ua.sep_);
+	std::copy(adj+numPreds, adj+size, ua.sep_);
+	if (ua.inExtended()) {
+		NodeId* x = ua.sep_;
+		while (*x != idMax) { ++x; }
+		for (++x; *x != idMax; x += 2) {
+			x[1] = bodies_[*x].get_pred_idx(id);
+			assert(bodies_[*x].get_pred(x[1]) == id);
+		}
+	}
 }
 
 uint32 SharedDependencyGraph::createBody(PrgBody* b, uint32 bScc) {
@@ -183,15 +339,12 @@ uint32 SharedDependencyGraph::createBody(PrgBody* b, uint32 bScc) {
 	return id;
 }
 
-// Creates and initializes a body node for the given body b.
-uint32 SharedDependencyGraph::addBody(const LogicProgram& prg, PrgBody* b) {
+// Creates a body node for the given body b.
+// The adjacency lists of the new node are initialized later by a NodeBuilder.
+uint32 SharedDependencyGraph::addBody(const LogicProgram& prg, PrgBody* b, BodyList& newBodies) {
 	if (b->seen()) {     // first time we see this body - 
-		VarVec preds, atHeads;
-		uint32 bScc  = b->scc(prg);
-		NodeId bId   = createBody(b, bScc);
-		addPreds(prg, b, bScc, preds);
-		addHeads(prg, b, atHeads);
-		initBody(bId, preds, atHeads);
+		NodeId bId   = createBody(b, b->scc(prg));
+		newBodies.push_back(b);
 		b->resetId(bId, false);
 		prg.ctx()->setFrozen(b->var(), true);
 	}
@@ -267,18 +420,19 @@ uint32 SharedDependencyGraph::getAtoms(const LogicProgram& prg, PrgDisj* d, VarV
 	return scc;
 }
 
-// Initializes preds and succs lists of the body node with the given id.
-void SharedDependencyGraph::initBody(uint32 id, const VarVec& preds, const VarVec& atHeads) {
+// Initializes preds and succs lists of the body node with the given id
+// and stores them in mem.
+void SharedDependencyGraph::initBody(uint32 id, const NodeId* preds, uint32 numPreds, const NodeId* atHeads, uint32 numHeads, NodeId* mem) {
 	BodyNode* bn = &bodies_[id];
-	uint32 nSuccs= atHeads.size();
-	bn->adj_     = new NodeId[nSuccs + preds.size()];
+	uint32 nSuccs= numHeads;
+	bn->adj_     = mem;
 	bn->sep_     = bn->adj_ + nSuccs;
 	NodeId* sSame= bn->adj_;
 	NodeId* sExt = sSame + nSuccs;
 	uint32  bScc = bn->scc;
 	uint32  hScc = PrgNode::noScc;
 	uint32  disj = 0;
-	for (VarVec::const_iterator it = atHeads.begin(), end = atHeads.end(); it != end;) {
+	for (const NodeId* it = atHeads, *end = atHeads + numHeads; it != end;) {
 		if (*it) {
 			hScc = getAtom(*it).scc;
 			if (hScc == bScc) { *sSame++ = *it++; }
@@ -290,18 +444,18 @@ void SharedDependencyGraph::initBody(uint32 id, const VarVec& preds, const VarVe
 			else              { *--sExt  = *it++; while ( (*--sExt  = *it++) ) { ; } }
 		}
 	}
-	std::copy(preds.begin(), preds.end(), bn->sep_);
+	std::copy(preds, preds + numPreds, bn->sep_);
 	bn->sep_ += bn->extended();
 	if (disj) { bodies_[id].data |= BodyNode::flag_has_delta; }
 }
 
-uint32 SharedDependencyGraph::addDisj(const LogicProgram& prg, PrgDisj* d) {
+uint32 SharedDependencyGraph::addDisj(const LogicProgram& prg, PrgDisj* d, BodyList& newBodies) {
 	assert(d->inUpper() && d->supports() == 1);
 	if (d->seen()) { // first time we see this disjunction
 		PrgBody* prgBody = prg.getBody(d->supps_begin()->node());
 		uint32   bId     = PrgNode::maxVertex;
 		if (relevantPrgBody(*prg.ctx()->master(), prgBody)) {
-			bId = addBody(prg, prgBody);
+			bId = addBody(prg, prgBody, newBodies);
 		}
 		d->resetId(bId, false);
 	}
@@ -370,6 +524,9 @@ public:
 	typedef  NodeMap::iterator           MapIt;
 	typedef  NodeMap::const_iterator     MapIt_c;
 	typedef  std::pair<MapIt_c, MapIt_c> MapRange;
+	typedef  std::pair<uint32, Literal>  LevLit;
+	typedef  PodVector<LevLit>::type     LevLitVec;
+	struct LessLevel { bool operator()(const LevLit& lhs, const LevLit& rhs) const { return lhs.first < rhs.first; } };
 	void     addVars(Solver& generator, const SccGraph& dep, const VarVec& atoms, const VarVec& bodies, SharedContext& out);
 	void     addAtomConstraints(SharedContext& out);
 	void     addBodyConstraints(const Solver& generator, const SccGraph& dep, uint32 scc, SharedContext& out);
@@ -521,20 +678,31 @@ void SharedDependencyGraph::NonHcfComponent::ComponentMap::addBodyConstraints(co
 }
 
 // Maps the generator assignment given in s to a list of tester assumptions.
+// The assumptions are ordered by the decision level of the corresponding generator
+// literals (free literals last). Consecutive tests from one generator therefore tend
+// to share a long common prefix that the tester can keep on its root level.
 void SharedDependencyGraph::NonHcfComponent::ComponentMap::mapGeneratorAssignment(const Solver& s, const SccGraph& dep, LitVec& assume) const {
-	Literal  gen;
-	assume.clear(); assume.reserve(mapping.size());
+	LevLitVec temp; temp.reserve(mapping.size());
+	Literal   gen;
+	uint32    lev;
 	for (MapRange r = atoms(); r.first != r.second; ++r.first) {
 		const Mapping& at = *r.first;
 		assert(at.varUsed || at.atPos() == posLit(0));
 		if (!at.varUsed) { continue; }
 		gen = dep.getAtom(at.node).lit;
-		assume.push_back(at.atPos() ^ (!s.isTrue(gen)));
-		if (s.isFalse(gen)) { assume.push_back(~at.atUnf()); }
+		lev = s.value(gen.var()) != value_free ? s.level(gen.var()) : UINT32_MAX;
+		temp.push_back(LevLit(lev, at.atPos() ^ (!s.isTrue(gen))));
+		if (s.isFalse(gen)) { temp.push_back(LevLit(lev, ~at.atUnf())); }
 	}
 	for (MapRange r = bodies(); r.first != r.second; ++r.first) {
 		gen = dep.getBody(r.first->node).lit;
-		assume.push_back(r.first->bodyAux() ^ s.isFalse(gen));
+		lev = s.value(gen.var()) != value_free ? s.level(gen.var()) : UINT32_MAX;
+		temp.push_back(LevLit(lev, r.first->bodyAux() ^ s.isFalse(gen)));
+	}
+	std::stable_sort(temp.begin(), temp.end(), LessLevel());
+	assume.clear(); assume.reserve(temp.size());
+	for (LevLitVec::const_iterator it = temp.begin(), end = temp.end(); it != end; ++it) {
+		assume.push_back(it->second);
 	}
 }
 // Maps the tester model given in s back to a list of unfounded atoms in the generator.
@@ -603,9 +771,11 @@ SharedDependencyGraph::NonHcfComponent::NonHcfComponent(const SharedDependencyGr
 	comp_->addBodyConstraints(generator, dep, scc, *prg_);
 	prg_->enableStats(generator.stats.level());
 	prg_->endInit(true);
+	addSolve();
 }
 
 SharedDependencyGraph::NonHcfComponent::~NonHcfComponent() { 
+	for (SolveVec::size_type i = 0; i != solve_.size(); ++i) { delete solve_[i]; }
 	delete prg_;
 	delete comp_;
 }
@@ -616,6 +786,16 @@ void SharedDependencyGraph::NonHcfComponent::update(const SharedContext& generat
 		if (!prg_->hasSolver(i)) { prg_->attach(prg_->addSolver());   }
 		else                     { prg_->initStats(*prg_->solver(i)); }
 	}
+	addSolve();
+}
+
+// Creates search objects for new tester solvers and resets the search state of existing ones.
+void SharedDependencyGraph::NonHcfComponent::addSolve() {
+	for (uint32 i = 0; prg_->hasSolver(i); ++i) {
+		Solver& s = *prg_->solver(i);
+		if (i == solve_.size()) { solve_.push_back(new BasicSolve(s)); }
+		else                    { solve_[i]->reset(s, s.searchConfig(), 0); }
+	}
 }
 
 void SharedDependencyGraph::NonHcfComponent::assumptionsFromAssignment(const Solver& s, LitVec& assume) const {
@@ -628,17 +808,35 @@ bool SharedDependencyGraph::NonHcfComponent::test(uint32 scc, const Solver& gene
 	// Forwards to message handler of generator so that messages are 
 	// handled during long running tests.
 	struct Tester : MessageHandler {
-		Tester(Solver& s, MessageHandler* gen) : solver(&s), generator(gen) { if (gen) { s.addPost(this); } }
+		Tester(BasicSolve& bs, Solver& s, MessageHandler* gen) : solve(&bs), solver(&s), generator(gen) { if (gen) { s.addPost(this); } }
 		~Tester() { if (generator) { solver->removePost(this); } }
 		bool handleMessages()                            { return generator->handleMessages(); }
 		bool propagateFixpoint(Solver&, PostPropagator*) { return Tester::handleMessages() || !terminate(); }
 		bool terminate()                                 { solver->setStopConflict(); return true; }
 		int test(const LitVec& assume) {
-			return int(BasicSolve(*solver).satisfiable(assume, solver->stats.choices == 0) == false);
+			return int(!pushPath(assume) || solve->solve() != value_true);
+		}
+		// Keeps the longest prefix of the current root path that is still implied 
+		// by assume and only pushes the remaining assumptions.
+		bool pushPath(const LitVec& assume) {
+			Solver& s = *solver;
+			uint32 lev = 0;
+			LitVec::const_iterator it = assume.begin(), end = assume.end();
+			for (; it != end; ++it) {
+				if      (lev < s.rootLevel() && s.decision(lev+1) == *it) { ++lev; }
+				else if (!s.isTrue(*it) || s.level(it->var()) > lev)      { break; }
+			}
+			if (!s.popRootLevel(s.rootLevel() - lev) || !s.simplify()) { return false; }
+			s.stats.addPath(assume.size());
+			for (; it != end; ++it) {
+				if (!s.pushRoot(*it)) { return false; }
+			}
+			return true;
 		}
+		BasicSolve*     solve;
 		Solver*         solver;
 		MessageHandler* generator;
-	} tester(*prg_->solver(generator.id()), static_cast<MessageHandler*>(generator.getPost(PostPropagator::priority_reserved_msg)));
+	} tester(*solve_[generator.id()], *prg_->solver(generator.id()), static_cast<MessageHandler*>(generator.getPost(PostPropagator::priority_reserved_msg)));
 	SolveTestEvent ev(*tester.solver, scc, generator.numFreeVars() != 0);
 	tester.solver->stats.addTest(ev.partial);
 	generator.sharedContext()->report(ev);
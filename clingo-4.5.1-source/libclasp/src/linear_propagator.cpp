@@ -0,0 +1,285 @@
+//
+// Copyright (c) 2015, Benjamin Kaufmann
+//
+// This file is part of Clasp. See http://www.cs.uni-potsdam.de/clasp/
+//
+// Clasp is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Clasp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Clasp; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+//
+#include <clasp/linear_propagator.h>
+#include <clasp/solver.h>
+#include <algorithm>
+
+namespace Clasp {
+namespace {
+// floor(n/d) for d > 0
+inline wsum_t floorDiv(wsum_t n, wsum_t d) {
+	return n >= 0 ? n / d : -((-n + d - 1) / d);
+}
+}
+/////////////////////////////////////////////////////////////////////////////////////////
+// SharedLinearData
+/////////////////////////////////////////////////////////////////////////////////////////
+SharedLinearData::SharedLinearData() {
+	count_ = 1;
+	varBegin_.push_back(0);
+}
+SharedLinearData::~SharedLinearData() {}
+
+uint32 SharedLinearData::addVar(const weight_t* dom, const Literal* order, uint32 size) {
+	assert(size > 0);
+	values_.insert(values_.end(), dom, dom + size);
+	order_.insert(order_.end(), order, order + size);
+	varBegin_.push_back(static_cast<uint32>(values_.size()));
+	occurs_.push_back(VarVec());
+	return numVars() - 1;
+}
+
+void SharedLinearData::addConstraint(Literal head, const Term* first, const Term* last, weight_t bound) {
+	uint32 c = numConstraints();
+	uint32 b = static_cast<uint32>(terms_.size());
+	for (; first != last; ++first) {
+		if (first->coef == 0) { continue; }
+		assert(first->var < numVars());
+		terms_.push_back(*first);
+		VarVec& occ = occurs_[first->var];
+		if (occ.empty() || occ.back() != c) { occ.push_back(c); }
+	}
+	cons_.push_back(Con(head, bound, b, static_cast<uint32>(terms_.size())));
+}
+
+uint32 SharedLinearData::varOf(uint32 g) const {
+	return static_cast<uint32>(std::upper_bound(varBegin_.begin(), varBegin_.end(), g) - varBegin_.begin()) - 1;
+}
+/////////////////////////////////////////////////////////////////////////////////////////
+// LinearPropagator
+/////////////////////////////////////////////////////////////////////////////////////////
+LinearPropagator* LinearPropagator::create(Solver& s, SharedData* data) {
+	LinearPropagator* p = new LinearPropagator(data);
+	if (!p->init(s)) {
+		p->destroy(&s, true);
+		return 0;
+	}
+	return p;
+}
+
+LinearPropagator::LinearPropagator(SharedData* data) : data_(data->share()) { }
+LinearPropagator::~LinearPropagator() { }
+
+Constraint* LinearPropagator::cloneAttach(Solver& other) {
+	LinearPropagator* p = new LinearPropagator(data_);
+	if (!p->init(other)) { other.setStopConflict(); }
+	return p;
+}
+
+void LinearPropagator::destroy(Solver* s, bool detach) {
+	if (s && detach) {
+		for (uint32 x = 0, end = data_->numVars(); x != end; ++x) {
+			for (uint32 i = 1, n = data_->size(x); i < n; ++i) {
+				Literal o = data_->order(x, i);
+				if (o.var() != 0) {
+					s->removeWatch( o, this);
+					s->removeWatch(~o, this);
+				}
+			}
+		}
+		for (uint32 c = 0, end = data_->numConstraints(); c != end; ++c) {
+			Literal h = data_->constraint(c).head;
+			if (h.var() != 0) {
+				s->removeWatch( h, this);
+				s->removeWatch(~h, this);
+			}
+		}
+		for (LevelVec::const_iterator it = levels_.begin(), end = levels_.end(); it != end; ++it) {
+			s->removeUndoWatch(it->dl, this);
+		}
+	}
+	data_->release();
+	delete this;
+}
+
+bool LinearPropagator::init(Solver& s) {
+	// initial bounds
+	bounds_.resize(data_->numVars());
+	Var maxVar = 0;
+	for (uint32 x = 0, end = data_->numVars(); x != end; ++x) {
+		uint32 n = data_->size(x);
+		Bound  b(0, n - 1);
+		for (uint32 i = 1; i < n; ++i) {
+			Literal o = data_->order(x, i);
+			if (s.isFalse(o))                 { b.lo = std::max(b.lo, i); }
+			else if (s.isTrue(o) && b.hi >= i){ b.hi = i - 1; }
+			if (o.var() != 0) {
+				s.addWatch( o, this, data_->begin(x) + i);
+				s.addWatch(~o, this, data_->begin(x) + i);
+				maxVar = std::max(maxVar, o.var());
+			}
+		}
+		bounds_[x] = b;
+	}
+	for (uint32 c = 0, end = data_->numConstraints(); c != end; ++c) {
+		Literal h = data_->constraint(c).head;
+		if (h.var() != 0) {
+			s.addWatch( h, this, c | head_flag);
+			s.addWatch(~h, this, c | head_flag);
+			maxVar = std::max(maxVar, h.var());
+		}
+	}
+	s.requestData(maxVar);                 // order literals and heads can be implied more than once
+	// the order literals of a variable might contradict each other
+	for (uint32 x = 0, end = data_->numVars(); x != end; ++x) {
+		if (bounds_[x].lo > bounds_[x].hi) {
+			return s.force(data_->order(x, bounds_[x].lo), 0, Antecedent(data_->order(x, bounds_[x].hi + 1)));
+		}
+	}
+	for (uint32 c = 0, end = data_->numConstraints(); c != end; ++c) {
+		if (!propagateCon(s, c)) { return false; }
+	}
+	return true;
+}
+
+uint32 LinearPropagator::estimateComplexity(const Solver&) const {
+	return data_->numConstraints();
+}
+
+// Registers the current decision level for undo.
+void LinearPropagator::mark(Solver& s) {
+	uint32 dl = s.decisionLevel();
+	if (dl && (levels_.empty() || levels_.back().dl != dl)) {
+		levels_.push_back(Level(dl, static_cast<uint32>(undo_.size()), static_cast<uint32>(reasons_.size())));
+		s.addUndoWatch(dl, this);
+	}
+}
+
+void LinearPropagator::setBound(Solver& s, uint32 x, const Bound& b) {
+	mark(s);
+	if (s.decisionLevel()) { undo_.push_back(Undo(x, bounds_[x])); }
+	bounds_[x] = b;
+}
+
+void LinearPropagator::undoLevel(Solver&) {
+	assert(!levels_.empty());
+	const Level& l = levels_.back();
+	while (undo_.size() != l.undo) {
+		bounds_[undo_.back().var] = undo_.back().old;
+		undo_.pop_back();
+	}
+	shrinkVecTo(reasons_, l.reason);
+	levels_.pop_back();
+}
+
+Literal LinearPropagator::lowerLit(uint32 x) const {
+	return bounds_[x].lo > 0 ? ~data_->order(x, bounds_[x].lo) : posLit(0);
+}
+Literal LinearPropagator::upperLit(uint32 x) const {
+	return bounds_[x].hi + 1 < data_->size(x) ? data_->order(x, bounds_[x].hi + 1) : posLit(0);
+}
+
+Constraint::PropResult LinearPropagator::propagate(Solver& s, Literal p, uint32& data) {
+	if ((data & head_flag) != 0) {
+		return PropResult(propagateCon(s, data & ~uint32(head_flag)), true);
+	}
+	uint32 x = data_->varOf(data);
+	uint32 i = data - data_->begin(x);
+	Bound  b = bounds_[x];
+	if (p == data_->order(x, i)) {
+		// x < value(x, i)
+		if (i > b.hi) { return PropResult(true, true); }
+		b.hi = i - 1;
+		if (b.lo > b.hi) { return PropResult(s.force(data_->order(x, b.lo), Antecedent(p)), true); }
+	}
+	else {
+		// x >= value(x, i)
+		if (i <= b.lo) { return PropResult(true, true); }
+		b.lo = i;
+		if (b.lo > b.hi) { return PropResult(s.force(~data_->order(x, b.hi + 1), Antecedent(p)), true); }
+	}
+	setBound(s, x, b);
+	const VarVec& occ = data_->occurrences(x);
+	for (VarVec::const_iterator it = occ.begin(), end = occ.end(); it != end; ++it) {
+		if (!propagateCon(s, *it)) { return PropResult(false, true); }
+	}
+	return PropResult(true, true);
+}
+
+bool LinearPropagator::propagateCon(Solver& s, uint32 c) {
+	const SharedData::Con& con = data_->constraint(c);
+	wsum_t min = 0, max = 0;
+	for (const SharedData::Term* it = data_->termBegin(c), *end = data_->termEnd(c); it != end; ++it) {
+		wsum_t a = it->coef, l = lower(it->var), u = upper(it->var);
+		min += a * (a > 0 ? l : u);
+		max += a * (a > 0 ? u : l);
+	}
+	if (min > con.bound)  { if (!force(s, ~con.head, c,  1, UINT32_MAX, posLit(0))) { return false; } }
+	if (max <= con.bound) { if (!force(s,  con.head, c, -1, UINT32_MAX, posLit(0))) { return false; } }
+	if (s.isTrue(con.head))  { return tighten(s, c,  1, con.bound, min, con.head); }
+	if (s.isFalse(con.head)) { return tighten(s, c, -1, -wsum_t(con.bound) - 1, -max, ~con.head); }
+	return true;
+}
+
+// Tightens the bounds of the variables in sign*sum(terms) <= bound given that
+// min is the smallest value of the left hand side and h holds.
+bool LinearPropagator::tighten(Solver& s, uint32 c, int sign, wsum_t bound, wsum_t min, Literal h) {
+	const SharedData::Term* first = data_->termBegin(c);
+	for (const SharedData::Term* it = first, *end = data_->termEnd(c); it != end; ++it) {
+		uint32 x     = it->var;
+		wsum_t a     = wsum_t(sign) * it->coef;
+		wsum_t slack = bound - (min - a * (a > 0 ? lower(x) : upper(x)));
+		const weight_t* dom = data_->domain(x), *domEnd = dom + data_->size(x);
+		if (a > 0) {
+			// x <= floor(slack/a)
+			wsum_t u = floorDiv(slack, a);
+			if (u < upper(x)) {
+				uint32 j = static_cast<uint32>(std::upper_bound(dom, domEnd, u) - dom);
+				if (j == 0 || !force(s, data_->order(x, j), c, sign, static_cast<uint32>(it - first), h)) { return false; }
+			}
+		}
+		else {
+			// x >= ceil(slack/a)
+			wsum_t l = -floorDiv(slack, -a);
+			if (l > lower(x)) {
+				uint32 j = static_cast<uint32>(std::lower_bound(dom, domEnd, l) - dom);
+				if (j == data_->size(x) || !force(s, ~data_->order(x, j), c, sign, static_cast<uint32>(it - first), h)) { return false; }
+			}
+		}
+	}
+	return true;
+}
+
+// Forces p with reason h plus the literals establishing the smallest value of
+// sign*term for all terms of c except the one at index skip.
+bool LinearPropagator::force(Solver& s, Literal p, uint32 c, int sign, uint32 skip, Literal h) {
+	if (s.isTrue(p)) { return true; }
+	mark(s);
+	uint32 start = static_cast<uint32>(reasons_.size());
+	reasons_.push_back(Literal::fromRep(0));
+	if (h.var() != 0) { reasons_.push_back(h); }
+	const SharedData::Term* first = data_->termBegin(c);
+	for (const SharedData::Term* it = first, *end = data_->termEnd(c); it != end; ++it) {
+		if (static_cast<uint32>(it - first) == skip) { continue; }
+		Literal x = (sign * it->coef > 0) ? lowerLit(it->var) : upperLit(it->var);
+		if (x.var() != 0) { reasons_.push_back(x); }
+	}
+	reasons_[start] = Literal::fromRep(static_cast<uint32>(reasons_.size()) - start - 1);
+	return s.force(p, this, start);
+}
+
+void LinearPropagator::reason(Solver& s, Literal p, LitVec& lits) {
+	uint32 start = s.reasonData(p);
+	assert(start < reasons_.size());
+	const Literal* it = &reasons_[start] + 1;
+	lits.insert(lits.end(), it, it + reasons_[start].asUint());
+}
+
+}
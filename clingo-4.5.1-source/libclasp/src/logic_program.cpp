@@ -21,14 +21,18 @@
 #include <clasp/shared_context.h>
 #include <clasp/solver.h>
 #include <clasp/minimize_constraint.h>
+#include <clasp/linear_propagator.h>
+#include <clasp/weight_constraint.h>
 #include <clasp/util/misc_types.h>
 #include <clasp/asp_preprocessor.h>
 #include <clasp/clause.h>
 #include <clasp/dependency_graph.h>
 #include <clasp/parser.h>
+#include <clasp/util/timer.h>
 #include <stdexcept>
 #include <sstream>
 #include <climits>
+#include <algorithm>
 namespace Clasp { namespace Asp {
 /////////////////////////////////////////////////////////////////////////////////////////
 // class LpStats
@@ -42,6 +46,8 @@ namespace Clasp { namespace Asp {
 	APPLY("gammas"              , gammas)                        \
 	APPLY("ufs_nodes"           , ufsNodes)                      \
 	APPLY("rules"               , rules())                       \
+	APPLY("rules_dup"           , dupRules)                      \
+	APPLY("prepro_time"         , prepTime)                      \
 	APPLY("rules_basic"         , rules(BASICRULE).first)        \
 	APPLY("rules_choice"        , rules(CHOICERULE).first)       \
 	APPLY("rules_constraint"    , rules(CONSTRAINTRULE).first)   \
@@ -72,6 +78,8 @@ void LpStats::accu(const LpStats& o) {
 	atoms    += o.atoms;
 	auxAtoms += o.auxAtoms;
 	ufsNodes += o.ufsNodes;
+	dupRules += o.dupRules;
+	prepTime += o.prepTime;
 	if (sccs == PrgNode::noScc || o.sccs == PrgNode::noScc) {
 		sccs    = o.sccs;
 		nonHcfs = o.nonHcfs;
@@ -127,7 +135,7 @@ bool toConstraint(NT* node, const LogicProgram& prg, ClauseCreator& c) {
 	return !node->relevant() || node->addConstraints(prg, c);
 }
 }
-LogicProgram::LogicProgram() : nonHcfCfg_(0), minimize_(0), incData_(0), startAux_(0) { accu = 0; }
+LogicProgram::LogicProgram() : nonHcfCfg_(0), minimize_(0), linear_(0), incData_(0), startAux_(0) { accu = 0; }
 LogicProgram::~LogicProgram() { dispose(true); }
 LogicProgram::Incremental::Incremental() : startAtom(1), startScc(0) {}
 void LogicProgram::dispose(bool force) {
@@ -145,6 +153,12 @@ void LogicProgram::dispose(bool force) {
 		delete t;
 	}
 	minimize_ = 0;
+	if (linear_) {
+		linear_->release();
+		linear_ = 0;
+	}
+	std::for_each(sums_.begin(), sums_.end(), DeleteObject());
+	sums_.clear();
 	for (RuleList::size_type i = 0; i != extended_.size(); ++i) {
 		delete extended_[i];
 	}
@@ -152,8 +166,11 @@ void LogicProgram::dispose(bool force) {
 	VarVec().swap(initialSupp_);
 	rule_.clear();
 	if (force || !incData_) {
-		std::for_each( atoms_.begin(), atoms_.end(), DeleteObject() );
+		for (AtomList::const_iterator it = atoms_.begin(), end = atoms_.end(); it != end; ++it) {
+			atomAlloc_.destroy(*it);
+		}
 		AtomList().swap(atoms_);
+		atomAlloc_.release();
 		delete incData_;
 		VarVec().swap(propQ_);
 		ruleState_.clearAll();
@@ -163,6 +180,14 @@ void LogicProgram::dispose(bool force) {
 	else {
 		// make sure that we have a reference to any minimize constraint
 		getMinimizeConstraint();
+		// supports and dependencies of atoms from this step are only needed
+		// while the program is prepared - release their memory
+		for (VarIter it = frontier_begin(), end = frontier_end(); it != end; ++it) {
+			atoms_[*it]->releaseEdges();
+		}
+		for (AtomList::size_type i = startAtom(); i < atoms_.size(); ++i) {
+			atoms_[i]->releaseEdges();
+		}
 	}
 	activeHead_.clear();
 	activeBody_.reset();
@@ -170,7 +195,7 @@ void LogicProgram::dispose(bool force) {
 bool LogicProgram::doStartProgram() {
 	dispose(true);
 	// atom 0 is always false
-	atoms_.push_back( new PrgAtom(0, false) );
+	atoms_.push_back( atomAlloc_.create(0, false) );
 	assignValue(getAtom(0), value_false);
 	getFalseAtom()->setLiteral(negLit(0));
 	nonHcfCfg_= 0;
@@ -203,11 +228,22 @@ bool LogicProgram::doUpdateProgram() {
 	incData_->update.clear();
 	incData_->frozen.swap(incData_->update);
 	ctx()->symbolTable().startInit(SymbolTable::map_indirect);
-	// reset prop queue and add supported atoms from previous steps 
-	// {ai | ai in P}.
-	PrgBody* support = startAux_ > 1 ? getBodyFor(activeBody_) : 0;
+	// reset prop queue and create the body supporting atoms from previous steps
+	// {ai | ai in P} - atoms used in this step are added in updateFrozenAtoms().
+	if (startAux_ > 1) { getBodyFor(activeBody_); }
 	propQ_.assign(1, getFalseId());
-	for (Var i = 1, end = startAux_; i != end; ++i) {
+	// only atoms added or used in the last step and frozen atoms may
+	// have changed - all other atoms from previous steps are still clean
+	VarVec& front = incData_->frontier;
+	for (VarVec::const_iterator it = front.begin(), end = front.end(); it != end; ++it) {
+		incData_->used[*it] = 0;
+	}
+	front.insert(front.end(), incData_->update.begin(), incData_->update.end());
+	for (Var i = incData_->startAtom; i != startAux_; ++i) { front.push_back(i); }
+	std::sort(front.begin(), front.end());
+	front.erase(std::unique(front.begin(), front.end()), front.end());
+	for (VarVec::const_iterator it = front.begin(), end = front.end(); it != end; ++it) {
+		Var i = *it;
 		if (getEqAtom(i) >= startAux_) {
 			// atom is equivalent to some aux atom - make i the new root
 			uint32 r = getEqAtom(i);
@@ -220,35 +256,40 @@ bool LogicProgram::doUpdateProgram() {
 		a->clearDeps(PrgAtom::dep_all);
 		a->setIgnoreScc(false);
 		if (a->relevant() || a->frozen()) {
-			ValueRep v = a->value();
-			a->setValue(value_free);
 			a->resetId(i, !a->frozen());
-			if (ctx()->master()->value(a->var()) != value_free && !a->frozen()) {
-				v = ctx()->master()->isTrue(a->literal()) ? value_true : value_false;
-			}
-			if (v != value_free) { assignValue(a, v); }
-			if (!a->frozen() && a->value() != value_false) {
-				a->setIgnoreScc(true);
-				support->addHead(a, PrgEdge::CHOICE_EDGE);
+			if (a->frozen()) {
+				ValueRep v = a->value();
+				a->setValue(value_free);
+				if (v != value_free) { assignValue(a, v); }
 			}
+			// else: value of a is updated once it is used again - see useAtom()
 		}
 		else if (a->removed() || (!a->eq() && a->value() == value_false)) {
 			a->setEq(getFalseId());
 		}
 	}
+	front.clear();
 	// delete any introduced aux atoms
 	// this is safe because aux atoms are never part of the input program
 	// it is necessary in order to free their ids, i.e. the id of an aux atom
 	// from step I might be needed for a program atom in step I+1
-	std::for_each(atoms_.begin()+startAux_, atoms_.end(), DeleteObject());
+	for (AtomList::const_iterator it = atoms_.begin()+startAux_, end = atoms_.end(); it != end; ++it) {
+		atomAlloc_.destroy(*it);
+	}
 	atoms_.erase(atoms_.begin()+startAux_, atoms_.end());
 	incData_->startAtom = startAux_ = (uint32)atoms_.size();
+	incData_->used.resize(startAux_, 0);
+	for (VarVec::const_iterator it = incData_->update.begin(), end = incData_->update.end(); it != end; ++it) {
+		useAtom(*it);
+	}
 	stats.reset();
 	return true;
 }
 bool LogicProgram::doEndProgram() {
 	if (!frozen() && ctx()->ok()) {
+		stats.prepTime = RealTime::getTime();
 		prepareProgram(!opts_.noSCC);
+		stats.prepTime = RealTime::getTime() - stats.prepTime;
 		addConstraints();
 		if (accu) { accu->accu(stats); }
 	}
@@ -391,7 +432,7 @@ RedefinitionError::RedefinitionError(unsigned atomId, const char* name) : std::l
 Var LogicProgram::newAtom() {
 	check_not_frozen();
 	Var id = static_cast<Var>(atoms_.size());
-	atoms_.push_back( new PrgAtom(id) );
+	atoms_.push_back( atomAlloc_.create(id) );
 	return id;
 }
 
@@ -478,6 +519,46 @@ LogicProgram& LogicProgram::addRule(const Rule& r) {
 	activeBody_.reset();
 	return *this;
 }
+uint32 LogicProgram::addOrderVar(const WeightVec& values, const VarVec& atoms) {
+	check_not_frozen();
+	CLASP_ASSERT_CONTRACT(!values.empty() && values.size() == atoms.size());
+	LitVec order;
+	order.reserve(atoms.size());
+	for (VarVec::const_iterator it = atoms.begin(), end = atoms.end(); it != end; ++it) {
+		if (it != atoms.begin()) { resize(*it); }
+		order.push_back(posLit(it != atoms.begin() ? *it : 0));
+	}
+	if (!linear_) { linear_ = new SharedLinearData(); }
+	return linear_->addVar(&values[0], &order[0], static_cast<uint32>(order.size()));
+}
+
+LogicProgram& LogicProgram::addLinearConstraint(Var head, const WeightVec& coefs, const VarVec& vars, weight_t bound) {
+	check_not_frozen();
+	CLASP_ASSERT_CONTRACT(linear_ || vars.empty());
+	CLASP_ASSERT_CONTRACT(coefs.size() == vars.size());
+	if (!linear_) { linear_ = new SharedLinearData(); }
+	resize(head);
+	SharedLinearData::TermVec terms;
+	for (VarVec::size_type i = 0; i != vars.size(); ++i) {
+		CLASP_ASSERT_CONTRACT(vars[i] < linear_->numVars());
+		terms.push_back(SharedLinearData::Term(coefs[i], vars[i]));
+	}
+	linear_->addConstraint(posLit(head), terms.begin(), terms.end(), bound);
+	return *this;
+}
+struct LogicProgram::SumConstraint {
+	SumConstraint(Var h, const WeightLitVec& l, weight_t b) : lits(l), head(h), bound(b) {}
+	WeightLitVec lits;
+	Var          head;
+	weight_t     bound;
+};
+LogicProgram& LogicProgram::addSumConstraint(Var head, const WeightLitVec& lits, weight_t bound) {
+	check_not_frozen();
+	resize(head);
+	for (WeightLitVec::const_iterator it = lits.begin(), end = lits.end(); it != end; ++it) { resize(it->first.var()); }
+	sums_.push_back(new SumConstraint(head, lits, bound));
+	return *this;
+}
 #undef check_not_frozen
 /////////////////////////////////////////////////////////////////////////////////////////
 // Query functions
@@ -562,6 +643,10 @@ bool LogicProgram::handleNatively(RuleType r, const BodyInfo& body) const {
 		return (r != CONSTRAINTRULE && r != WEIGHTRULE)
 			|| transformNoAux(r, body) == false;
 	}
+	else if (m == mode_transform_large) {
+		return (r != CONSTRAINTRULE && r != WEIGHTRULE)
+			|| transformNet(r, body) == false;
+	}
 	else if (m == mode_transform_choice) {
 		return r != CHOICERULE;
 	}
@@ -579,13 +664,21 @@ bool LogicProgram::transformNoAux(RuleType r, const BodyInfo& body) const {
 	return r != CHOICERULE && (body.bound() == 1 || (body.size() <= 6 && choose(body.size(), body.bound()) <= 15));
 }
 
+// Large rules are encoded as sorting networks unless
+// weights would blow up the number of network inputs.
+bool LogicProgram::transformNet(RuleType r, const BodyInfo& body) const {
+	if (body.size() < 32 || body.bound() <= 1) { return false; }
+	return r == CONSTRAINTRULE || (r == WEIGHTRULE && body.sum() <= weight_t(4*body.size()));
+}
+
 void LogicProgram::transformExtended() {
 	// remember starting position of aux atoms so
 	// that we can remove them on next incremental step
 	uint32 a  = numAtoms();
 	RuleTransform tm;
+	bool net = opts_.erMode == mode_transform_large;
 	for (RuleList::size_type i = 0; i != extended_.size(); ++i) {
-		incTr(extended_[i]->type(), tm.transform(*this, *extended_[i]));
+		incTr(extended_[i]->type(), net ? tm.transformNet(*this, *extended_[i]) : tm.transform(*this, *extended_[i]));
 		delete extended_[i];
 	}
 	extended_.clear();
@@ -659,6 +752,15 @@ void LogicProgram::updateFrozenAtoms() {
 	activeHead_.clear();
  	activeBody_.reset();
 	PrgBody* support   = 0;
+	for (VarIter it = frontier_begin(), end = frontier_end(); it != end; ++it) {
+		PrgAtom* a = getAtom(*it);
+		if (a->relevant() && !a->frozen() && a->value() != value_false) {
+			// atom from previous step that is used in this step - add support
+			if (!support) { support = getBodyFor(activeBody_); }
+			a->setIgnoreScc(true);
+			support->addHead(a, PrgEdge::CHOICE_EDGE);
+		}
+	}
 	VarVec::iterator j = incData_->update.begin();
 	for (VarVec::iterator it = j, end = incData_->update.end(); it != end; ++it) {
 		Var id     = getEqAtom(*it);
@@ -717,7 +819,10 @@ void LogicProgram::prepareProgram(bool checkSccs) {
 			for (uint32 i = 0; i != bodies_.size(); ++i) {
 				if (getBody(i)->relevant()) { getBody(i)->resetId(i, true); }
 			}
-			for (uint32 i = 0; i != atoms_.size(); ++i) {
+			for (VarIter it = frontier_begin(), end = frontier_end(); it != end; ++it) {
+				if (getAtom(*it)->relevant()) { getAtom(*it)->resetId(*it, true); }
+			}
+			for (uint32 i = startAtom(); i != atoms_.size(); ++i) {
 				if (getAtom(i)->relevant()) { getAtom(i)->resetId(i, true); }
 			}
 		}
@@ -794,6 +899,11 @@ void LogicProgram::finalizeDisjunctions(Preprocessor& p, uint32 numSccs) {
 				RuleType t = simplifyRule(rule_, activeHead_, activeBody_);
 				PrgBody* B = t != ENDRULE ? assignBodyFor(activeBody_, PrgEdge::NORMAL_EDGE, true) : 0;
 				if (!B || B->value() == value_false) { continue; }
+				if (t == BASICRULE && activeHead_[0] == 0) {
+					// all atoms blocked - integrity constraint; no support edge for the false atom
+					if (!B->assignValue(value_false)) { setConflict(); }
+					continue;
+				}
 				if (t == BASICRULE) {
 					++shifted;
 					B->addHead(getAtom(activeHead_[0]), PrgEdge::NORMAL_EDGE);
@@ -817,7 +927,7 @@ void LogicProgram::finalizeDisjunctions(Preprocessor& p, uint32 numSccs) {
 						for (uint32 i = x->size();;) {
 							t = simplifyRule(rule_, activeHead_, activeBody_);
 							B = t != ENDRULE ? assignBodyFor(activeBody_, PrgEdge::GAMMA_EDGE, true) : 0;
-							if (B && B->value() != value_false && !B->hasHead(getAtom(activeHead_[0]), PrgEdge::NORMAL_EDGE)) {
+							if (B && B->value() != value_false && activeHead_[0] != 0 && !B->hasHead(getAtom(activeHead_[0]), PrgEdge::NORMAL_EDGE)) {
 								B->addHead(getAtom(activeHead_[0]), PrgEdge::GAMMA_EDGE);
 								++stats.gammas;
 							}
@@ -979,8 +1089,46 @@ bool LogicProgram::addConstraints() {
 		stats.ufsNodes  = ctx()->sccGraph->nodes()-oldNodes;
 		sccAtoms_.clear();
 	}
+	return (!linear_ || addLinearConstraints()) && addSumConstraints();
+}
+
+// map the sum constraints of this step to weight constraints
+bool LogicProgram::addSumConstraints() {
+	WeightLitVec lits;
+	for (SumList::const_iterator it = sums_.begin(), end = sums_.end(); it != end; ++it) {
+		const SumConstraint& c = **it;
+		lits.clear();
+		for (WeightLitVec::const_iterator x = c.lits.begin(), xEnd = c.lits.end(); x != xEnd; ++x) {
+			lits.push_back(WeightLiteral(getLiteral(x->first.var()) ^ x->first.sign(), x->second));
+		}
+		if (!WeightConstraint::create(*ctx()->master(), getLiteral(c.head), lits, c.bound).ok()) { return false; }
+	}
 	return true;
 }
+
+// map the linear constraints of this step to solver literals
+bool LogicProgram::addLinearConstraints() {
+	SharedLinearData* data = new SharedLinearData();
+	LitVec order;
+	for (uint32 x = 0, end = linear_->numVars(); x != end; ++x) {
+		order.clear();
+		for (uint32 i = 0, n = linear_->size(x); i != n; ++i) {
+			Literal o = i != 0 ? getLiteral(linear_->order(x, i).var()) : posLit(0);
+			if (o.var() != 0) { ctx()->setFrozen(o.var(), true); }
+			order.push_back(o);
+		}
+		data->addVar(linear_->domain(x), &order[0], linear_->size(x));
+	}
+	for (uint32 c = 0, end = linear_->numConstraints(); c != end; ++c) {
+		Literal h = getLiteral(linear_->constraint(c).head.var());
+		if (h.var() != 0) { ctx()->setFrozen(h.var(), true); }
+		data->addConstraint(h, linear_->termBegin(c), linear_->termEnd(c), linear_->constraint(c).bound);
+	}
+	LinearPropagator* p = LinearPropagator::create(*ctx()->master(), data);
+	data->release();
+	if (p) { ctx()->add(p); }
+	return p != 0;
+}
 #undef check_modular
 /////////////////////////////////////////////////////////////////////////////////////////
 // misc/helper functions
@@ -989,7 +1137,26 @@ PrgAtom* LogicProgram::resize(Var atomId) {
 	while (atoms_.size() <= AtomList::size_type(atomId)) {
 		newAtom();
 	}
-	return atoms_[getEqAtom(atomId)];
+	Var id = getEqAtom(atomId);
+	if (!isNew(id) && !frozen() && ctx()->ok()) { useAtom(id); }
+	return atoms_[id];
+}
+
+// Adds the atom atomId from a previous step to the frontier of the current step.
+// Unless the atom is frozen, its value is updated w.r.t the master solver.
+void LogicProgram::useAtom(Var atomId) {
+	if (atomId == 0 || incData_->used[atomId]) { return; }
+	incData_->used[atomId] = 1;
+	incData_->frontier.push_back(atomId);
+	PrgAtom* a = atoms_[atomId];
+	if (a->relevant() && !a->frozen()) {
+		ValueRep v = a->value();
+		a->setValue(value_free);
+		if (ctx()->master()->value(a->var()) != value_free) {
+			v = ctx()->master()->isTrue(a->literal()) ? value_true : value_false;
+		}
+		if (v != value_free) { assignValue(a, v); }
+	}
 }
 
 bool LogicProgram::propagate(bool backprop) {
@@ -1162,6 +1329,11 @@ RuleType LogicProgram::simplifyRule(const Rule& r, VarVec& head, BodyInfo& body)
 		else if (type == DISJUNCTIVERULE && head.size() == 1) {
 			type = BASICRULE;
 		}
+		else if (head.empty() && blocked) {
+			// all atoms of the disjunction are blocked
+			head.push_back(0);
+			type = BASICRULE;
+		}
 		else if (head.empty()) {
 			type = ENDRULE;
 		}
@@ -1195,7 +1367,8 @@ Literal LogicProgram::getEqAtomLit(Literal lit, const BodyList& supports, Prepro
 				if (aScc != PrgNode::noScc && (sccMap[aScc] & 1u)) { scc = aScc; }
 			}
 			b->addHead(aux, PrgEdge::NORMAL_EDGE);
-			if (b->value() != aux->value()) { assignValue(aux, b->value()); }
+			// aux is true if any of its supports is true - a free support must not reset it
+			if (b->value() != value_free && b->value() != aux->value()) { assignValue(aux, b->value()); }
 			aux->setInUpper(true);
 		}
 	}
@@ -1211,14 +1384,14 @@ Literal LogicProgram::getEqAtomLit(Literal lit, const BodyList& supports, Prepro
 }
 
 PrgBody* LogicProgram::getBodyFor(BodyInfo& body, bool addDeps) {
-	uint32 bodyId = equalBody(bodyIndex_.equal_range(body.hash), body);
+	uint32 bodyId = equalBody(bodyIndex_.equalRange(body.hash), body);
 	if (bodyId != varMax) {
 		return getBody(bodyId);
 	}
 	// no corresponding body exists, create a new object
 	bodyId        = (uint32)bodies_.size();
 	PrgBody* b    = PrgBody::create(*this, bodyId, body, addDeps);
-	bodyIndex_.insert(IndexMap::value_type(body.hash, bodyId));
+	bodyIndex_.insert(body.hash, bodyId);
 	bodies_.push_back(b);
 	if (b->isSupported()) {
 		initialSupp_.push_back(bodyId);
@@ -1250,14 +1423,14 @@ PrgBody* LogicProgram::assignBodyFor(BodyInfo& body, EdgeType depEdge, bool simp
 	return b;
 }
 
-uint32 LogicProgram::equalBody(const IndexRange& range, BodyInfo& body) const {
+uint32 LogicProgram::equalBody(IndexRange range, BodyInfo& body) const {
 	bool sorted = false;
-	for (IndexIter it = range.first; it != range.second; ++it) {
-		PrgBody& o = *bodies_[it->second];
+	for (; !range.empty(); range.popFront()) {
+		PrgBody& o = *bodies_[range.front()];
 		if (o.type() == body.type() && o.size() == body.size() && o.bound() == body.bound() && (body.posSize() == 0u || o.goal(body.posSize()-1).sign() == false)) {
 			// bodies are structurally equivalent - check if they contain the same literals
 			if ((o.relevant() || (o.eq() && getBody(o.id())->relevant())) && o.eqLits(body.lits, sorted)) {
-				assert(o.id() == it->second || o.eq());
+				assert(o.id() == range.front() || o.eq());
 				return o.id();
 			}
 		}
@@ -1265,9 +1438,9 @@ uint32 LogicProgram::equalBody(const IndexRange& range, BodyInfo& body) const {
 	return varMax;
 }
 uint32 LogicProgram::findEqBody(PrgBody* b, uint32 hash) {
-	LogicProgram::IndexRange eqRange = bodyIndex_.equal_range(hash);
+	LogicProgram::IndexRange eqRange = bodyIndex_.equalRange(hash);
 	// check for existing body
-	if (eqRange.first != eqRange.second) {
+	if (!eqRange.empty()) {
 		activeBody_.reset();
 		WeightLitVec& lits = activeBody_.lits;
 		uint32 p = 0;
@@ -1284,11 +1457,10 @@ uint32 LogicProgram::findEqBody(PrgBody* b, uint32 hash) {
 PrgDisj* LogicProgram::getDisjFor(const VarVec& heads, uint32 headHash) {
 	PrgDisj* d = 0;
 	if (headHash) {
-		LogicProgram::IndexRange eqRange = disjIndex_.equal_range(headHash);
-		for (; eqRange.first != eqRange.second; ++eqRange.first) {
-			PrgDisj& o = *disjunctions_[eqRange.first->second];
+		for (LogicProgram::IndexRange eqRange = disjIndex_.equalRange(headHash); !eqRange.empty(); eqRange.popFront()) {
+			PrgDisj& o = *disjunctions_[eqRange.front()];
 			if (o.relevant() && o.size() == heads.size() && ruleState_.allMarked(o.begin(), o.end(), RuleState::head_flag)) {
-				assert(o.id() == eqRange.first->second);
+				assert(o.id() == eqRange.front());
 				d = &o;
 				break;
 			}
@@ -1308,7 +1480,7 @@ PrgDisj* LogicProgram::getDisjFor(const VarVec& heads, uint32 headHash) {
 			getAtom(*it)->addSupport(edge);
 		}
 		if (headHash) {
-			disjIndex_.insert(IndexMap::value_type(headHash, d->id()));
+			disjIndex_.insert(headHash, d->id());
 		}
 	}
 	return d;
@@ -1322,7 +1494,7 @@ uint32 LogicProgram::update(PrgBody* body, uint32 oldHash, uint32 newHash) {
 		if (eqId == varMax) {
 			// No equivalent body found. 
 			// Add new entry to index
-			bodyIndex_.insert(IndexMap::value_type(newHash, id));
+			bodyIndex_.insert(newHash, id);
 		}
 		return eqId;
 	}
@@ -1331,12 +1503,11 @@ uint32 LogicProgram::update(PrgBody* body, uint32 oldHash, uint32 newHash) {
 
 // body b has changed - remove old entry from body node index
 uint32 LogicProgram::removeBody(PrgBody* b, uint32 hash) {
-	IndexRange ra = bodyIndex_.equal_range(hash);
-	uint32 id     = b->id();
-	for (; ra.first != ra.second; ++ra.first) {
-		if (bodies_[ra.first->second] == b) {
-			id = ra.first->second;
-			bodyIndex_.erase(ra.first);
+	uint32 id = b->id();
+	for (IndexRange ra = bodyIndex_.equalRange(hash); !ra.empty(); ra.popFront()) {
+		if (bodies_[ra.front()] == b) {
+			id = ra.front();
+			bodyIndex_.erase(ra);
 			break;
 		}
 	}
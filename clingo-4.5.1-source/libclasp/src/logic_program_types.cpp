@@ -28,6 +28,7 @@
 #include <clasp/util/misc_types.h>
 
 #include <deque>
+#include <new>
 
 namespace Clasp { namespace Asp {
 
@@ -311,6 +312,94 @@ uint32 RuleTransform::transformNoAux(ProgramAdapter& prg, Rule& rule) {
 	return newRules;
 }
 
+// Transformation of cardinality and weight constraint into a sorting network.
+// Body literals are repeated according to their (reduced) weights and sorted 
+// in descending order by Batcher's odd-even merge sort. A comparator of x and y
+// is given by the rules:
+// max :- x.
+// max :- y.
+// min :- x, y.
+// The rule h = k {...} is then replaced with h :- out_k, where out_k is the k-th
+// output of the network. Comparators that do not contribute to out_k are skipped
+// and padding inputs are propagated, hence the number of new rules is in 
+// O(n*log^2(n)) for n inputs compared to O(n*k) for the quadratic transformation.
+uint32 RuleTransform::transformNet(ProgramAdapter& prg, Rule& rule) {
+	if (rule.type() != CONSTRAINTRULE && rule.type() != WEIGHTRULE) {
+		return transform(prg, rule);
+	}
+	WeightVec sumWeights(rule.body.size() + 1, 0);
+	weight_t  sum = prepareRule(rule, &sumWeights[0]);
+	if (rule.bound() > sum) { return 0; }
+	Rule r(BASICRULE);
+	r.addHead(rule.heads[0]);
+	if (rule.bound() <= 0)  { prg.addRule(r); return 1; }
+	weight_t g = 0;
+	for (WeightLitVec::const_iterator it = rule.body.begin(), end = rule.body.end(); it != end; ++it) {
+		for (weight_t w = it->second; w; ) { weight_t t = g % w; g = w; w = t; }
+	}
+	// inputs of network - padded with false literals (i.e. var 0)
+	LitVec wire;
+	for (WeightLitVec::const_iterator it = rule.body.begin(), end = rule.body.end(); it != end; ++it) {
+		wire.insert(wire.end(), it->second / g, it->first);
+	}
+	uint32 k    = static_cast<uint32>((rule.bound() + (g-1)) / g);
+	uint32 size = 1;
+	while (size < wire.size()) { size <<= 1; }
+	wire.resize(size, posLit(0));
+	// comparators (i,j) with i < j storing the max in i
+	VarVec comp;
+	for (uint32 p = 1; p < size; p <<= 1) {
+		for (uint32 d = p; d > 0; d >>= 1) {
+			for (uint32 j = d % p; j + d < size; j += 2*d) {
+				for (uint32 i = j; i != j + d && i + d < size; ++i) {
+					if (i / (2*p) == (i+d) / (2*p)) {
+						comp.push_back(i);
+						comp.push_back(i+d);
+					}
+				}
+			}
+		}
+	}
+	// backward pass: mark comparator outputs needed to compute out_k
+	PodVector<uint8>::type live(size, 0), need(comp.size(), 0);
+	live[k-1] = 1;
+	for (uint32 c = static_cast<uint32>(comp.size()); c; ) {
+		c -= 2;
+		need[c]   = live[comp[c]];
+		need[c+1] = live[comp[c+1]];
+		live[comp[c]] = live[comp[c+1]] = (need[c] | need[c+1]);
+	}
+	// forward pass: create rules for needed outputs
+	uint32 newRules = 0;
+	for (uint32 c = 0; c != comp.size(); c += 2) {
+		Literal x = wire[comp[c]], y = wire[comp[c+1]];
+		if (y.var() == 0 || x == y) { continue; }
+		if (x.var() == 0) { std::swap(wire[comp[c]], wire[comp[c+1]]); continue; }
+		Rule aux(BASICRULE);
+		if (need[c]) {
+			wire[comp[c]] = posLit(prg.newAtom());
+			aux.addHead(wire[comp[c]].var()).addToBody(x.var(), !x.sign());
+			prg.addRule(aux);
+			aux.body.clear();
+			aux.addToBody(y.var(), !y.sign());
+			prg.addRule(aux);
+			newRules += 2;
+		}
+		if (need[c+1]) {
+			wire[comp[c+1]] = posLit(prg.newAtom());
+			aux.heads.assign(1, wire[comp[c+1]].var());
+			aux.body.clear();
+			aux.addToBody(x.var(), !x.sign()).addToBody(y.var(), !y.sign());
+			prg.addRule(aux);
+			++newRules;
+		}
+	}
+	assert(wire[k-1].var() != 0);
+	r.addToBody(wire[k-1].var(), !wire[k-1].sign());
+	prg.addRule(r);
+	return newRules + 1;
+}
+
 // A choice rule {h1,...hn} :- BODY
 // is replaced with:
 // h1   :- BODY, not aux1.
@@ -386,14 +475,68 @@ uint32 RuleTransform::transformDisjunctiveRule(ProgramAdapter& prg, Rule& rule)
 	return newRules;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+// class NodeIndex
+//
+// Open addressing with linear probing. Erased entries are marked dead
+// and removed once the table is rebuilt.
+/////////////////////////////////////////////////////////////////////////////////////////
+uint32 NodeIndex::find(uint32 h, uint32 pos) const {
+	for (pos &= mask(); tab_[pos].id != emptyId; pos = (pos + 1) & mask()) {
+		if (tab_[pos].hash == h && tab_[pos].id != deadId) { return pos; }
+	}
+	return noPos;
+}
+
+void NodeIndex::insert(uint32 h, uint32 id) {
+	assert(id < deadId);
+	if ((used_ + dead_ + 1) * 4 > tab_.size() * 3) {
+		uint32 cap = 16;
+		while ((used_ + 1) * 2 > cap) { cap *= 2; }
+		rehash(cap);
+	}
+	uint32 pos = slot(h);
+	while (tab_[pos].id < deadId) { pos = (pos + 1) & mask(); }
+	dead_ -= tab_[pos].id == deadId;
+	tab_[pos].hash = h;
+	tab_[pos].id   = id;
+	++used_;
+}
+
+void NodeIndex::erase(const Range& r) {
+	assert(r.index_ == this && !r.empty());
+	tab_[r.pos_].id = deadId;
+	--used_;
+	++dead_;
+}
+
+void NodeIndex::clear() {
+	EntryVec().swap(tab_);
+	used_ = dead_ = 0;
+}
+
+void NodeIndex::rehash(uint32 cap) {
+	EntryVec temp;
+	temp.swap(tab_);
+	Entry empty = {0, emptyId};
+	tab_.resize(cap, empty);
+	used_ = dead_ = 0;
+	for (EntryVec::const_iterator it = temp.begin(), end = temp.end(); it != end; ++it) {
+		if (it->id < deadId) { insert(it->hash, it->id); }
+	}
+}
 /////////////////////////////////////////////////////////////////////////////////////////
 // class SccChecker
-// 
+//
 // SCC/cycle checking
 /////////////////////////////////////////////////////////////////////////////////////////
 SccChecker::SccChecker(LogicProgram& prg, AtomList& sccAtoms, uint32 startScc)
 	: prg_(&prg), sccAtoms_(&sccAtoms), count_(0), sccs_(startScc) {
-	for (uint32 i = 0; i != prg.numAtoms(); ++i) {
+	// atoms from previous steps are only relevant if they are used in this step
+	for (LogicProgram::VarIter it = prg.frontier_begin(), end = prg.frontier_end(); it != end; ++it) {
+		visit(prg.getAtom(*it));
+	}
+	for (uint32 i = prg.startAtom(); i < prg.numAtoms(); ++i) {
 		visit(prg.getAtom(i));
 	}
 	for (uint32 i = 0; i != prg.numBodies(); ++i) {
@@ -1466,5 +1609,43 @@ bool PrgDisj::propagateAssigned(LogicProgram& prg, PrgHead* head, EdgeType t) {
 	}
 	return true;
 }
+/////////////////////////////////////////////////////////////////////////////////////////
+// class AtomAlloc
+/////////////////////////////////////////////////////////////////////////////////////////
+PrgAtom* AtomAlloc::create(uint32 id, bool checkScc) {
+	if (freeList_ == 0) {
+		allocBlock();
+	}
+	Chunk* r  = freeList_;
+	freeList_ = r->next;
+	return new (r->mem) PrgAtom(id, checkScc);
+}
+
+void AtomAlloc::destroy(PrgAtom* a) {
+	a->~PrgAtom();
+	Chunk* b  = reinterpret_cast<Chunk*>(a);
+	b->next   = freeList_;
+	freeList_ = b;
+}
 
+void AtomAlloc::release() {
+	for (Block* r = blocks_, *t; r; ) {
+		t = r;
+		r = r->next;
+		::operator delete(t);
+	}
+	blocks_   = 0;
+	freeList_ = 0;
+}
+
+void AtomAlloc::allocBlock() {
+	Block* r = (Block*)::operator new(sizeof(Block));
+	for (uint32 i = 0; i < Block::num_chunks-1; ++i) {
+		r->chunk[i].next = &r->chunk[i+1];
+	}
+	r->chunk[Block::num_chunks-1].next = freeList_;
+	freeList_ = r->chunk;
+	r->next   = blocks_;
+	blocks_   = r;
+}
 } }
@@ -86,6 +86,9 @@ MinimizeConstraint* SharedMinimizeData::attach(Solver& s, MinimizeMode_t::Strate
 	if (strat == MinimizeMode_t::opt_bb || mode() == MinimizeMode_t::enumerate) {
 		ret = new DefaultMinimize(this, param);
 	}
+	else if (strat == MinimizeMode_t::opt_lns) {
+		ret = new LnsMinimize(this, param);
+	}
 	else {
 		ret = new UncoreMinimize(this, param);
 	}
@@ -520,6 +523,185 @@ bool DefaultMinimize::updateBounds(bool applyStep) {
 }
 #undef STRATEGY
 /////////////////////////////////////////////////////////////////////////////////////////
+// LnsMinimize
+/////////////////////////////////////////////////////////////////////////////////////////
+// Stops the search once the active neighborhood exceeds its conflict budget 
+// or once a new model should become the center of the next neighborhood.
+class LnsMinimize::Budget : public PostPropagator {
+public:
+	explicit Budget(LnsMinimize& m) : self_(&m) {}
+	uint32 priority() const                          { return priority_class_general; }
+	bool   propagateFixpoint(Solver& s, PostPropagator*) { return !self_->checkStop(s); }
+private:
+	LnsMinimize* self_;
+};
+// Compares the predicate names of two atoms, i.e. their names up to the first '('.
+static int comparePred(const char* lhs, const char* rhs) {
+	for (; *lhs == *rhs && *lhs && *lhs != '('; ++lhs, ++rhs) { ; }
+	int l = *lhs != '(' ? (unsigned char)*lhs : 0;
+	int r = *rhs != '(' ? (unsigned char)*rhs : 0;
+	return l - r;
+}
+struct LessPred {
+	typedef std::pair<const char*, Var> NamedVar;
+	bool operator()(const NamedVar& lhs, const NamedVar& rhs) const { return comparePred(lhs.first, rhs.first) < 0; }
+};
+LnsMinimize::LnsMinimize(SharedData* d, uint32 options) 
+	: DefaultMinimize(d, 0)
+	, budget_(0)
+	, limit_(0)
+	, conf_(1000)
+	, root_(0)
+	, fix_(80) {
+	type_ = (options & 3u) <= MinimizeMode_t::lns_constraint ? (options & 3u) : 0u;
+	hood_ = stop_ = init_ = done_ = 0;
+}
+LnsMinimize::~LnsMinimize() {}
+
+void LnsMinimize::destroy(Solver* s, bool detach) {
+	if (budget_) {
+		if (s && detach) { s->removePost(budget_); }
+		budget_->destroy(s, false);
+		budget_ = 0;
+	}
+	DefaultMinimize::destroy(s, detach);
+}
+
+bool LnsMinimize::attach(Solver& s) {
+	const Configuration* c = s.sharedContext()->configuration();
+	if (c) {
+		fix_  = c->solver(s.id()).lnsFix;
+		conf_ = std::max(c->solver(s.id()).lnsConf, uint32(1));
+	}
+	rng_.srand(s.rng.seed());
+	budget_ = new Budget(*this);
+	return s.addPost(budget_) && DefaultMinimize::attach(s);
+}
+
+bool LnsMinimize::relax(Solver& s, bool reset) {
+	best_.clear();
+	hood_ = stop_ = init_ = done_ = 0;
+	return DefaultMinimize::relax(s, reset);
+}
+
+bool LnsMinimize::handleModel(Solver& s) {
+	DefaultMinimize::handleModel(s);
+	if (!done_ && shared_->optimize()) {
+		best_ = s.model;
+		stop_ = stop_model;
+	}
+	return true;
+}
+
+// Returns true and sets a stop conflict in s if the search
+// in the active neighborhood shall be stopped.
+bool LnsMinimize::checkStop(Solver& s) {
+	if      (stop_ == stop_model)                    { }
+	else if (hood_ && s.stats.conflicts >= limit_)  { stop_ = stop_budget; }
+	else                                            { return false; }
+	s.setStopConflict();
+	return true;
+}
+
+// Handles the end of a neighborhood and selects the next one.
+// Only if no neighborhood was active, the unsat result is
+// passed to the base class, e.g. for updating the lower bound.
+bool LnsMinimize::handleUnsat(Solver& s, bool up, LitVec& out) {
+	uint32 why  = stop_;
+	bool   hood = hood_ != 0;
+	stop_ = stop_none;
+	hood_ = 0;
+	if (why == stop_none && !hood) { return DefaultMinimize::handleUnsat(s, up, out); }
+	s.popRootLevel(0);
+	// bound conflicts inside a neighborhood are not final - reload the bound from the shared data
+	DefaultMinimize::relax(s, true);
+	if (hood && s.rootLevel() > root_) { s.popRootLevel(s.rootLevel() - root_); }
+	if (s.hasConflict() || !shared_->optimize()) {
+		// conflict does not depend on the neighborhood
+		return DefaultMinimize::handleUnsat(s, up, out);
+	}
+	if      (why == stop_budget) { fix_ = std::min(fix_ + ((100 - fix_) / 10) + 1, uint32(99)); conf_ += std::min(conf_ / 2, (UINT32_MAX/2) - conf_/2); }
+	else if (why == stop_none)   { fix_ = (fix_ * 9) / 10; } // neighborhood contains no better model
+	root_ = s.rootLevel();
+	if (fix_ < 10) { done_ = 1; }
+	if (done_ || best_.empty()) { return true; }
+	if (!init_) { initVars(s); }
+	selectFree(s, (uint32)vars_.size() - (uint32)((uint64(vars_.size()) * fix_) / 100));
+	for (VarVec::const_iterator it = vars_.begin(), end = vars_.end(); it != end; ++it) {
+		Var v = *it;
+		if (free_[v] == 2 && v < best_.size() && best_[v] != value_free && s.value(v) == value_free) {
+			out.push_back(Literal(v, best_[v] == value_false));
+		}
+		free_[v] = 2;
+	}
+	hood_  = !out.empty();
+	limit_ = s.stats.conflicts + conf_;
+	return true;
+}
+
+// Collects the atoms that may be fixed in a neighborhood: the variables of 
+// named atoms grouped by predicate or, if there are none, all problem variables.
+// Candidates are marked with 2 in free_.
+void LnsMinimize::initVars(const Solver& s) {
+	typedef LessPred::NamedVar NamedVar;
+	typedef PodVector<NamedVar>::type NamedVec;
+	const SymbolTable& index = s.sharedContext()->symbolTable();
+	NamedVec named;
+	for (SymbolTable::const_iterator it = index.begin(), end = index.end(); it != end; ++it) {
+		if (!it->second.name.empty() && it->second.lit.var() != 0 && it->second.lit.var() <= s.numProblemVars()) {
+			named.push_back(NamedVar(it->second.name.c_str(), it->second.lit.var()));
+		}
+	}
+	std::stable_sort(named.begin(), named.end(), LessPred());
+	free_.assign(s.numVars() + 1, 0);
+	vars_.clear();
+	groups_.clear();
+	for (NamedVec::const_iterator it = named.begin(), end = named.end(); it != end; ++it) {
+		if (it == named.begin() || comparePred(it[-1].first, it->first) != 0) { groups_.push_back((uint32)vars_.size()); }
+		if (!free_[it->second]) { free_[it->second] = 2; vars_.push_back(it->second); }
+	}
+	if (vars_.empty()) {
+		groups_.clear();
+		for (Var v = 1; v <= s.numProblemVars(); ++v) { free_[v] = 2; vars_.push_back(v); }
+	}
+	groups_.push_back((uint32)vars_.size());
+	init_ = 1;
+}
+
+// Marks at least num candidates as free (3 in free_) according to the neighborhood type.
+void LnsMinimize::selectFree(const Solver& s, uint32 num) {
+	uint32 marked = 0;
+	if (type_ == MinimizeMode_t::lns_predicate && groups_.size() > 2) {
+		for (uint32 n = (uint32)groups_.size() - 1, tries = n; tries-- && marked < num; ) {
+			uint32 g = randomIndex(n);
+			for (uint32 i = groups_[g], end = groups_[g+1]; i != end; ++i) {
+				if (free_[vars_[i]] == 2) { free_[vars_[i]] = 3; ++marked; }
+			}
+		}
+	}
+	else if (type_ == MinimizeMode_t::lns_constraint && !s.constraints().empty()) {
+		for (uint32 n = (uint32)s.constraints().size(), tries = n; tries-- && marked < num; ) {
+			ClauseHead* c = s.constraints()[randomIndex(n)]->clause();
+			if (!c) { continue; }
+			temp_.clear();
+			c->toLits(temp_);
+			for (LitVec::const_iterator it = temp_.begin(), end = temp_.end(); it != end; ++it) {
+				Var v = it->var();
+				if (v < free_.size() && free_[v] == 2) { free_[v] = 3; ++marked; }
+			}
+		}
+	}
+	// fill up with random candidates (selection sampling)
+	uint32 need = num > marked ? num - marked : 0;
+	uint32 left = (uint32)vars_.size() - std::min(marked, (uint32)vars_.size());
+	for (VarVec::const_iterator it = vars_.begin(), end = vars_.end(); it != end && need; ++it) {
+		if (free_[*it] == 2) {
+			if (rng_.drand() * left < need) { free_[*it] = 3; --need; }
+			--left;
+		}
+	}
+}
+/////////////////////////////////////////////////////////////////////////////////////////
 // MinimizeBuilder
 /////////////////////////////////////////////////////////////////////////////////////////
 MinimizeBuilder::MinimizeBuilder() : ready_(false) { }
@@ -789,7 +971,7 @@ UncoreMinimize::UncoreMinimize(SharedMinimizeData* d, uint32 strat)
 	, auxAdd_(0)
 	, freeOpen_(0)
 	, options_(0) {
-	options_ = strat & 7u;
+	options_ = strat & 15u;
 }
 void UncoreMinimize::init() {
 	releaseLits();
@@ -806,6 +988,7 @@ void UncoreMinimize::init() {
 	path_  = 1;
 	next_  = 0;
 	init_  = 1;
+	pure_  = 0;
 }
 bool UncoreMinimize::attach(Solver& s) {
 	init();
@@ -928,6 +1111,13 @@ bool UncoreMinimize::initLevel(Solver& s) {
 			}
 		}
 	}
+	if ((options_ & MinimizeMode_t::usc_stratify) != 0u && hasWeights && assume_.size() > 1) {
+		// defer all but the literals with the highest weights
+		strat_.swap(assume_);
+		for (LitSet::const_iterator it = strat_.begin(), end = strat_.end(); it != end; ++it) { getData(it->id).assume = 0; }
+		std::stable_sort(strat_.begin(), strat_.end(), LessWeight(litData_));
+		nextStratum();
+	}
 	pre_  = (options_ & MinimizeMode_t::usc_preprocess) != 0u;
 	valid_= (pre_ == 0 && !hasWeights);
 	if (next_ && !s.hasConflict()) {
@@ -1070,7 +1260,7 @@ bool UncoreMinimize::valid(Solver& s) {
 	}
 	valid_ = 0;
 	sat_   = 1;
-	setLower(low);
+	if (strat_.empty()) { setLower(low); }
 	s.setStopConflict();
  	return false;
 }
@@ -1082,8 +1272,8 @@ bool UncoreMinimize::handleModel(Solver& s) {
 	sat_  = shared_->checkNext();
 	gen_  = shared_->generation();
 	upper_= shared_->upper(level_);
-	valid_= 1;
-	if (sat_) { setLower(sum_[level_]); }
+	valid_= uint32(strat_.empty()); // models of a non-final stratum must be checked
+	if (sat_ && valid_) { setLower(sum_[level_]); }
 	return true;
 }
 
@@ -1108,6 +1298,10 @@ bool UncoreMinimize::handleUnsat(Solver& s, bool up, LitVec& out) {
 				return false;
 			}
 			if (pre_ == 0) {
+				if ((options_ & MinimizeMode_t::usc_stratify) != 0u) {
+					shareCore(s, cs);
+					cs = trimCore(s, cs, mw, out);
+				}
 				addCore(s, &todo_[0], cs, mw);
 				todo_.clear();
 			}
@@ -1136,6 +1330,10 @@ bool UncoreMinimize::handleUnsat(Solver& s, bool up, LitVec& out) {
 				if (cmp > 0) { s.hasConflict() || s.force(~tag_, Antecedent(0)); }
 				else         { next_ = level_ != shared_->maxLevel() || shared_->checkNext(); }
 			}
+			else if (!strat_.empty()) {
+				// all assumptions of active stratum satisfied - add next stratum
+				nextStratum();
+			}
 			if (pre_) { 
 				LitSet().swap(todo_);
 				pre_ = 0; 
@@ -1159,11 +1357,13 @@ uint32 UncoreMinimize::analyze(Solver& s, LitVec& rhs, weight_t& minW, LitVec& p
 		minW = getData(todo_.back().id).weight;
 		minDL= s.level(todo_.back().lit.var());
 	}
+	pure_         = 0;
 	if (s.decisionLevel() <= eRoot_) {
 		return cs;
 	}
 	// resolve all-last uip
 	Literal p;
+	pure_         = 1;
 	for (Var v;;) {
 		// process current rhs
 		for (LitVec::size_type i = 0; i != rhs.size(); ++i) {
@@ -1181,11 +1381,16 @@ uint32 UncoreMinimize::analyze(Solver& s, LitVec& rhs, weight_t& minW, LitVec& p
 		dl = s.level(p.var());
 		assert(dl);
 		s.clearSeen(p.var());
-		if      (!s.reason(p).isNull()) { s.reason(p, rhs); }
+		if      (!s.reason(p).isNull()) {
+			const Antecedent& ante = s.reason(p);
+			if (ante.type() == Antecedent::generic_constraint && (ante.constraint() == this || ante.constraint() == enum_)) { pure_ = 0; }
+			s.reason(p, rhs);
+		}
 		else if (p == s.decision(dl) && dl > eRoot_ && dl <= aTop_) {
 			s.markSeen(p);
 			++roots;
 		}
+		else if (p == s.decision(dl)) { pure_ = 0; }
 	}
 	// map marked root decisions back to our assumptions
 	for (LitSet::iterator it = assume_.begin(), end = assume_.end(); it != end && roots; ++it) {
@@ -1318,6 +1523,20 @@ bool UncoreMinimize::addCore(Solver& s, const WCTemp& wc, weight_t weight) {
 	uint32       fset = WeightConstraint::create_explicit | WeightConstraint::create_no_add | WeightConstraint::create_no_freeze | WeightConstraint::create_no_share;
 	if ((options_ & MinimizeMode_t::usc_imp_only) != 0u) { fset |= WeightConstraint::create_only_bfb; }
 	ResPair       res = WeightConstraint::create(s, negLit(newAux), rep, fset);
+	if ((options_ & MinimizeMode_t::usc_stratify) != 0u) {
+		// exhaust core: increase bound while the assumption fails by propagation
+		while (res.ok() && res.first() && exhaust(s, posLit(newAux))) {
+			res.first()->destroy(&s, true);
+			lower_ += weight;
+			if (rep.bound == rep.reach) { // all literals of core are true
+				x.assume = 0;
+				x.weight = 0;
+				return !s.hasConflict();
+			}
+			rep.bound = ++B;
+			res       = WeightConstraint::create(s, negLit(newAux), rep, fset);
+		}
+	}
 	if (res.ok() && res.first()) {
 		x.coreId = allocCore(res.first(), B, weight, rep.bound != rep.reach);
 	}
@@ -1325,6 +1544,81 @@ bool UncoreMinimize::addCore(Solver& s, const WCTemp& wc, weight_t weight) {
 }
 
 
+// Returns whether assume is false or leads to a conflict when propagated on 
+// the solver's initial root level.
+bool UncoreMinimize::exhaust(Solver& s, Literal assume) {
+	if (s.rootLevel() != eRoot_ || s.hasConflict()) { return false; }
+	bool fail = !s.pushRoot(assume);
+	s.popRootLevel(s.rootLevel() - eRoot_);
+	return fail && !s.hasConflict();
+}
+
+// Tries to remove literals from the core stored in the last cs entries of todo_.
+// A literal is removed if the assumptions of the remaining literals already
+// fail by propagation on the solver's initial root level. The number of pushed
+// assumptions is limited by a fixed budget.
+uint32 UncoreMinimize::trimCore(Solver& s, uint32 cs, weight_t& minW, LitVec& poppedOther) {
+	popPath(s, eRoot_, poppedOther);
+	LitPair* core = &todo_[todo_.size() - cs];
+	uint32 budget = 4096, n = cs;
+	for (uint32 i = 0; i < n && n > 1 && budget >= n;) {
+		uint32 j = 0;
+		for (; j != n; ++j) {
+			if (j != i && !s.pushRoot(~core[j].lit)) { break; }
+		}
+		budget -= std::min(budget, j + 1);
+		s.popRootLevel(s.rootLevel() - eRoot_);
+		if (j == n) { ++i; continue; }
+		// core[0..j] without core[i] is still a core
+		n = j + 1;
+		if (i < n) { core[i] = core[--n]; }
+	}
+	if (n != cs) {
+		minW = std::numeric_limits<weight_t>::max();
+		for (uint32 i = 0; i != n; ++i) { minW = std::min(minW, getData(core[i].id).weight); }
+		shrinkVecTo(todo_, todo_.size() - (cs - n));
+	}
+	aTop_ = s.rootLevel();
+	return n;
+}
+
+// Publishes the core stored in the last cs entries of todo_ as a clause
+// to other solvers, provided that it only contains problem literals and is
+// implied by the problem, i.e. its derivation did not depend on fixed 
+// literals or external assumptions.
+void UncoreMinimize::shareCore(Solver& s, uint32 cs) {
+	if (!pure_ || cs == 0 || s.sharedContext()->concurrency() < 2) { return; }
+	LitVec clause;
+	for (LitSet::const_iterator it = todo_.end() - cs, end = todo_.end(); it != end; ++it) {
+		if (s.auxVar(it->lit.var())) { return; }
+		clause.push_back(it->lit);
+	}
+	ClauseInfo info(Constraint_t::learnt_conflict);
+	info.setLbd(cs);
+	if (SharedLiterals* x = s.distribute(&clause[0], (uint32)clause.size(), info)) { x->release(); }
+}
+
+// Moves the literals of the next stratum from strat_ to the active assumptions.
+// If the remaining weights are diverse, a stratum contains all literals whose weight
+// is within a factor of two of the highest weight; otherwise, it only contains
+// the literals with the highest weight.
+bool UncoreMinimize::nextStratum() {
+	if (strat_.empty()) { return false; }
+	uint32 diverse = 1;
+	for (LitSet::const_iterator it = strat_.begin() + 1, end = strat_.end(); it != end; ++it) {
+		diverse += getData(it->id).weight != getData(it[-1].id).weight;
+	}
+	weight_t maxW = getData(strat_.back().id).weight;
+	weight_t minW = (diverse * 4) > strat_.size() ? (maxW / 2) + 1 : maxW;
+	do {
+		getData(strat_.back().id).assume = 1;
+		assume_.push_back(strat_.back());
+		strat_.pop_back();
+	} while (!strat_.empty() && getData(strat_.back().id).weight >= minW);
+	path_ = 1;
+	return true;
+}
+
 // Computes the solver's initial root level, i.e. all assumptions that are not from us.
 uint32 UncoreMinimize::initRoot(Solver& s) {
 	if (eRoot_ == aTop_ && !s.hasStopConflict()) {
@@ -1345,11 +1639,15 @@ bool UncoreMinimize::fixLit(Solver& s, Literal p) {
 	if (eRoot_ && s.topValue(p.var()) != trueValue(p)) { fix_.push_back(p); } 
 	return !s.hasConflict() && s.force(p, this);
 }
-// Fixes any remaining assumptions of the active optimization level.
+// Fixes any remaining assumptions of the active optimization level
+// including those of strata not yet reached.
 bool UncoreMinimize::fixLevel(Solver& s) {
 	for (LitSet::iterator it = assume_.begin(), end = assume_.end(); it != end; ++it) {
 		if (getData(it->id).assume) { fixLit(s, it->lit); }
 	}
+	for (LitSet::iterator it = strat_.begin(), end = strat_.end(); it != end; ++it) {
+		fixLit(s, it->lit);
+	}
 	releaseLits();
 	return !s.hasConflict();
 }
@@ -1362,6 +1660,7 @@ void UncoreMinimize::releaseLits() {
 	litData_.clear();
 	assume_.clear();
 	todo_.clear();
+	strat_.clear();
 	freeOpen_ = 0;
 }
 
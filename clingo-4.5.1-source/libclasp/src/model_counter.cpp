@@ -0,0 +1,789 @@
+//
+// Copyright (c) 2015, Benjamin Kaufmann
+//
+// This file is part of Clasp. See http://www.cs.uni-potsdam.de/clasp/
+//
+// Clasp is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Clasp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Clasp; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+//
+#include <clasp/model_counter.h>
+#include <clasp/solver.h>
+#include <clasp/clause.h>
+#include <clasp/enumerator.h>
+#include <clasp/dependency_graph.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace Clasp {
+/////////////////////////////////////////////////////////////////////////////////////////
+// ModelCount
+/////////////////////////////////////////////////////////////////////////////////////////
+ModelCount::ModelCount(uint64 n) {
+	for (; n; n >>= 32) { limbs_.push_back(static_cast<uint32>(n)); }
+}
+void ModelCount::trim() {
+	while (!limbs_.empty() && limbs_.back() == 0) { limbs_.pop_back(); }
+}
+int ModelCount::compare(const ModelCount& other) const {
+	if (limbs_.size() != other.limbs_.size()) { return limbs_.size() < other.limbs_.size() ? -1 : 1; }
+	for (uint32 i = (uint32)limbs_.size(); i--; ) {
+		if (limbs_[i] != other.limbs_[i]) { return limbs_[i] < other.limbs_[i] ? -1 : 1; }
+	}
+	return 0;
+}
+ModelCount& ModelCount::operator+=(const ModelCount& other) {
+	if (limbs_.size() < other.limbs_.size()) { limbs_.resize(other.limbs_.size(), 0); }
+	uint64 carry = 0;
+	for (uint32 i = 0, end = (uint32)limbs_.size(); i != end; ++i) {
+		carry    += uint64(limbs_[i]) + (i < other.limbs_.size() ? other.limbs_[i] : 0u);
+		limbs_[i] = static_cast<uint32>(carry);
+		carry   >>= 32;
+	}
+	if (carry) { limbs_.push_back(static_cast<uint32>(carry)); }
+	return *this;
+}
+ModelCount& ModelCount::operator*=(const ModelCount& other) {
+	if (zero() || other.zero()) { limbs_.clear(); return *this; }
+	LimbVec res(limbs_.size() + other.limbs_.size(), 0);
+	for (uint32 i = 0, n = (uint32)limbs_.size(), m = (uint32)other.limbs_.size(); i != n; ++i) {
+		uint64 carry = 0;
+		for (uint32 j = 0; j != m; ++j) {
+			carry     += uint64(limbs_[i]) * other.limbs_[j] + res[i+j];
+			res[i+j]   = static_cast<uint32>(carry);
+			carry    >>= 32;
+		}
+		res[i+m] = static_cast<uint32>(carry);
+	}
+	limbs_.swap(res);
+	trim();
+	return *this;
+}
+ModelCount& ModelCount::shift(uint32 n) {
+	if (zero() || n == 0) { return *this; }
+	if (uint32 bits = n & 31u) {
+		uint32 carry = 0;
+		for (uint32 i = 0, end = (uint32)limbs_.size(); i != end; ++i) {
+			uint32 x  = limbs_[i];
+			limbs_[i] = (x << bits) | carry;
+			carry     = x >> (32 - bits);
+		}
+		if (carry) { limbs_.push_back(carry); }
+	}
+	limbs_.insert(limbs_.begin(), n >> 5, 0u);
+	return *this;
+}
+double ModelCount::toDouble() const {
+	double res = 0.0;
+	for (uint32 i = (uint32)limbs_.size(); i--; ) { res = (res * 4294967296.0) + limbs_[i]; }
+	return res;
+}
+std::string ModelCount::toString() const {
+	if (zero()) { return "0"; }
+	// split into base 10^9 digits, least significant first
+	LimbVec temp(limbs_), digits;
+	while (!temp.empty()) {
+		uint64 rem = 0;
+		for (uint32 i = (uint32)temp.size(); i--; ) {
+			uint64 cur = (rem << 32) | temp[i];
+			temp[i]    = static_cast<uint32>(cur / 1000000000u);
+			rem        = cur % 1000000000u;
+		}
+		while (!temp.empty() && temp.back() == 0) { temp.pop_back(); }
+		digits.push_back(static_cast<uint32>(rem));
+	}
+	char buf[16];
+	std::sprintf(buf, "%u", digits.back());
+	std::string res(buf);
+	for (uint32 i = (uint32)digits.size() - 1; i--; ) {
+		std::sprintf(buf, "%09u", digits[i]);
+		res += buf;
+	}
+	return res;
+}
+/////////////////////////////////////////////////////////////////////////////////////////
+// ParityConstraint
+/////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+struct LevelGreater {
+	explicit LevelGreater(const Solver& s) : s_(&s) {}
+	uint32 key(Var v) const { return s_->value(v) == value_free ? UINT32_MAX : s_->level(v); }
+	bool operator()(Var lhs, Var rhs) const { return key(lhs) > key(rhs); }
+	const Solver* s_;
+};
+}
+ParityConstraint::ParityConstraint(const VarVec& vars, bool rhs) : vars_(vars), rhs_(rhs) {}
+
+bool ParityConstraint::create(Solver& s, const VarVec& vars, bool rhs, ParityConstraint*& out) {
+	ParityConstraint* c = new ParityConstraint(vars, rhs);
+	VarVec& x = c->vars_;
+	// watch free vars first and then the vars assigned last
+	std::stable_sort(x.begin(), x.end(), LevelGreater(s));
+	out = c;
+	if (x.empty()) { return !rhs; }
+	c->watch(s, 0);
+	if (x.size() == 1) { return s.force(rhs ? posLit(x[0]) : negLit(x[0]), c); }
+	c->watch(s, 1);
+	if (s.value(x[1]) != value_free) {
+		if (s.value(x[0]) == value_free) {
+			return s.force(c->parity(s, 0) != rhs ? posLit(x[0]) : negLit(x[0]), c);
+		}
+		return c->parity(s, UINT32_MAX) == rhs;
+	}
+	return true;
+}
+
+void ParityConstraint::watch(Solver& s, uint32 slot) {
+	s.addWatch(posLit(vars_[slot]), this, slot);
+	s.addWatch(negLit(vars_[slot]), this, slot);
+}
+
+// Returns the parity of the true variables ignoring the variable at position skip.
+bool ParityConstraint::parity(const Solver& s, uint32 skip) const {
+	bool res = false;
+	for (uint32 i = 0, end = size(); i != end; ++i) {
+		if (i != skip && s.value(vars_[i]) == value_true) { res = !res; }
+	}
+	return res;
+}
+
+Constraint::PropResult ParityConstraint::propagate(Solver& s, Literal p, uint32& data) {
+	const uint32 slot  = data;
+	const uint32 other = 1 - slot;
+	assert(vars_[slot] == p.var());
+	for (uint32 i = 2, end = size(); i != end; ++i) {
+		if (s.value(vars_[i]) == value_free) {
+			std::swap(vars_[slot], vars_[i]);
+			s.removeWatch(~p, this);
+			watch(s, slot);
+			return PropResult(true, false);
+		}
+	}
+	if (s.value(vars_[other]) == value_free) {
+		Var x = vars_[other];
+		return PropResult(s.force(parity(s, other) != rhs_ ? posLit(x) : negLit(x), this), true);
+	}
+	return PropResult(parity(s, UINT32_MAX) == rhs_ || s.force(~p, this), true);
+}
+
+void ParityConstraint::reason(Solver& s, Literal p, LitVec& lits) {
+	for (VarVec::const_iterator it = vars_.begin(), end = vars_.end(); it != end; ++it) {
+		if (*it != p.var()) { lits.push_back(s.trueLit(*it)); }
+	}
+}
+
+void ParityConstraint::destroy(Solver* s, bool detach) {
+	if (s && detach) {
+		for (uint32 i = 0, end = std::min(size(), 2u); i != end; ++i) {
+			s->removeWatch(posLit(vars_[i]), this);
+			s->removeWatch(negLit(vars_[i]), this);
+		}
+	}
+	Constraint::destroy(s, detach);
+}
+/////////////////////////////////////////////////////////////////////////////////////////
+// ModelCounter::Exact
+/////////////////////////////////////////////////////////////////////////////////////////
+// Counts components of the constraint graph by branching on projection vars.
+//
+// The constraint graph contains the problem clauses, the short implications,
+// the vars watched by other static constraints, and one constraint over the
+// atoms and bodies of the positive dependency graph, since unfounded set
+// checking (and stability checking) may relate any of them.
+// A component is given by [#vars, #constraints, branch var, vars..., constraints...].
+class ModelCounter::Exact {
+public:
+	Exact(ModelCounter& self, Solver& s, BasicSolve& solve);
+	bool count(const VarVec& proj, ModelCount& out);
+private:
+	typedef PodVector<uint8>::type FlagVec;
+	// A bounded hash table mapping component keys to counts.
+	class Cache {
+	public:
+		explicit Cache(uint32 maxWords) : max_(maxWords) { clear(); }
+		const ModelCount* find(const VarVec& key, uint32 h) const;
+		void              add(const VarVec& key, uint32 h, const ModelCount& c);
+	private:
+		struct Entry {
+			uint32     hash;
+			uint32     next;
+			uint32     key;
+			uint32     size;
+			ModelCount count;
+		};
+		void clear();
+		void grow();
+		std::vector<Entry> entries_;
+		VarVec             buckets_;
+		VarVec             keys_;
+		uint32             max_;
+	};
+	struct AddShort {
+		explicit AddShort(Exact& x) : self(&x) {}
+		bool unary(Literal p, Literal q) const;
+		bool binary(Literal p, Literal q, Literal r) const;
+		Exact* self;
+	};
+	static const Var* next(const Var* comp) { return comp + 3 + comp[0] + comp[1]; }
+	void     init(const VarVec& proj);
+	void     addConstraint(const LitVec& lits, bool clause);
+	bool     active(uint32 c) const;
+	void     split(const Var* first, const Var* last, VarVec& out, uint32& free);
+	uint32   makeKey(const Var* comp, VarVec& key) const;
+	bool     countComponent(const Var* comp, ModelCount& out);
+	bool     branch(Literal p, const Var* first, const Var* last, ModelCount& out);
+	ValueRep findModel();
+	ModelCounter* self_;
+	Solver*       s_;
+	BasicSolve*   solve_;
+	LitVec        lits_;     // literals of all constraints
+	VarVec        cons_;     // constraint c is given by lits_[cons_[c], cons_[c+1])
+	FlagVec       clause_;   // whether constraint c is a clause
+	VarVec        occBegin_; // constraints of var v are occ_[occBegin_[v], occBegin_[v+1])
+	VarVec        occ_;
+	VarVec        varStamp_;
+	VarVec        conStamp_;
+	VarVec        score_;
+	VarVec        visited_;
+	FlagVec       proj_;
+	FlagVec       glue_;
+	ValueVec      model_;
+	Cache         cache_;
+	uint32        stamp_;
+	bool          check_;    // whether propagation alone may accept assignments that are not models
+};
+
+ModelCounter::Exact::Exact(ModelCounter& self, Solver& s, BasicSolve& solve)
+	: self_(&self)
+	, s_(&s)
+	, solve_(&solve)
+	, model_(s.model)
+	, cache_(uint32(1) << 24)
+	, stamp_(0)
+	, check_(false) {
+}
+
+void ModelCounter::Exact::Cache::clear() {
+	entries_.clear();
+	keys_.clear();
+	buckets_.assign(1024, UINT32_MAX);
+}
+void ModelCounter::Exact::Cache::grow() {
+	buckets_.assign(buckets_.size() * 2, UINT32_MAX);
+	const uint32 mask = (uint32)buckets_.size() - 1;
+	for (uint32 i = 0, end = (uint32)entries_.size(); i != end; ++i) {
+		Entry& e = entries_[i];
+		e.next   = buckets_[e.hash & mask];
+		buckets_[e.hash & mask] = i;
+	}
+}
+const ModelCount* ModelCounter::Exact::Cache::find(const VarVec& key, uint32 h) const {
+	for (uint32 i = buckets_[h & (buckets_.size() - 1)]; i != UINT32_MAX; i = entries_[i].next) {
+		const Entry& e = entries_[i];
+		if (e.hash == h && e.size == key.size() && std::equal(key.begin(), key.end(), keys_.begin() + e.key)) {
+			return &e.count;
+		}
+	}
+	return 0;
+}
+void ModelCounter::Exact::Cache::add(const VarVec& key, uint32 h, const ModelCount& c) {
+	if (keys_.size() + key.size() > max_) { clear(); }
+	if (entries_.size() >= buckets_.size()) { grow(); }
+	Entry e;
+	e.hash  = h;
+	e.next  = buckets_[h & (buckets_.size() - 1)];
+	e.key   = (uint32)keys_.size();
+	e.size  = (uint32)key.size();
+	e.count = c;
+	buckets_[h & (buckets_.size() - 1)] = (uint32)entries_.size();
+	entries_.push_back(e);
+	keys_.insert(keys_.end(), key.begin(), key.end());
+}
+
+// Short clauses are stored once for each of their literals - add them for the smallest one.
+// Learnt implications have at least one watched literal.
+bool ModelCounter::Exact::AddShort::unary(Literal p, Literal q) const {
+	if (!p.watched() && !q.watched() && ~p < q) {
+		LitVec lits; lits.push_back(~p); lits.push_back(q);
+		self->addConstraint(lits, true);
+	}
+	return true;
+}
+bool ModelCounter::Exact::AddShort::binary(Literal p, Literal q, Literal r) const {
+	if (!p.watched() && !q.watched() && !r.watched() && ~p < q && ~p < r) {
+		LitVec lits; lits.push_back(~p); lits.push_back(q); lits.push_back(r);
+		self->addConstraint(lits, true);
+	}
+	return true;
+}
+
+void ModelCounter::Exact::addConstraint(const LitVec& lits, bool clause) {
+	uint32 glued = 0;
+	for (LitVec::const_iterator it = lits.begin(), end = lits.end(); it != end; ++it) { glued += glue_[it->var()]; }
+	if (lits.size() < 2 || glued == lits.size()) {
+		// does neither connect components nor contribute to keys
+		return;
+	}
+	lits_.insert(lits_.end(), lits.begin(), lits.end());
+	cons_.push_back((uint32)lits_.size());
+	clause_.push_back(uint8(clause));
+}
+
+void ModelCounter::Exact::init(const VarVec& proj) {
+	typedef std::pair<Constraint*, Var> ConVar;
+	const Solver&        s   = *s_;
+	const SharedContext& ctx = *s.sharedContext();
+	const uint32         nv  = s.numProblemVars() + 1;
+	LitVec temp;
+	proj_.assign(nv, 0);
+	glue_.assign(nv, 0);
+	cons_.assign(1, 0);
+	for (VarVec::const_iterator it = proj.begin(), end = proj.end(); it != end; ++it) { proj_[*it] = 1; }
+	if (const SharedDependencyGraph* g = ctx.sccGraph.get()) {
+		for (uint32 i = 0; i != g->numAtoms(); ++i) { temp.push_back(g->getAtom(i).lit); }
+		for (uint32 i = 0; i != g->numBodies(); ++i){ temp.push_back(g->getBody(i).lit); }
+		LitVec::iterator j = temp.begin();
+		for (LitVec::const_iterator it = temp.begin(), end = temp.end(); it != end; ++it) {
+			Var v = it->var();
+			if (v && !glue_[v]) { glue_[v] = 1; *j++ = posLit(v); }
+		}
+		temp.erase(j, temp.end());
+		if (temp.size() > 1) {
+			lits_.insert(lits_.end(), temp.begin(), temp.end());
+			cons_.push_back((uint32)lits_.size());
+			clause_.push_back(0);
+		}
+	}
+	PodVector<ClauseHead*>::type heads;
+	std::vector<ConVar> other;
+	for (Var v = 1; v != nv; ++v) {
+		for (uint32 sign = 0; sign != 2; ++sign) {
+			const WatchList& w = s.watches(Literal(v, sign != 0));
+			for (WatchList::const_left_iterator it = w.left_begin(), end = w.left_end(); it != end; ++it) {
+				if (it->head->type() == Constraint_t::static_constraint) { heads.push_back(it->head); }
+			}
+			for (WatchList::const_right_iterator it = w.right_begin(), end = w.right_end(); it != end; ++it) {
+				if (it->con->type() == Constraint_t::static_constraint) { other.push_back(ConVar(it->con, v)); }
+			}
+		}
+	}
+	std::sort(heads.begin(), heads.end());
+	heads.erase(std::unique(heads.begin(), heads.end()), heads.end());
+	for (PodVector<ClauseHead*>::type::const_iterator it = heads.begin(), end = heads.end(); it != end; ++it) {
+		temp.clear();
+		(*it)->toLits(temp);
+		addConstraint(temp, true);
+	}
+	std::sort(other.begin(), other.end());
+	other.erase(std::unique(other.begin(), other.end()), other.end());
+	for (std::vector<ConVar>::const_iterator it = other.begin(), end = other.end(); it != end; ) {
+		temp.clear();
+		for (Constraint* c = it->first; it != end && it->first == c; ++it) { temp.push_back(posLit(it->second)); }
+		addConstraint(temp, false);
+	}
+	const ShortImplicationsGraph& btig = ctx.shortImplications();
+	for (Var v = 1; v != nv; ++v) {
+		if (posLit(v).index() < btig.size()) { btig.forEach(posLit(v), AddShort(*this)); }
+		if (negLit(v).index() < btig.size()) { btig.forEach(negLit(v), AddShort(*this)); }
+	}
+	// occurrence lists
+	const uint32 nc = (uint32)cons_.size() - 1;
+	occBegin_.assign(nv + 1, 0);
+	for (LitVec::const_iterator it = lits_.begin(), end = lits_.end(); it != end; ++it) { ++occBegin_[it->var()+1]; }
+	for (uint32 v = 1; v <= nv; ++v) { occBegin_[v] += occBegin_[v-1]; }
+	occ_.resize(lits_.size());
+	VarVec pos(occBegin_.begin(), occBegin_.end() - 1);
+	for (uint32 c = 0; c != nc; ++c) {
+		for (uint32 i = cons_[c]; i != cons_[c+1]; ++i) { occ_[pos[lits_[i].var()]++] = c; }
+	}
+	varStamp_.assign(nv, 0);
+	score_.assign(nv, 0);
+	conStamp_.assign(nc, 0);
+}
+
+bool ModelCounter::Exact::active(uint32 c) const {
+	if (!clause_[c]) { return true; }
+	for (uint32 i = cons_[c], end = cons_[c+1]; i != end; ++i) {
+		if (s_->isTrue(lits_[i])) { return false; }
+	}
+	return true;
+}
+
+// Appends the components over the free vars in [first, last) to out.
+// Components without projection vars are dropped, isolated projection vars
+// are only counted in free.
+void ModelCounter::Exact::split(const Var* first, const Var* last, VarVec& out, uint32& free) {
+	const Solver& s = *s_;
+	if (++stamp_ == 0) {
+		varStamp_.assign(varStamp_.size(), 0);
+		conStamp_.assign(conStamp_.size(), 0);
+		stamp_ = 1;
+	}
+	for (; first != last; ++first) {
+		Var v = *first;
+		if (s.value(v) != value_free || varStamp_[v] == stamp_) { continue; }
+		uint32 pos = (uint32)out.size();
+		out.push_back(0); out.push_back(0); out.push_back(0);
+		out.push_back(v);
+		varStamp_[v] = stamp_;
+		score_[v]    = 0;
+		visited_.clear();
+		for (uint32 i = pos + 3; i != out.size(); ++i) {
+			Var x = out[i];
+			for (uint32 k = occBegin_[x], kEnd = occBegin_[x+1]; k != kEnd; ++k) {
+				uint32 c = occ_[k];
+				if (conStamp_[c] == stamp_) { continue; }
+				conStamp_[c] = stamp_;
+				if (!active(c))             { continue; }
+				visited_.push_back(c);
+				for (uint32 j = cons_[c], jEnd = cons_[c+1]; j != jEnd; ++j) {
+					Var y = lits_[j].var();
+					if (s.value(y) != value_free) { continue; }
+					if (varStamp_[y] != stamp_)   { varStamp_[y] = stamp_; score_[y] = 0; out.push_back(y); }
+					++score_[y];
+				}
+			}
+		}
+		Var    best  = 0;
+		uint32 nProj = 0;
+		for (uint32 i = pos + 3, end = (uint32)out.size(); i != end; ++i) {
+			Var y = out[i];
+			if (proj_[y]) {
+				++nProj;
+				if (!best || score_[y] > score_[best] || (score_[y] == score_[best] && y < best)) { best = y; }
+			}
+		}
+		if (nProj == 0 || visited_.empty()) {
+			free += (nProj != 0);
+			out.resize(pos);
+			continue;
+		}
+		out[pos]   = (uint32)out.size() - (pos + 3);
+		out[pos+1] = (uint32)visited_.size();
+		out[pos+2] = best;
+		std::sort(out.begin() + pos + 3, out.end());
+		std::sort(visited_.begin(), visited_.end());
+		out.insert(out.end(), visited_.begin(), visited_.end());
+	}
+}
+
+// The residual problem of a component is given by its free vars, its active constraints,
+// and the assigned literals of its non-clause constraints.
+uint32 ModelCounter::Exact::makeKey(const Var* comp, VarVec& key) const {
+	key.assign(comp, next(comp));
+	key[2] = 0;
+	for (const Var* c = comp + 3 + comp[0], *end = next(comp); c != end; ++c) {
+		if (clause_[*c]) { continue; }
+		for (uint32 i = cons_[*c], iEnd = cons_[*c+1]; i != iEnd; ++i) {
+			Var v = lits_[i].var();
+			if (s_->value(v) != value_free) { key.push_back(s_->trueLit(v).index()); }
+		}
+	}
+	uint32 h = 0;
+	for (VarVec::const_iterator it = key.begin(), end = key.end(); it != end; ++it) {
+		h = hashId(h ^ *it);
+	}
+	return h;
+}
+
+bool ModelCounter::Exact::countComponent(const Var* comp, ModelCount& out) {
+	if (self_->interrupted()) { return false; }
+	VarVec key;
+	uint32 h = makeKey(comp, key);
+	if (const ModelCount* c = cache_.find(key, h)) {
+		out = *c;
+		return true;
+	}
+	const Var* first = comp + 3;
+	const Var* last  = first + comp[0];
+	Literal    x     = model_[comp[2]] == value_true ? posLit(comp[2]) : negLit(comp[2]);
+	ModelCount rhs;
+	if (!branch(x, first, last, out) || !branch(~x, first, last, rhs)) {
+		return false;
+	}
+	out += rhs;
+	cache_.add(key, h, out);
+	return true;
+}
+
+// Counts the models of the component [first, last) extended with p.
+// Pre: If check_ is true, model_ is a model of the current assignment.
+// Otherwise, all free vars are branched on and propagation alone decides
+// whether an assignment is a model. This is not the case for non-hcf
+// components, whose minimality is only checked once an assignment is total.
+bool ModelCounter::Exact::branch(Literal p, const Var* first, const Var* last, ModelCount& out) {
+	Solver& s = *s_;
+	out = ModelCount(0);
+	if (s.isFalse(p)) { return true; }
+	bool     push = !s.isTrue(p);
+	ValueRep res  = value_true;
+	if (push) {
+		s.assume(p);
+		s.pushRootLevel();
+		if      (!s.propagate())                 { res = self_->interrupted() ? value_free : value_false; }
+		else if (check_ && model_[p.var()] != trueValue(p)) { res = findModel(); }
+	}
+	if (res == value_true) {
+		VarVec comps;
+		uint32 free = 0;
+		split(first, last, comps, free);
+		out = ModelCount(1);
+		out.shift(free);
+		for (const Var* c = comps.begin(), *end = comps.end(); c != end && res == value_true; c = next(c)) {
+			ModelCount n;
+			if (countComponent(c, n)) { out *= n; }
+			else                      { res = value_free; }
+		}
+	}
+	if (push) {
+		s.popRootLevel(1);
+		if (res != value_free && !s.propagate()) { res = value_free; }
+	}
+	return res != value_free;
+}
+
+// Searches for a model of the current root assignment.
+ValueRep ModelCounter::Exact::findModel() {
+	Solver&  s   = *s_;
+	ValueRep res = solve_->solve();
+	if (res == value_false && self_->interrupted()) {
+		res = value_free;
+	}
+	else if (res == value_true) {
+		model_ = s.model;
+		s.setBacktrackLevel(s.rootLevel());
+		s.undoUntil(s.rootLevel());
+		if (!s.propagate()) { res = value_free; }
+	}
+	return res;
+}
+
+bool ModelCounter::Exact::count(const VarVec& proj, ModelCount& out) {
+	init(proj);
+	VarVec vars, comps;
+	for (Var v = 1, end = s_->numProblemVars(); v <= end; ++v) {
+		if (s_->value(v) == value_free) { vars.push_back(v); }
+	}
+	const SharedDependencyGraph* g = s_->sharedContext()->sccGraph.get();
+	check_ = vars.size() != proj.size() || (g && g->numNonHcfs() != 0);
+	uint32 free = 0;
+	split(vars.begin(), vars.end(), comps, free);
+	out = ModelCount(1);
+	out.shift(free);
+	for (const Var* c = comps.begin(), *end = comps.end(); c != end; c = next(c)) {
+		ModelCount n;
+		if (!countComponent(c, n)) { return false; }
+		out *= n;
+	}
+	return true;
+}
+/////////////////////////////////////////////////////////////////////////////////////////
+// ModelCounter
+/////////////////////////////////////////////////////////////////////////////////////////
+ModelCounter::ModelCounter(const EnumOptions& opts, Enumerator* enumerator, const SolveLimits& limit)
+	: SequentialSolve(enumerator, limit)
+	, eps_(opts.countEps)
+	, delta_(opts.countDelta)
+	, mode_(opts.countMode)
+	, project_(opts.project != 0)
+	, counted_(false)
+	, exact_(true) {
+}
+ModelCounter::~ModelCounter() {}
+
+bool ModelCounter::doSolve(SharedContext& ctx, const LitVec& gp) {
+	Solver&       s = *ctx.master();
+	SolveLimits lim = limits();
+	uint32     root = s.rootLevel();
+	uint32    nVars = s.numVars();
+	BasicSolve solve(s, ctx.configuration()->search(0), &lim);
+	ConVec     keep; // constraints that are destroyed after popping all levels
+	count_   = ModelCount();
+	counted_ = false;
+	exact_   = true;
+	bool stop = !attachInterrupt(s);
+	bool more = !stop && ctx.attach(s) && enumerator().start(s, gp);
+	ValueRep res = more ? solve.solve() : value_false;
+	if (res == value_true) {
+		// report the first model and count from the root level - the model limit only applies to reported models
+		if (enumerator().commitModel(s)) { reportModel(s); }
+		stop = interrupted();
+		s.setBacktrackLevel(s.rootLevel());
+		s.undoUntil(s.rootLevel());
+		if (!stop && s.propagate()) {
+			VarVec proj;
+			for (Var v = 1, end = s.numProblemVars(); v <= end; ++v) {
+				if (s.value(v) == value_free && (!project_ || ctx.varInfo(v).project())) { proj.push_back(v); }
+			}
+			if (mode_ == EnumOptions::count_exact) { counted_ = Exact(*this, s, solve).count(proj, count_); }
+			else                                   { counted_ = countApprox(s, solve, proj, keep); }
+		}
+		stop = stop || interrupted();
+		more = !counted_;
+	}
+	else if (res == value_false) {
+		counted_ = !interrupted();
+		more     = false;
+		if (counted_) {
+			LitVec* core = new LitVec();
+			solve.unsatCore(gp, *core);
+			setCore(core);
+		}
+	}
+	s.popRootLevel(s.rootLevel() - root);
+	for (ConVec::const_iterator it = keep.begin(), end = keep.end(); it != end; ++it) { (*it)->destroy(&s, true); }
+	s.popAuxVar(s.numVars() - nVars);
+	detachInterrupt();
+	ctx.detach(s);
+	return more || stop;
+}
+
+// Hash functions are stored as rows of a bit matrix over proj.
+// Each row has words-1 words for the variables followed by one word for the parity.
+void ModelCounter::addHash(Solver& s, uint32 numVars, VarVec& rows) {
+	const uint32 words = (numVars + 31) / 32 + 1;
+	uint32 row = (uint32)rows.size();
+	rows.resize(row + words, 0);
+	for (bool empty = true; empty; ) {
+		for (uint32 i = 0; i != numVars; ++i) {
+			if (s.rng.drand() < 0.5) { rows[row + (i / 32)] |= (1u << (i & 31)); empty = false; }
+		}
+	}
+	rows[row + words - 1] = s.rng.drand() < 0.5;
+}
+
+// Counts the projected models of the cell given by the first numRows hash functions
+// but stops once limit models are found.
+// The hash functions are reduced by Gauss-Jordan elimination and added as parity
+// constraints that are activated by a fresh aux var. Constraints that can't
+// be destroyed on return are added to keep.
+ValueRep ModelCounter::countCell(Solver& s, BasicSolve& solve, const VarVec& proj, const VarVec& rows, uint32 numRows, uint32 limit, uint32& out, ConVec& keep) {
+	const uint32 n     = (uint32)proj.size();
+	const uint32 words = (n + 31) / 32 + 1;
+	VarVec m(rows.begin(), rows.begin() + numRows * words);
+	// replace assigned vars by their values
+	for (uint32 i = 0; i != n; ++i) {
+		if (s.value(proj[i]) == value_free) { continue; }
+		for (uint32 r = 0; r != numRows; ++r) {
+			uint32* row = &m[r * words];
+			if ((row[i / 32] & (1u << (i & 31))) != 0) {
+				row[i / 32]   ^= (1u << (i & 31));
+				row[words - 1]^= (uint32)s.isTrue(posLit(proj[i]));
+			}
+		}
+	}
+	// reduce the system to reduced row echelon form
+	uint32 rank = 0;
+	for (uint32 i = 0; i != n && rank != numRows; ++i) {
+		const uint32 w = i / 32, bit = 1u << (i & 31);
+		uint32 p = rank;
+		while (p != numRows && (m[p * words + w] & bit) == 0) { ++p; }
+		if (p == numRows) { continue; }
+		if (p != rank) { std::swap_ranges(m.begin() + p * words, m.begin() + (p + 1) * words, m.begin() + rank * words); }
+		for (uint32 r = 0; r != numRows; ++r) {
+			if (r != rank && (m[r * words + w] & bit) != 0) {
+				for (uint32 k = 0; k != words; ++k) { m[r * words + k] ^= m[rank * words + k]; }
+			}
+		}
+		++rank;
+	}
+	out = 0;
+	for (uint32 r = rank; r != numRows; ++r) {
+		if (m[r * words + words - 1]) { return value_false; } // 0 = 1
+	}
+	const uint32 base  = s.rootLevel();
+	const uint32 flags = ClauseCreator::clause_no_add | ClauseCreator::clause_explicit;
+	Var     act = s.pushAuxVar();
+	ConVec  cons;
+	VarVec  vars;
+	LitVec  lits;
+	bool    ok  = true;
+	for (uint32 r = 0; r != rank; ++r) {
+		vars.clear();
+		for (uint32 i = 0; i != n; ++i) {
+			if ((m[r * words + (i / 32)] & (1u << (i & 31))) != 0) { vars.push_back(proj[i]); }
+		}
+		vars.push_back(act);
+		ParityConstraint* c;
+		ParityConstraint::create(s, vars, m[r * words + words - 1] != 0, c); // can't fail because act is free
+		cons.push_back(c);
+	}
+	ValueRep res = value_false;
+	for (ok = s.pushRoot(negLit(act)), solve.reset(); ok && out != limit && (res = solve.solve()) == value_true; ) {
+		++out;
+		// block the projection of the model within this cell
+		lits.assign(1, posLit(act));
+		for (VarVec::const_iterator it = proj.begin(), end = proj.end(); it != end; ++it) { lits.push_back(~s.trueLit(*it)); }
+		s.setBacktrackLevel(s.rootLevel());
+		s.undoUntil(s.rootLevel());
+		ClauseCreator::Result r = ClauseCreator::create(s, lits, flags, ClauseInfo(Constraint_t::learnt_other));
+		if (r.local) { cons.push_back(r.local); }
+		ok = r.ok() && s.propagate();
+	}
+	if (interrupted()) { res = value_free; }
+	s.popRootLevel(s.rootLevel() - base);
+	if (s.value(act) == value_free) {
+		for (ConVec::const_iterator it = cons.begin(), end = cons.end(); it != end; ++it) { (*it)->destroy(&s, true); }
+	}
+	else {
+		// act was fixed on base level and our constraints might be reasons
+		keep.insert(keep.end(), cons.begin(), cons.end());
+	}
+	if (res != value_free && !s.propagate()) { res = value_free; }
+	return res;
+}
+
+bool ModelCounter::countApprox(Solver& s, BasicSolve& solve, const VarVec& proj, ConVec& keep) {
+	const double  e      = eps_;
+	const uint32  thresh = static_cast<uint32>(1 + 9.84 * (1 + e / (1 + e)) * (1 + 1 / e) * (1 + 1 / e));
+	const uint32  iters  = static_cast<uint32>(std::ceil(17 * std::log(3 / delta_) / std::log(2.0)));
+	const uint32  n      = (uint32)proj.size();
+	const uint32  words  = (n + 31) / 32 + 1;
+	VarVec        rows;
+	uint32        c;
+	if (countCell(s, solve, proj, rows, 0, thresh, c, keep) == value_free) { return false; }
+	if (c < thresh) {
+		count_ = ModelCount(c);
+		return true;
+	}
+	std::vector<ModelCount> est;
+	for (uint32 i = 0, m = 1; i != iters; ++i) {
+		// find the smallest number of hash functions with less than thresh models in the cell -
+		// cells are nested so that we can search linearly starting from the last result
+		uint32 lo = 0, hi = n + 1, hiCount = 0;
+		for (m = std::max(std::min(m, n), 1u); lo + 1 != hi; ) {
+			while (rows.size() < m * words) { addHash(s, n, rows); }
+			if (countCell(s, solve, proj, rows, m, thresh, c, keep) == value_free) { return false; }
+			if (c >= thresh) { lo = m; m = m + 1; }
+			else             { hi = m; hiCount = c; m = m - 1; }
+		}
+		if (hi <= n && hiCount) {
+			est.push_back(ModelCount(hiCount));
+			est.back().shift(hi);
+		}
+		m = hi;
+		rows.clear();
+	}
+	exact_ = false;
+	if (est.empty()) {
+		count_ = ModelCount(thresh);
+		return true;
+	}
+	std::sort(est.begin(), est.end());
+	count_ = est[est.size() / 2];
+	return true;
+}
+
+}
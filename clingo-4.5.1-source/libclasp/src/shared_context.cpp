@@ -500,6 +500,7 @@ bool SharedContext::ok() const { return master()->decisionLevel() || !master()->
 void SharedContext::enableStats(uint32 lev) {
 	if (lev > 0) { master()->stats.enableExtended(); }
 	if (lev > 1) { master()->stats.enableJump();     }
+	if (lev > 2) { master()->stats.enableProps();    }
 }
 void SharedContext::cloneVars(const SharedContext& other, InitMode m) {
 	problem_.vars            = other.problem_.vars;
@@ -82,6 +82,37 @@ bool BasicSolve::satisfiable(const LitVec& path, bool init) {
 	return temp.solve(*solver_, *params_, 0) == value_true;
 }
 
+void BasicSolve::unsatCore(const LitVec& path, LitVec& out) const {
+	Solver& s = *solver_;
+	LitVec lits;
+	Literal fail = posLit(0);
+	out.clear();
+	if (!s.hasConflict()) {
+		// pushRoot() stops on the first false assumption
+		for (LitVec::const_iterator it = path.begin(), end = path.end(); it != end; ++it) {
+			if (s.isFalse(*it)) {
+				fail = *it;
+				lits.push_back(~fail);
+				break;
+			}
+		}
+	}
+	else if (!s.hasStopConflict() && s.searchMode() != SolverStrategies::no_learning) {
+		lits = s.conflict();
+	}
+	else {
+		// conflict not available - fall back to all decisions
+		for (uint32 i = 1, end = s.decisionLevel(); i <= end; ++i) { lits.push_back(s.decision(i)); }
+	}
+	s.resolveToCore(lits);
+	if (fail != posLit(0)) { lits.push_back(fail); }
+	// restrict core to the given assumptions
+	std::sort(lits.begin(), lits.end());
+	for (LitVec::const_iterator it = path.begin(), end = path.end(); it != end; ++it) {
+		if (std::binary_search(lits.begin(), lits.end(), *it)) { out.push_back(*it); }
+	}
+}
+
 bool BasicSolve::assume(const LitVec& path) {
 	return solver_->pushRoot(path);
 }
@@ -259,8 +290,10 @@ bool SolveAlgorithm::solve(SharedContext& ctx, const LitVec& assume, ModelHandle
 		double          time;
 	};
 	if (!ctx.frozen()) { ctx.endInit(); }
+	core_ = 0;
 	ctx.report(message<Event::verbosity_low>(Event::subsystem_solve, "Solving"));
 	if (!ctx.ok() || !limits_.conflicts || interrupted()) {
+		if (!ctx.ok()) { core_ = new LitVec(); }
 		return ctx.ok();
 	}
 	return Scoped(*this, ctx).solve(assume, onModel);
@@ -301,13 +334,15 @@ void SequentialSolve::resetSolve()       { if (term_) { term_->term = 0; } }
 bool SequentialSolve::doInterrupt()      { return term_ && term_->terminate(); }
 void SequentialSolve::enableInterrupts() { if (!term_) { term_ = new InterruptHandler(); } }
 bool SequentialSolve::interrupted() const{ return term_ && term_->terminated(); }
+bool SequentialSolve::attachInterrupt(Solver& s) { return !term_ || term_->attach(s); }
+void SequentialSolve::detachInterrupt()          { if (term_) { term_->detach(); } }
 
 bool SequentialSolve::doSolve(SharedContext& ctx, const LitVec& gp) {
 	Solver&        s = *ctx.master();
 	SolveLimits  lim = limits();
 	uint32      root = s.rootLevel();
 	BasicSolve solve(s, ctx.configuration()->search(0), &lim);
-	bool        stop = term_ && !term_->attach(s);
+	bool        stop = !attachInterrupt(s);
 	bool        more = !stop && ctx.attach(s) && enumerator().start(s, gp);
 	// Add assumptions - if this fails, the problem is unsat 
 	// under the current assumptions but not necessarily unsat.
@@ -321,8 +356,13 @@ bool SequentialSolve::doSolve(SharedContext& ctx, const LitVec& gp) {
 		else if (enumerator().commitComplete()){ more = false; break; }
 		else                                   { enumerator().end(s); more = enumerator().start(s, gp); }
 	}
+	if (!more && !stop && enumerator().lastModel().num == 0) {
+		LitVec* core = new LitVec();
+		solve.unsatCore(gp, *core);
+		setCore(core);
+	}
 	s.popRootLevel(s.rootLevel() - root);
-	if (term_) { term_->detach(); }
+	detachInterrupt();
 	ctx.detach(s);
 	return more || stop;
 }
@@ -19,6 +19,7 @@
 //
 #include <clasp/solver.h>
 #include <clasp/clause.h>
+#include <clasp/util/timer.h>
 #if (defined(__cplusplus) && __cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER > 1500) || (defined(_LIBCPP_VERSION))
 #include <unordered_set>
 typedef std::unordered_set<Clasp::Constraint*> ConstraintSet;
@@ -88,9 +89,23 @@ void Solver::PPList::remove(PostPropagator* p) {
 }
 
 bool Solver::PPList::propagate(Solver& s, PostPropagator* x) const {
+	PropStats* prof = s.stats.props;
 	for (PostPropagator** r = act, *t; *r != x; ) {
 		t = *r;
-		if (!t->propagateFixpoint(s, x)) { return false; }
+		if (!prof) {
+			if (!t->propagateFixpoint(s, x)) { return false; }
+		}
+		else {
+			// only count ticks not already attributed to nested propagators
+			PropagatorClass c = t->propClass();
+			uint64 nested     = prof->total();
+			uint64 start      = CycleTime::getTicks();
+			bool   ok         = t->propagateFixpoint(s, x);
+			uint64 ticks      = CycleTime::getTicks() - start;
+			nested            = prof->total() - nested;
+			prof->add(c, ticks > nested ? ticks - nested : 0, 1);
+			if (!ok) { return false; }
+		}
 		assert(s.queueSize() == 0);
 		if (t == *r) { r = &t->next; }
 		// else: t was removed during propagate
@@ -574,7 +589,7 @@ uint32 Solver::numWatches(Literal p) const {
 	assert( validVar(p.var()) );
 	if (!validWatch(p)) return 0;
 	return static_cast<uint32>(watches_[p.index()].size()) 
-		+ shared_->shortImplications().numEdges(p);
+		+ (!auxVar(p.var()) ? shared_->shortImplications().numEdges(p) : 0);
 }
 	
 bool Solver::hasWatch(Literal p, Constraint* c) const {
@@ -771,7 +786,36 @@ Constraint::PropResult ClauseHead::propagate(Solver& s, Literal p, uint32&) {
 	return PropResult(s.force(head_[1^wLit], this), true);
 }
 
+namespace {
+// Policies for Solver::unitPropagate().
+struct NoPropProfile {
+	PropagatorClass classify(const Constraint*) const { return Propagator_t::prop_other; }
+	void            lap(PropagatorClass, uint32)      {}
+};
+struct PropProfile {
+	explicit PropProfile(PropStats& s) : stats(&s), last(CycleTime::getTicks()) {}
+	PropagatorClass classify(const Constraint* c) const { return c->propClass(); }
+	void lap(PropagatorClass c, uint32 calls) {
+		uint64 now = CycleTime::getTicks();
+		stats->add(c, now - last, calls);
+		last = now;
+	}
+	PropStats* stats;
+	uint64     last;
+};
+}
+
 bool Solver::unitPropagate() {
+	if (!stats.props) {
+		NoPropProfile none;
+		return unitPropagate(none);
+	}
+	PropProfile prof(*stats.props);
+	return unitPropagate(prof);
+}
+
+template <class P>
+bool Solver::unitPropagate(P& prof) {
 	assert(!hasConflict());
 	Literal p, q, r;
 	uint32 idx, ignore, DL = decisionLevel();
@@ -782,8 +826,10 @@ bool Solver::unitPropagate() {
 		idx           = p.index();
 		WatchList& wl = watches_[idx];
 		// first: short clause BCP
-		if (idx < maxIdx && !btig.propagate(*this, p)) {
-			return false;
+		if (idx < maxIdx) {
+			bool ok = btig.propagate(*this, p);
+			prof.lap(Propagator_t::prop_short, 1);
+			if (!ok) { return false; }
 		}
 		// second: clause BCP
 		if (wl.left_size() != 0) {
@@ -796,27 +842,40 @@ bool Solver::unitPropagate() {
 					*j++ = w;
 				}
 				if (!res.ok) {
+					prof.lap(Propagator_t::prop_clause, static_cast<uint32>(it - wl.left_begin()));
 					wl.shrink_left(std::copy(it, end, j));
 					return false;
 				}
 			}
+			prof.lap(Propagator_t::prop_clause, static_cast<uint32>(end - wl.left_begin()));
 			wl.shrink_left(j);
 		}
 		// third: general constraint BCP
 		if (wl.right_size() != 0) {
 			WatchList::right_iterator it, end, j = wl.right_begin(); 
 			Constraint::PropResult res;
+			// batch consecutive watches of the same propagator class
+			PropagatorClass c = prof.classify(wl.right_begin()->con), x;
+			uint32          n = 0;
 			for (it = wl.right_begin(), end = wl.right_end(); it != end; ) {
 				GenericWatch& w = *it++;
+				if ((x = prof.classify(w.con)) != c) {
+					prof.lap(c, n);
+					c = x;
+					n = 0;
+				}
 				res = w.propagate(*this, p);
+				++n;
 				if (res.keepWatch) {
 					*j++ = w;
 				}
 				if (!res.ok) {
+					prof.lap(c, n);
 					wl.shrink_right(std::copy(it, end, j));
 					return false;
 				}
 			}
+			prof.lap(c, n);
 			wl.shrink_right(j);
 		}
 	}
@@ -856,6 +915,28 @@ bool Solver::resolveConflict() {
 	return false;
 }
 
+void Solver::resolveToCore(LitVec& lits) {
+	LitVec rhs;
+	rhs.swap(lits);
+	// resolve all-last uip
+	for (uint32 marked = 0, tPos = (uint32)assign_.trail.size();;) {
+		for (LitVec::const_iterator it = rhs.begin(), end = rhs.end(); it != end; ++it) {
+			assert(isTrue(*it));
+			if (level(it->var()) && !seen(it->var())) {
+				markSeen(it->var());
+				++marked;
+			}
+		}
+		if (marked-- == 0) { break; }
+		// search for the last assigned literal that needs to be analyzed...
+		while (!seen(assign_.trail[--tPos].var())) { ; }
+		Literal p = assign_.trail[tPos];
+		clearSeen(p.var());
+		if (!reason(p).isNull()) { reason(p, rhs); }
+		else                     { lits.push_back(p); rhs.clear(); }
+	}
+}
+
 bool Solver::backtrack() {
 	Literal lastChoiceInverted;
 	do {
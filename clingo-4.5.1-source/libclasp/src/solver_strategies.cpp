@@ -46,12 +46,14 @@ void SolverStrategies::prepare() {
 	}
 }
 SolverParams::SolverParams() {
-	struct X { uint32 strat[2]; uint32 self[3]; };
+	struct X { uint32 strat[2]; uint32 self[4]; };
 	static_assert(sizeof(SolverParams) == sizeof(X), "Unsupported Padding");
-	std::memset((&seed)+1, 0, sizeof(uint32)*2);
+	std::memset((&seed)+1, 0, sizeof(uint32)*3);
 	seed     = RNG().seed();
 	heuOther = 3;
 	heuMoms  = 1;
+	lnsFix   = 80;
+	lnsConf  = 1000;
 }
 uint32 SolverParams::prepare() {
 	uint32 res = 0;
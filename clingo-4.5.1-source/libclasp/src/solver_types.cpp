@@ -28,6 +28,7 @@ namespace Clasp {
 bool SolverStats::enableStats(const SolverStats& o) {
 	if (o.extra && !enableExtended()) { return false; }
 	if (o.jumps && !enableJump())     { return false; }
+	if (o.props && !enableProps())    { return false; }
 	return true;
 }
 bool SolverStats::enableExtended() { 
@@ -38,6 +39,10 @@ bool SolverStats::enableJump() {
 	if (!jumps) { jumps = new (std::nothrow) JumpStats(); }
 	return jumps != 0;
 }
+bool SolverStats::enableProps() {
+	if (!props) { props = new (std::nothrow) PropStats(); }
+	return props != 0;
+}
 void SolverStats::enableQueue(uint32 size) { 
 	if (queue && queue->maxSize()!=size) { queue->destroy(); queue = 0; }
 	if (!queue)                          { queue = SumQueue::create(size); }
@@ -47,16 +52,19 @@ void SolverStats::reset() {
 	if (queue) queue->resetGlobal();
 	if (extra) extra->reset();
 	if (jumps) jumps->reset();
+	if (props) props->reset();
 }
 void SolverStats::accu(const SolverStats& o) {
 	CoreStats::accu(o);
 	if (extra && o.extra) extra->accu(*o.extra);
 	if (jumps && o.jumps) jumps->accu(*o.jumps);
+	if (props && o.props) props->accu(*o.props);
 }
 void SolverStats::swapStats(SolverStats& o) {
 	std::swap(static_cast<CoreStats&>(*this), static_cast<CoreStats&>(o));
 	std::swap(extra, o.extra);
 	std::swap(jumps, o.jumps);
+	std::swap(props, o.props);
 }
 double SolverStats::operator[](const char* path) const {
 	bool ext = matchStatPath(path, "extra");
@@ -66,6 +74,10 @@ double SolverStats::operator[](const char* path) const {
 		if (!ext&& jumps){ return (*jumps)[path]; }
 		return -3.0; 
 	}
+	if (matchStatPath(path, "props")) {
+		if (!*path)      { return -2.0; }
+		return props ? (*props)[path] : -3.0;
+	}
 	return CoreStats::operator[](path);
 }
 const char* SolverStats::subKeys(const char* path) const {
@@ -73,6 +85,9 @@ const char* SolverStats::subKeys(const char* path) const {
 	if (ext || matchStatPath(path, "jumps")) {
 		return ext ? ExtendedStats::keys(path) : JumpStats::keys(path); 
 	}
+	if (matchStatPath(path, "props")) {
+		return PropStats::keys(path);
+	}
 	return 0;
 }
 /////////////////////////////////////////////////////////////////////////////////////////
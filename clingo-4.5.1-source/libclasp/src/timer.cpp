@@ -102,3 +102,8 @@ double ThreadTime::getTime() {
 }
 #endif
 
+#if !defined(CLASP_HAS_CYCLE_COUNTER)
+namespace Clasp {
+uint64 CycleTime::getTicks() { return static_cast<uint64>(RealTime::getTime() * 1000000000.0); }
+}
+#endif
@@ -78,9 +78,6 @@ DefaultUnfoundedCheck::DefaultUnfoundedCheck(ReasonStrategy st)
 	mini_.release();
 }
 DefaultUnfoundedCheck::~DefaultUnfoundedCheck() { 
-	for (ExtVec::size_type i = 0; i != extended_.size(); ++i) {
-		::operator delete(extended_[i]);
-	}
 	delete [] reasons_;
 }
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -171,13 +168,12 @@ void DefaultUnfoundedCheck::initExtBody(const BodyPtr& n) {
 	assert(n.id < bodies_.size() && n.node->extended());
 	BodyData& data = bodies_[n.id];
 	uint32 preds   = n.node->num_preds();
-	ExtData* extra = new (::operator new(sizeof(ExtData) + (ExtData::flagSize(preds)*sizeof(uint32)))) ExtData(n.node->ext_bound(), preds);
+	data.lower_or_ext = (uint32)extended_.size();
+	extended_.resize(extended_.size() + ExtData::wordSize(preds));
+	ExtData* extra = new (getExt(n.id)) ExtData(n.node->ext_bound(), preds);
 
 	InitExtWatches addWatches = { this, &n, extra };
 	graph_->visitBodyLiterals(*n.node, addWatches);
-	
-	data.lower_or_ext = (uint32)extended_.size();
-	extended_.push_back(extra);
 	initSuccessors(n, extra->lower);
 }
 
@@ -302,7 +298,7 @@ void DefaultUnfoundedCheck::updateSource(AtomData& atom, const BodyPtr& n) {
 // an atom in extended body n has a new source, check if n is now a valid source
 void DefaultUnfoundedCheck::AddSource::operator()(NodeId bodyId, uint32 idx) const {
 	BodyPtr n(self->getBody(bodyId));
-	ExtData* ext = self->extended_[self->bodies_[bodyId].lower_or_ext];
+	ExtData* ext = self->getExt(bodyId);
 	if (ext->lower > 0 || self->bodies_[n.id].watches == 0) {
 		// currently not a source - safely add pred to our watch set
 		ext->addToWs(idx, n.node->pred_weight(idx, false));
@@ -315,7 +311,7 @@ void DefaultUnfoundedCheck::AddSource::operator()(NodeId bodyId, uint32 idx) con
 // an atom in extended body n has lost its source, check if n is no longer a valid source
 void DefaultUnfoundedCheck::RemoveSource::operator()(NodeId bodyId, uint32 idx) const {
 	BodyPtr n(self->getBody(bodyId));
-	ExtData* ext = self->extended_[self->bodies_[bodyId].lower_or_ext];
+	ExtData* ext = self->getExt(bodyId);
 	ext->removeFromWs(idx, n.node->pred_weight(idx, false));
 	if (ext->lower > 0 && self->bodies_[n.id].watches > 0) {
 		// extended bodies don't always become false if a predecessor becomes false
@@ -405,7 +401,7 @@ void DefaultUnfoundedCheck::updateAssignment(Solver& s) {
 			assert(index < watches_.size());
 			const ExtWatch& w    = watches_[index];
 			const BodyNode& body = graph_->getBody(w.bodyId);
-			ExtData*        ext  = extended_[bodies_[w.bodyId].lower_or_ext];
+			ExtData*        ext  = getExt(w.bodyId);
 			ext->removeFromWs(w.data>>1, body.pred_weight(w.data>>1, test_bit(w.data, 0) != 0));
 			if (ext->lower > 0 && bodies_[w.bodyId].watches && !bodies_[w.bodyId].picked && !s.isFalse(body.lit)) {
 				// The body is not a valid source but at least one head atom 
@@ -427,6 +423,11 @@ DefaultUnfoundedCheck::UfsType DefaultUnfoundedCheck::findUfs(Solver& s, bool ch
 	// first: remove all sources that were recently falsified
 	updateAssignment(s);
 	// second: try to re-establish sources.
+	// Atoms of one scc have consecutive ids in the graph. Hence, ordering 
+	// the todo queue by id handles one scc at a time and visits its data in memory order.
+	if (todo_.size() > 1) {
+		std::sort(todo_.vec.begin() + todo_.qFront, todo_.vec.end());
+	}
 	while (!todo_.empty()) {
 		NodeId head       = todo_.pop_ret();
 		atoms_[head].todo = 0;
@@ -497,7 +498,7 @@ bool DefaultUnfoundedCheck::isValidSource(const BodyPtr& n) {
 	if (!n.node->extended()) {
 		return bodies_[n.id].lower_or_ext == 0;
 	}
-	ExtData* ext = extended_[bodies_[n.id].lower_or_ext];
+	ExtData* ext = getExt(n.id);
 	if (ext->lower > 0) {
 		// Since n is currently not a source, 
 		// we here know that no literal with a source can depend on this body.
@@ -688,7 +689,7 @@ void DefaultUnfoundedCheck::addIfReason(const BodyPtr& n, uint32 uScc) {
 				pickedExt_.push_back(n.id);
 				// Check if the body depends on the atoms from the unfounded set. I.e.
 				// would the body still be false if all but its unfounded literals would be true?
-				ExtData* ext     = extended_[bodies_[n.id].lower_or_ext];
+				ExtData* ext     = getExt(n.id);
 				weight_t temp    = ext->lower;
 				const NodeId* x  = n.node->preds();
 				const uint32 inc = n.node->pred_inc();
@@ -33,6 +33,11 @@
 #include <clasp/logic_program.h>
 #include <clasp/clasp_facade.h>
 #include <clasp/cli/clasp_options.h>
+#include <clasp/util/atomic.h>
+#if WITH_THREADS
+#include <clasp/util/mutex.h>
+#include <clasp/util/thread.h>
+#endif
 #include <program_opts/application.h>
 #include <program_opts/string_convert.h>
 
@@ -40,7 +45,7 @@
 
 class ClingoLpOutput : public Gringo::Output::LparseOutputter {
     public:
-        ClingoLpOutput(Clasp::Asp::LogicProgram& out) : prg_(out) {
+        ClingoLpOutput(Clasp::Asp::LogicProgram& out, bool csp = true, bool aggregates = false) : prg_(out), csp_(csp), aggregates_(aggregates) {
             false_ = prg_.newAtom();
             prg_.setCompute(false_, false);
         }
@@ -57,6 +62,12 @@ class ClingoLpOutput : public Gringo::Output::LparseOutputter {
         void printExternal(unsigned atomUid, Gringo::TruthValue type);
         void finishSymbols() { /* noop */ }
         bool &disposeMinimize();
+        bool csp() const     { return csp_; }
+        unsigned printOrderVariable(OrderVec const &order);
+        void printLinearConstraint(unsigned head, LinearTermVec const &terms, int bound);
+        bool nativeAggregates() const { return aggregates_; }
+        void printSumConstraint(unsigned head, LitCoefVec const &lits, int bound);
+        void removedRules(unsigned n) { prg_.stats.dupRules += n; }
 
     private:
         void addBody(const LitVec& body);
@@ -67,6 +78,8 @@ class ClingoLpOutput : public Gringo::Output::LparseOutputter {
         unsigned false_;
         std::stringstream str_;
         bool disposeMinimize_ = true;
+        bool csp_;
+        bool aggregates_;
 };
 
 // {{{1 declaration of ClingoOptions
@@ -83,7 +96,11 @@ struct ClingoOptions {
     bool wNoFileIncluded       = false;
     bool wNoVariableUnbounded  = false;
     bool wNoGlobalVariable     = false;
+    bool wNoQueryIgnored       = false;
     bool rewriteMinimize       = false;
+    bool translateCsp          = false;
+    bool nativeAggregates      = false;
+    unsigned dedupRules        = 0;
     Foobar foobar;
 };
 
@@ -98,6 +115,8 @@ inline bool parseWarning(const std::string& str, ClingoOptions& out) {
     if (str ==    "variable-unbounded")    { out.wNoVariableUnbounded  = false; return true; }
     if (str == "no-global-variable")       { out.wNoGlobalVariable     = true;  return true; }
     if (str ==    "global-variable")       { out.wNoGlobalVariable     = false; return true; }
+    if (str == "no-query-ignored")         { out.wNoQueryIgnored       = true;  return true; }
+    if (str ==    "query-ignored")         { out.wNoQueryIgnored       = false; return true; }
     return false;
 }
 
@@ -187,27 +206,170 @@ struct ClingoSolveIter : Gringo::SolveIter {
 };
 #endif
 
+// {{{1 declaration of ClingoStoredModel
+
+// A model whose shown and true atoms have been copied out of the solver.
+// It stays valid after the solver has moved on to the next model.
+struct ClingoStoredModel : Gringo::Model {
+    void assign(ClingoModel const &m);
+    virtual bool contains(Gringo::Value atom) const;
+    virtual Gringo::ValVec atoms(int atomset) const;
+    virtual Gringo::Int64Vec optimization() const { return costs; }
+    virtual void addClause(LitVec const &lits) const;
+    virtual ~ClingoStoredModel() { }
+
+    Gringo::ValVec   shown;
+    Gringo::ValVec   trueAtoms; // sorted
+    Gringo::Int64Vec costs;
+};
+
+// {{{1 declaration of ClingoModelQueue
+
+#if WITH_THREADS
+// Bounded single-producer/single-consumer ring of reusable slots.
+// Producer and consumer only synchronize via the atomic head and tail
+// counters; the mutex is taken solely to sleep on a full or empty queue.
+// Slots are allocated by the producer on first use.
+template <class T>
+class ClingoModelQueue {
+public:
+    static unsigned const maxSize = 1u << 16;
+    explicit ClingoModelQueue(unsigned size)
+    : slots_(std::max(size, 1u)) {
+        head_    = 0;
+        tail_    = 0;
+        waiting_ = 0;
+        closed_  = 0;
+    }
+    // Returns the next free slot (blocking while the queue is full) or
+    // nullptr if the queue has been closed.
+    T *back() {
+        if (full_() && !wait_([this]() { return !full_(); })) { return nullptr; }
+        if (closed_) { return nullptr; }
+        std::unique_ptr<T> &slot = slots_[tail_ % slots_.size()];
+        if (!slot) { slot.reset(new T()); }
+        return slot.get();
+    }
+    void push() {
+        ++tail_;
+        notify_();
+    }
+    // Returns the oldest filled slot (blocking while the queue is empty) or
+    // nullptr if the queue has been closed and drained.
+    T *front() {
+        if (empty_() && !wait_([this]() { return !empty_(); })) { return nullptr; }
+        return slots_[head_ % slots_.size()].get();
+    }
+    void pop() {
+        ++head_;
+        notify_();
+    }
+    void close() {
+        closed_ = 1;
+        Clasp::lock_guard<Clasp::mutex> lock(mutex_);
+        cond_.notify_all();
+    }
+    bool closed() const { return closed_ != 0; }
+    unsigned size() const { return slots_.size(); }
+
+private:
+    bool full_() const  { return tail_ - head_ == slots_.size(); }
+    bool empty_() const { return tail_ == head_; }
+    template <class P>
+    bool wait_(P pred) {
+        Clasp::unique_lock<Clasp::mutex> lock(mutex_);
+        ++waiting_;
+        while (!pred() && !closed_) { cond_.wait(lock); }
+        --waiting_;
+        return pred();
+    }
+    void notify_() {
+        if (waiting_ != 0) {
+            Clasp::lock_guard<Clasp::mutex> lock(mutex_);
+            cond_.notify_all();
+        }
+    }
+
+    std::vector<std::unique_ptr<T>>   slots_;
+    Clasp::atomic<uint64_t>           head_;
+    Clasp::atomic<uint64_t>           tail_;
+    Clasp::atomic<unsigned>           waiting_;
+    Clasp::atomic<int>                closed_;
+    Clasp::mutex                      mutex_;
+    Clasp::condition_variable         cond_;
+};
+
+// {{{1 declaration of ClingoQueuedSolveIter
+
+// Solves ahead of the consumer in a background thread storing up to a fixed
+// number of materialized models in a queue. The solver blocks only if the
+// queue is full.
+struct ClingoQueuedSolveIter : Gringo::SolveIter, Clasp::EventHandler {
+    ClingoQueuedSolveIter(Clasp::ClaspFacade &clasp, Clasp::Asp::LogicProgram const &lp, Gringo::Output::OutputBase const &out, unsigned queueSize);
+
+    virtual Gringo::Model const *next();
+    virtual void close();
+    virtual Gringo::SolveResult get();
+    virtual bool onModel(Clasp::Solver const &s, Clasp::Model const &m);
+    virtual void onEvent(Clasp::Event const &ev);
+
+    virtual ~ClingoQueuedSolveIter();
+
+    ClingoModel                         model;
+    ClingoModelQueue<ClingoStoredModel> queue;
+    bool                                popFront = false;
+    Clasp::ClaspFacade::AsyncResult     future;
+};
+#endif
+
 // {{{1 declaration of ClingoSolveFuture
 
 Gringo::SolveResult convert(Clasp::ClaspFacade::Result res);
 #if WITH_THREADS
+class ClingoControl;
 struct ClingoSolveFuture : Gringo::SolveFuture {
-    ClingoSolveFuture(Clasp::ClaspFacade::AsyncResult const &res);
+    ClingoSolveFuture(ClingoControl &ctl, Clasp::ClaspFacade::AsyncResult const &res);
     // async
     virtual Gringo::SolveResult get();
     virtual void wait();
     virtual bool wait(double timeout);
     virtual void cancel();
+    virtual std::vector<std::pair<Gringo::Value, bool>> unsatCore(bool minimize, double timeLimit);
     
     virtual ~ClingoSolveFuture();
     void reset(Clasp::ClaspFacade::AsyncResult res);
 
+    ClingoControl                  &ctl;
     Clasp::ClaspFacade::AsyncResult future;
     Gringo::SolveResult             ret = Gringo::SolveResult::UNKNOWN;
     bool                            done = false;
 };
 #endif
 
+// {{{1 declaration of ClingoFilePrefetcher
+
+#if WITH_THREADS
+// Reads input files on background threads ahead of the parser, which
+// consumes them in the given order. At most window files are kept in memory;
+// a file is released once its stream is destroyed, so a stream has to be
+// requested for every file. Parsing itself is not parallelized.
+class ClingoFilePrefetcher {
+public:
+    ClingoFilePrefetcher(std::vector<std::string> files, unsigned threads, unsigned window);
+    // Returns a stream over the i-th file; reads block until the file has been loaded.
+    std::unique_ptr<std::istream> stream(unsigned i);
+    ~ClingoFilePrefetcher();
+
+private:
+    struct State;
+    struct Buffer;
+    struct Stream;
+
+    std::shared_ptr<State>                      state_;
+    std::vector<std::unique_ptr<Clasp::thread>> threads_;
+};
+#endif
+
 // {{{1 declaration of ClingoControl
 
 class ClingoControl : public Gringo::Control, private Gringo::ConfigProxy, private Gringo::DomainProxy {
@@ -229,14 +391,18 @@ public:
     void onFinish(Clasp::ClaspFacade::Result ret);
     bool update();
 
-    Clasp::LitVec toClaspAssumptions(Gringo::Control::Assumptions &&ass) const;
+    Clasp::LitVec toClaspAssumptions(Gringo::Control::Assumptions &&ass);
+    void minimizeCore(Clasp::LitVec const &fixed, Clasp::LitVec &core, double timeLimit);
     
     // {{{2 DomainProxy interface
 
     virtual ElementPtr iter(Gringo::Signature const &sig) const;
     virtual ElementPtr iter() const;
     virtual ElementPtr lookup(Gringo::Value const &atom) const;
+    virtual size_t scan(Gringo::Signature const &sig, size_t offset, size_t size, Gringo::Value *atoms, unsigned *flags) const;
+    virtual void lookup(Gringo::Value const *atoms, size_t size, unsigned *flags) const;
     virtual size_t length() const;
+    virtual size_t length(Gringo::Signature const &sig) const;
     virtual std::vector<Gringo::FWSignature> signatures() const;
 
     // {{{2 ConfigProxy interface
@@ -256,6 +422,7 @@ public:
     virtual void ground(Gringo::Control::GroundVec const &vec, Gringo::Any &&context);
     virtual void add(std::string const &name, Gringo::FWStringVec const &params, std::string const &part);
     virtual void load(std::string const &filename);
+    virtual void loadFacts(std::string const &filename, Gringo::FWString predicate, std::string const &format, bool header);
     virtual Gringo::SolveResult solve(ModelHandler h, Assumptions &&ass);
     virtual bool blocked();
     virtual std::string str();
@@ -266,7 +433,8 @@ public:
     virtual void useEnumAssumption(bool enable);
     virtual bool useEnumAssumption();
     virtual void cleanupDomains();
-    virtual Gringo::SolveIter *solveIter(Assumptions &&ass);
+    virtual Assumptions unsatCore(bool minimize, double timeLimit);
+    virtual Gringo::SolveIter *solveIter(Assumptions &&ass, unsigned queueSize);
     virtual Gringo::SolveFuture *solveAsync(ModelHandler mh, FinishHandler fh, Assumptions &&ass);
 
     // }}}2
@@ -285,9 +453,19 @@ public:
     Clasp::Cli::ClaspCliConfig                             &claspConfig_;
     PostGroundFunc                                          pgf_;
     PreSolveFunc                                            psf_;
+    Assumptions                                             assumptions_;
+    // clasp literals of the last assumptions and their positions in assumptions_
+    std::vector<std::pair<Clasp::Literal, unsigned>>        assumptionLits_;
+    // atoms by clasp variable for cleanupDomains (linked lists of uid+1)
+    std::vector<unsigned>                                   varAtoms_;
+    std::vector<unsigned>                                   nextAtom_;
+    unsigned                                                atomsIndexed_ = 0;
+    // top level assignments already passed to cleanupDomains
+    unsigned                                                trailChecked_ = 0;
+    Clasp::Literal                                          trailLast_;
 #if WITH_THREADS
     std::unique_ptr<ClingoSolveFuture> solveFuture_;
-    std::unique_ptr<ClingoSolveIter>   solveIter_;
+    std::unique_ptr<Gringo::SolveIter> solveIter_;
 #endif
     bool enableEnumAssupmption_ = true;
     bool clingoMode_;
@@ -21,8 +21,11 @@
 
 #include "clingo/clingocontrol.hh"
 #include "clasp/solver.h"
+#include "clasp/util/timer.h"
 #include <program_opts/typed_value.h>
 #include <program_opts/application.h>
+#include <fstream>
+#include <sstream>
 
 // {{{1 definition of ClingoLpOutput
 
@@ -98,6 +101,132 @@ bool &ClingoLpOutput::disposeMinimize() {
     return disposeMinimize_;
 }
 
+unsigned ClingoLpOutput::printOrderVariable(OrderVec const &order) {
+    Clasp::WeightVec values;
+    Clasp::VarVec atoms;
+    for (auto &x : order) {
+        values.push_back(x.first);
+        atoms.push_back(x.second);
+    }
+    return prg_.addOrderVar(values, atoms);
+}
+
+void ClingoLpOutput::printLinearConstraint(unsigned head, LinearTermVec const &terms, int bound) {
+    Clasp::WeightVec coefs;
+    Clasp::VarVec vars;
+    for (auto &x : terms) {
+        coefs.push_back(x.first);
+        vars.push_back(x.second);
+    }
+    prg_.addLinearConstraint(head, coefs, vars, bound);
+}
+
+void ClingoLpOutput::printSumConstraint(unsigned head, LitCoefVec const &lits, int bound) {
+    Clasp::WeightLitVec wlits;
+    for (auto &x : lits) {
+        wlits.push_back(Clasp::WeightLiteral(Clasp::Literal((Clasp::Var)std::abs(x.first), x.first < 0), x.second));
+    }
+    prg_.addSumConstraint(head, wlits, bound);
+}
+
+// {{{1 definition of ClingoFilePrefetcher
+
+#if WITH_THREADS
+struct ClingoFilePrefetcher::State {
+    State(std::vector<std::string> &&files, unsigned window)
+    : files(std::move(files))
+    , contents(this->files.size())
+    , ready(this->files.size(), 0)
+    , window(std::max(window, 1u)) { }
+    void run() {
+        for (;;) {
+            unsigned i;
+            {
+                Clasp::unique_lock<Clasp::mutex> lock(mutex);
+                while (!stop && next < files.size() && next >= released + window) { cond.wait(lock); }
+                if (stop || next >= files.size()) { return; }
+                i = next++;
+            }
+            std::ifstream in(files[i], std::ios::binary);
+            std::ostringstream ss;
+            if (in) { ss << in.rdbuf(); }
+            std::string content = ss.str();
+            Clasp::lock_guard<Clasp::mutex> lock(mutex);
+            contents[i].swap(content);
+            ready[i] = 1;
+            cond.notify_all();
+        }
+    }
+
+    std::vector<std::string> files;
+    std::vector<std::string> contents;
+    std::vector<char>        ready;
+    unsigned                 window;
+    unsigned                 next     = 0;
+    unsigned                 released = 0;
+    bool                     stop     = false;
+    Clasp::mutex             mutex;
+    Clasp::condition_variable cond;
+};
+
+struct ClingoFilePrefetcher::Buffer : std::streambuf {
+    Buffer(std::shared_ptr<State> state, unsigned i)
+    : state(std::move(state))
+    , i(i) { }
+    virtual int_type underflow() {
+        if (!loaded) {
+            Clasp::unique_lock<Clasp::mutex> lock(state->mutex);
+            while (!state->ready[i]) { state->cond.wait(lock); }
+            data.swap(state->contents[i]);
+            loaded = true;
+            char *begin = &data[0];
+            setg(begin, begin, begin + data.size());
+        }
+        return gptr() < egptr() ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+    }
+    virtual ~Buffer() {
+        Clasp::lock_guard<Clasp::mutex> lock(state->mutex);
+        ++state->released;
+        state->cond.notify_all();
+    }
+
+    std::shared_ptr<State> state;
+    unsigned               i;
+    std::string            data;
+    bool                   loaded = false;
+};
+
+struct ClingoFilePrefetcher::Stream : std::istream {
+    Stream(std::shared_ptr<State> state, unsigned i)
+    : std::istream(nullptr)
+    , buffer(std::move(state), i) {
+        rdbuf(&buffer);
+    }
+
+    Buffer buffer;
+};
+
+ClingoFilePrefetcher::ClingoFilePrefetcher(std::vector<std::string> files, unsigned threads, unsigned window)
+: state_(std::make_shared<State>(std::move(files), window)) {
+    for (unsigned i = 0, e = std::min<size_t>(std::max(threads, 1u), state_->files.size()); i < e; ++i) {
+        threads_.emplace_back(Gringo::make_unique<Clasp::thread>([](std::shared_ptr<State> state) { state->run(); }, state_));
+    }
+}
+
+std::unique_ptr<std::istream> ClingoFilePrefetcher::stream(unsigned i) {
+    return Gringo::make_unique<Stream>(state_, i);
+}
+
+ClingoFilePrefetcher::~ClingoFilePrefetcher() {
+    {
+        Clasp::lock_guard<Clasp::mutex> lock(state_->mutex);
+        state_->stop = true;
+        state_->cond.notify_all();
+    }
+    for (auto &x : threads_) { x->join(); }
+}
+#endif
+
 // {{{1 definition of ClingoControl
 
 #define LOG if (verbose_) std::cerr
@@ -124,6 +253,7 @@ void ClingoControl::parse(const StringSeq& files, const ClingoOptions& opts, Cla
     if (opts.wNoVariableUnbounded)  { message_printer()->disable(W_VARIABLE_UNBOUNDED); }
     if (opts.wNoFileIncluded)       { message_printer()->disable(W_FILE_INCLUDED); }
     if (opts.wNoGlobalVariable)     { message_printer()->disable(W_GLOBAL_VARIABLE); }
+    if (opts.wNoQueryIgnored)       { message_printer()->disable(W_QUERY_IGNORED); }
     verbose_ = opts.verbose;
     Output::OutputPredicates outPreds;
     for (auto &x : opts.foobar) {
@@ -133,20 +263,51 @@ void ClingoControl::parse(const StringSeq& files, const ClingoOptions& opts, Cla
         out.reset(new Output::OutputBase(std::move(outPreds), std::cout, opts.lpRewrite));
     }
     else {  
-        if (claspOut) { lpOut.reset(new ClingoLpOutput(*claspOut)); }
+        if (claspOut) { lpOut.reset(new ClingoLpOutput(*claspOut, !opts.translateCsp, opts.nativeAggregates)); }
         else          { lpOut.reset(new Output::PlainLparseOutputter(std::cout)); }
+        if (opts.dedupRules > 0) { lpOut.reset(new Output::DedupLparseOutputter(std::move(lpOut), opts.dedupRules)); }
         out.reset(new Output::OutputBase(std::move(outPreds), *lpOut, opts.lparseDebug));
     }
     pb = make_unique<Input::NongroundProgramBuilder>(scripts, prg, *out, defs, opts.rewriteMinimize);
     parser = make_unique<Input::NonGroundParser>(*pb);
+#if WITH_THREADS
+    parser->setFactRunner(Clasp::thread::hardware_concurrency(), [](Input::FactTasks &tasks) {
+        std::vector<std::unique_ptr<Clasp::thread>> threads;
+        for (auto it = tasks.begin() + 1, ie = tasks.end(); it < ie; ++it) { threads.emplace_back(make_unique<Clasp::thread>(*it)); }
+        if (!tasks.empty()) { tasks.front()(); }
+        for (auto &x : threads) { x->join(); }
+    });
+#endif
     for (auto &x : opts.defines) {
         LOG << "define: " << x << std::endl;
         parser->parseDefine(x);
     }
+#if WITH_THREADS
+    // Only reading the files overlaps with parsing. The lexer and the program
+    // builder intern terms in symbol tables that are not thread-safe, so the
+    // files themselves are still parsed one after the other. Files are parsed
+    // in reverse order and stdin is read by the parser itself.
+    std::vector<std::string> fetch;
+    for (auto it = files.rbegin(), ie = files.rend(); it != ie; ++it) {
+        if (*it != "-") { fetch.emplace_back(*it); }
+    }
+    std::unique_ptr<ClingoFilePrefetcher> prefetch;
+    if (fetch.size() > 1) {
+        unsigned threads = std::max(Clasp::thread::hardware_concurrency(), 1u);
+        prefetch = make_unique<ClingoFilePrefetcher>(fetch, threads, 2 * threads);
+    }
+    unsigned j = fetch.size();
+    for (auto &x : files) {
+        LOG << "file: " << x << std::endl;
+        if (prefetch && x != "-") { parser->pushFile(std::string(x), prefetch->stream(--j)); }
+        else                      { parser->pushFile(std::string(x)); }
+    }
+#else
     for (auto x : files) {
         LOG << "file: " << x << std::endl;
         parser->pushFile(std::move(x));
     }
+#endif
     if (files.empty() && addStdIn) {
         LOG << "reading from stdin" << std::endl;
         parser->pushFile("-");
@@ -234,6 +395,10 @@ void ClingoControl::load(std::string const &filename) {
     parser->pushFile(std::string(filename));
     parse_();
 }
+void ClingoControl::loadFacts(std::string const &filename, Gringo::FWString predicate, std::string const &format, bool header) {
+    parser->loadFacts(filename, predicate, format, header);
+    parsed = true;
+}
 bool ClingoControl::hasSubKey(unsigned key, char const *name, unsigned* subKey) {
     *subKey = claspConfig_.getKey(key, name);
     return *subKey != Clasp::Cli::ClaspCliConfig::INVALID_KEY;
@@ -283,15 +448,24 @@ unsigned ClingoControl::getRootKey() {
 Gringo::ConfigProxy &ClingoControl::getConf() {
     return *this;
 }
-Gringo::SolveIter *ClingoControl::solveIter(Assumptions &&ass) {
+Gringo::SolveIter *ClingoControl::solveIter(Assumptions &&ass, unsigned queueSize) {
     if (!clingoMode_) { throw std::runtime_error("solveIter is not supported in gringo gringo mode"); }
 #if WITH_THREADS
+    if (queueSize > ClingoModelQueue<ClingoStoredModel>::maxSize) {
+        throw std::runtime_error("queue size must not exceed " + std::to_string(ClingoModelQueue<ClingoStoredModel>::maxSize));
+    }
     prepare_(nullptr, nullptr);
     clasp->assume(toClaspAssumptions(std::move(ass)));
-    solveIter_ = Gringo::make_unique<ClingoSolveIter>(clasp->startSolveAsync(), static_cast<Clasp::Asp::LogicProgram&>(*clasp->program()), *out, clasp->ctx);
+    if (queueSize > 0) {
+        solveIter_ = Gringo::make_unique<ClingoQueuedSolveIter>(*clasp, static_cast<Clasp::Asp::LogicProgram&>(*clasp->program()), *out, queueSize);
+    }
+    else {
+        solveIter_ = Gringo::make_unique<ClingoSolveIter>(clasp->startSolveAsync(), static_cast<Clasp::Asp::LogicProgram&>(*clasp->program()), *out, clasp->ctx);
+    }
     return solveIter_.get();
 #else
     (void)ass;
+    (void)queueSize;
     throw std::runtime_error("solveIter requires clingo to be build with thread support");
 #endif
 }
@@ -300,7 +474,7 @@ Gringo::SolveFuture *ClingoControl::solveAsync(ModelHandler mh, FinishHandler fh
 #if WITH_THREADS
     prepare_(mh, fh);
     clasp->assume(toClaspAssumptions(std::move(ass)));
-    solveFuture_ = Gringo::make_unique<ClingoSolveFuture>(clasp->solveAsync(nullptr));
+    solveFuture_ = Gringo::make_unique<ClingoSolveFuture>(*this, clasp->solveAsync(nullptr));
     return solveFuture_.get();
 #else
     (void)mh;
@@ -333,25 +507,92 @@ void ClingoControl::prepare_(Gringo::Control::ModelHandler mh, Gringo::Control::
     }
 }
 
-Clasp::LitVec ClingoControl::toClaspAssumptions(Gringo::Control::Assumptions &&ass) const {
+Clasp::LitVec ClingoControl::toClaspAssumptions(Gringo::Control::Assumptions &&ass) {
     Clasp::LitVec outAss;
+    assumptions_ = std::move(ass);
+    assumptionLits_.clear();
     if (!clingoMode_ || !clasp->program()) { return outAss; }
     const Clasp::Asp::LogicProgram* prg = static_cast<const Clasp::Asp::LogicProgram*>(clasp->program());
-    for (auto &x : ass) {
+    for (unsigned i = 0; i < assumptions_.size(); ++i) {
+        auto &x = assumptions_[i];
         auto atm = out->find2(x.first);
         if (atm && atm->second.hasUid()) {
             Clasp::Literal lit = prg->getLiteral(atm->second.uid());
             outAss.push_back(x.second ? lit : ~lit);
+            assumptionLits_.emplace_back(outAss.back(), i);
         }
         else if (x.second) {
             Clasp::Literal lit = prg->getLiteral(1);
             outAss.push_back(lit);
+            assumptionLits_.emplace_back(lit, i);
             break;
         }
     }
     return outAss;
 }
 
+Gringo::Control::Assumptions ClingoControl::unsatCore(bool minimize, double timeLimit) {
+    Assumptions ret;
+    if (!clingoMode_ || clasp->solving() || !clasp->result().unsat()) { return ret; }
+    // the user assumptions come last; the ones before stem from the program
+    Clasp::LitVec const &ass = clasp->assumptions();
+    Clasp::LitVec fixed(ass.begin(), ass.end() - assumptionLits_.size());
+    Clasp::LitVec user(ass.end() - assumptionLits_.size(), ass.end());
+    Clasp::LitVec core;
+    if (Clasp::LitVec const *claspCore = clasp->unsatCore()) {
+        std::sort(user.begin(), user.end());
+        for (auto &lit : *claspCore) {
+            if (std::binary_search(user.begin(), user.end(), lit)) { core.push_back(lit); }
+        }
+    }
+    else { core.swap(user); }
+    if (minimize && clasp->ctx.ok()) { minimizeCore(fixed, core, timeLimit); }
+    std::sort(core.begin(), core.end());
+    for (auto &x : assumptionLits_) {
+        if (std::binary_search(core.begin(), core.end(), x.first)) { ret.emplace_back(assumptions_[x.second]); }
+    }
+    return ret;
+}
+
+void ClingoControl::minimizeCore(Clasp::LitVec const &fixed, Clasp::LitVec &core, double timeLimit) {
+    Clasp::Solver &solver = *clasp->ctx.master();
+    double stop = Clasp::RealTime::getTime() + timeLimit;
+    auto timeout = [stop, timeLimit]() { return timeLimit > 0 && Clasp::RealTime::getTime() >= stop; };
+    Clasp::SolveLimits limits;
+    Clasp::BasicSolve solve(solver, clasp->ctx.configuration()->search(0), &limits);
+    Clasp::LitVec path, next;
+    // deletion-based: drop one assumption at a time and keep it if the
+    // remaining ones become satisfiable
+    for (unsigned i = 0; i < core.size() && !timeout(); ) {
+        path = fixed;
+        for (unsigned j = 0; j < core.size(); ++j) {
+            if (j != i) { path.push_back(core[j]); }
+        }
+        if (!solver.clearAssumptions()) { break; }
+        Clasp::ValueRep res = Clasp::value_false;
+        if (solve.assume(path)) {
+            solve.reset();
+            do {
+                limits = Clasp::SolveLimits(1000);
+                res    = solve.solve();
+            }
+            while (res == Clasp::value_free && !timeout());
+        }
+        if (res == Clasp::value_free) { break; }
+        else if (res == Clasp::value_false) {
+            // the core of the reduced problem might drop further assumptions
+            solve.unsatCore(path, next);
+            std::sort(next.begin(), next.end());
+            core.erase(core.begin() + i);
+            core.erase(std::remove_if(core.begin(), core.end(), [&next](Clasp::Literal lit) {
+                return !std::binary_search(next.begin(), next.end(), lit);
+            }), core.end());
+        }
+        else { ++i; }
+    }
+    solver.clearAssumptions();
+}
+
 Gringo::SolveResult ClingoControl::solve(ModelHandler h, Assumptions &&ass) {
     prepare_(h, nullptr);
     clasp->assume(toClaspAssumptions(std::move(ass)));
@@ -370,7 +611,35 @@ void ClingoControl::cleanupDomains() {
             else if (solver.isFalse(lit)) { truth = Gringo::TruthValue::False; }
             return std::make_pair(prg.isExternal(uid), truth);
         };
-        auto stats = out->simplify(assignment);
+        // index atoms added since the last call by their variables
+        for (unsigned uid = atomsIndexed_ + 1, end = prg.numAtoms(); uid <= end; ++uid) {
+            Clasp::Var v = prg.getLiteral(uid).var();
+            if (v == 0) { continue; }
+            if (varAtoms_.size() <= v)   { varAtoms_.resize(v + 1, 0); }
+            if (nextAtom_.size() <= uid) { nextAtom_.resize(uid + 1, 0); }
+            nextAtom_[uid] = varAtoms_[v];
+            varAtoms_[v]   = uid + 1;
+        }
+        atomsIndexed_ = prg.numAtoms();
+        // collect atoms whose variables were assigned on the top level since the last call
+        // NOTE: the solver only removes auxiliary variables and the step literal from its top level,
+        //       hence the last problem variable seen is found at or before its old position;
+        //       if it is not found (e.g. after a reset), the whole top level is checked
+        Clasp::LitVec const &trail = solver.trail();
+        unsigned end = solver.decisionLevel() == 0 ? trail.size() : solver.levelStart(1);
+        unsigned pos = std::min(trailChecked_, end);
+        while (pos > 0 && trail[pos - 1] != trailLast_) { --pos; }
+        std::vector<unsigned> changed;
+        Clasp::Var step = clasp->ctx.stepLiteral().var();
+        for (; pos != end; ++pos) {
+            Clasp::Var v = trail[pos].var();
+            if (v < varAtoms_.size()) {
+                for (unsigned a = varAtoms_[v]; a; a = nextAtom_[a - 1]) { changed.emplace_back(a - 1); }
+            }
+            if (v <= clasp->ctx.numVars() && v != step) { trailLast_ = trail[pos]; }
+        }
+        trailChecked_ = end;
+        auto stats = out->simplify(assignment, changed);
         LOG << stats.first << " atom" << (stats.first == 1 ? "" : "s") << " became facts" << std::endl;
         LOG << stats.second << " atom" << (stats.second == 1 ? "" : "s") << " deleted" << std::endl;
     }
@@ -412,6 +681,17 @@ static bool skipDomain(Gringo::FWSignature sig) {
     return (strncmp((*(*sig).name()).c_str(), "#", 1) == 0);
 }
 
+static bool isExternal(Gringo::PredicateDomain::element_type const &elem, Clasp::Asp::LogicProgram const &prg) {
+    return elem.second.hasUid() && elem.second.isExternal() && prg.isExternal(elem.second.uid());
+}
+
+static unsigned elementFlags(Gringo::PredicateDomain::element_type const &elem, Clasp::Asp::LogicProgram const &prg) {
+    unsigned flags = Gringo::DomainProxy::FOUND;
+    if (elem.second.fact(false)) { flags |= Gringo::DomainProxy::FACT; }
+    if (isExternal(elem, prg))   { flags |= Gringo::DomainProxy::EXTERNAL; }
+    return flags;
+}
+
 struct ClingoDomainElement : Gringo::DomainProxy::Element {
     using ElemIt = Gringo::PredicateDomain::element_vec::iterator;
     using DomIt = Gringo::PredDomMap::iterator;
@@ -430,10 +710,7 @@ struct ClingoDomainElement : Gringo::DomainProxy::Element {
         return elemIt->get().second.fact(false);
     }
     bool external() const {
-        return 
-            elemIt->get().second.hasUid() && 
-            elemIt->get().second.isExternal() &&
-            prg.isExternal(elemIt->get().second.uid());
+        return isExternal(elemIt->get(), prg);
     }
     Gringo::DomainProxy::ElementPtr next() {
         auto domIe  = out.domains.end();
@@ -512,6 +789,35 @@ Gringo::DomainProxy::ElementPtr ClingoControl::lookup(Gringo::Value const &atom)
     return nullptr;
 }
 
+size_t ClingoControl::scan(Gringo::Signature const &sig, size_t offset, size_t size, Gringo::Value *atoms, unsigned *flags) const {
+    auto it = out->domains.find(sig);
+    if (it == out->domains.end()) { return 0; }
+    auto &prg    = static_cast<Clasp::Asp::LogicProgram const &>(*clasp->program());
+    auto &elems  = it->second.exports.exports;
+    size_t begin = std::min(offset, elems.size());
+    size_t end   = begin + std::min(size, elems.size() - begin);
+    for (size_t i = begin; i != end; ++i) {
+        auto &elem = elems[i].get();
+        *atoms++ = elem.first;
+        *flags++ = elementFlags(elem, prg);
+    }
+    return end - begin;
+}
+
+void ClingoControl::lookup(Gringo::Value const *atoms, size_t size, unsigned *flags) const {
+    auto &prg = static_cast<Clasp::Asp::LogicProgram const &>(*clasp->program());
+    auto it   = out->domains.end();
+    for (auto ie = atoms + size; atoms != ie; ++atoms, ++flags) {
+        *flags = 0;
+        if (!atoms->hasSig()) { continue; }
+        if (it == out->domains.end() || !(it->first == atoms->sig())) { it = out->domains.find(atoms->sig()); }
+        if (it != out->domains.end()) {
+            auto jt = it->second.domain.find(*atoms);
+            if (jt != it->second.domain.end()) { *flags = elementFlags(*jt, prg); }
+        }
+    }
+}
+
 size_t ClingoControl::length() const {
     size_t ret = 0;
     for (auto &dom : out->domains) {
@@ -522,6 +828,11 @@ size_t ClingoControl::length() const {
     return ret;
 }
 
+size_t ClingoControl::length(Gringo::Signature const &sig) const {
+    auto it = out->domains.find(sig);
+    return it != out->domains.end() ? it->second.exports.exports.size() : 0;
+}
+
 // {{{1 definition of ClingoStatistics
 
 Gringo::Statistics::Quantity ClingoStatistics::getStat(char const* key) const {
@@ -561,6 +872,69 @@ Gringo::SolveResult ClingoSolveIter::get() {
 ClingoSolveIter::~ClingoSolveIter() = default;
 #endif
 
+// {{{1 definition of ClingoStoredModel
+
+void ClingoStoredModel::assign(ClingoModel const &m) {
+    shown     = m.atoms(SHOWN);
+    trueAtoms = m.atoms(ATOMS);
+    std::sort(trueAtoms.begin(), trueAtoms.end());
+    costs     = m.optimization();
+}
+bool ClingoStoredModel::contains(Gringo::Value atom) const {
+    return std::binary_search(trueAtoms.begin(), trueAtoms.end(), atom);
+}
+Gringo::ValVec ClingoStoredModel::atoms(int atomset) const {
+    if (atomset == SHOWN) { return shown; }
+    if (atomset == ATOMS) { return trueAtoms; }
+    throw std::runtime_error("queued models only provide the shown atoms or all atoms");
+}
+void ClingoStoredModel::addClause(LitVec const &) const {
+    throw std::runtime_error("clauses cannot be added to queued models");
+}
+
+// {{{1 definition of ClingoQueuedSolveIter
+
+#if WITH_THREADS
+ClingoQueuedSolveIter::ClingoQueuedSolveIter(Clasp::ClaspFacade &clasp, Clasp::Asp::LogicProgram const &lp, Gringo::Output::OutputBase const &out, unsigned queueSize)
+    : model(lp, out, clasp.ctx)
+    , queue(queueSize)
+    , future(clasp.solveAsync(this)) { }
+Gringo::Model const *ClingoQueuedSolveIter::next() {
+    if (popFront) {
+        queue.pop();
+        popFront = false;
+    }
+    ClingoStoredModel *m = queue.front();
+    popFront = m != nullptr;
+    return m;
+}
+void ClingoQueuedSolveIter::close() {
+    queue.close();
+    future.cancel();
+}
+Gringo::SolveResult ClingoQueuedSolveIter::get() {
+    // the solver might be blocked on a full queue - let it stop at its next
+    // model instead of waiting forever; buffered models remain accessible
+    queue.close();
+    return convert(future.get());
+}
+bool ClingoQueuedSolveIter::onModel(Clasp::Solver const &, Clasp::Model const &m) {
+    ClingoStoredModel *slot = queue.back();
+    if (!slot) { return false; }
+    model.reset(m);
+    slot->assign(model);
+    queue.push();
+    return true;
+}
+void ClingoQueuedSolveIter::onEvent(Clasp::Event const &ev) {
+    if (Clasp::event_cast<Clasp::ClaspFacade::StepReady>(ev)) { queue.close(); }
+}
+ClingoQueuedSolveIter::~ClingoQueuedSolveIter() {
+    close();
+    future.wait();
+}
+#endif
+
 // {{{1 definition of ClingoSolveFuture
 
 Gringo::SolveResult convert(Clasp::ClaspFacade::Result res) {
@@ -573,8 +947,9 @@ Gringo::SolveResult convert(Clasp::ClaspFacade::Result res) {
 }
 
 #if WITH_THREADS
-ClingoSolveFuture::ClingoSolveFuture(Clasp::ClaspFacade::AsyncResult const &res)
-    : future(res) { }
+ClingoSolveFuture::ClingoSolveFuture(ClingoControl &ctl, Clasp::ClaspFacade::AsyncResult const &res)
+    : ctl(ctl)
+    , future(res) { }
 Gringo::SolveResult ClingoSolveFuture::get() {
     if (!done) { 
         bool stop = future.interrupted() == SIGINT;
@@ -593,6 +968,10 @@ bool ClingoSolveFuture::wait(double timeout) {
     return true;
 }
 void ClingoSolveFuture::cancel() { future.cancel(); }
+std::vector<std::pair<Gringo::Value, bool>> ClingoSolveFuture::unsatCore(bool minimize, double timeLimit) {
+    get();
+    return ctl.unsatCore(minimize, timeLimit);
+}
 ClingoSolveFuture::~ClingoSolveFuture() { }
 #endif
 
@@ -644,8 +1023,12 @@ void ClingoLib::initOptions(ProgramOptions::OptionContext& root) {
          "      [no-]file-included:         #include \"a.lp\". #include \"a.lp\".\n"
          "      [no-]operation-undefined:   p(1/0).\n"
          "      [no-]variable-unbounded:    $x > 10.\n"
-         "      [no-]global-variable:       :- #count { X } = 1, X = 1.\n")
+         "      [no-]global-variable:       :- #count { X } = 1, X = 1.\n"
+         "      [no-]query-ignored:         #query p. { p }.\n")
         ("rewrite-minimize"         , flag(grOpts_.rewriteMinimize = false), "Rewrite minimize constraints into rules")
+        ("translate-csp"            , flag(grOpts_.translateCsp = false), "Translate linear constraints into rules instead of propagating them")
+        ("native-aggregates"        , flag(grOpts_.nativeAggregates = false), "Pass non-recursive aggregates to the solver as weight constraints")
+        ("dedup-rules"              , storeTo(grOpts_.dedupRules = 0)->arg("<n>"), "Drop duplicate and subsumed rules among the last %A rules of a step")
         ;
     root.add(gringo);
     claspConfig_.addOptions(root);
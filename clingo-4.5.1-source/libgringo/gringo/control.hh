@@ -111,6 +111,9 @@ struct SolveFuture {
     virtual void wait() = 0;
     virtual bool wait(double timeout) = 0;
     virtual void cancel() = 0;
+    // Waits for the search to finish and returns its unsatisfiable core (see
+    // Control::unsatCore).
+    virtual std::vector<std::pair<Value, bool>> unsatCore(bool minimize, double timeLimit) = 0;
     virtual ~SolveFuture() { }
 };
 
@@ -139,6 +142,9 @@ struct ConfigProxy {
 // {{{1 declaration of DomainProxy
 
 struct DomainProxy {
+    static const unsigned FOUND    = 1;
+    static const unsigned FACT     = 2;
+    static const unsigned EXTERNAL = 4;
     struct Element;
     using ElementPtr = std::unique_ptr<Element>;
     struct Element {
@@ -152,8 +158,16 @@ struct DomainProxy {
     virtual ElementPtr iter(Signature const &sig) const = 0;
     virtual ElementPtr iter() const = 0;
     virtual ElementPtr lookup(Value const &atom) const = 0;
+    // Copies at most size atoms of the domain of sig starting at position
+    // offset into atoms and their flags into flags; returns the number of
+    // copied atoms.
+    virtual size_t scan(Signature const &sig, size_t offset, size_t size, Value *atoms, unsigned *flags) const = 0;
+    // Stores the flags of the size given atoms in flags.
+    virtual void lookup(Value const *atoms, size_t size, unsigned *flags) const = 0;
     virtual std::vector<FWSignature> signatures() const = 0;
     virtual size_t length() const = 0;
+    // Returns the number of atoms in the domain of sig.
+    virtual size_t length(Signature const &sig) const = 0;
     virtual ~DomainProxy() { }
 };
 
@@ -175,9 +189,12 @@ struct Control {
     virtual void ground(GroundVec const &vec, Any &&context) = 0;
     virtual SolveResult solve(ModelHandler h, Assumptions &&assumptions) = 0;
     virtual SolveFuture *solveAsync(ModelHandler mh, FinishHandler fh, Assumptions &&assumptions) = 0;
-    virtual SolveIter *solveIter(Assumptions &&assumptions) = 0;
+    // If queueSize is non-zero, the solver runs ahead of the iterator
+    // buffering up to queueSize models. Throws if the size is too large.
+    virtual SolveIter *solveIter(Assumptions &&assumptions, unsigned queueSize) = 0;
     virtual void add(std::string const &name, FWStringVec const &params, std::string const &part) = 0;
     virtual void load(std::string const &filename) = 0;
+    virtual void loadFacts(std::string const &filename, FWString predicate, std::string const &format, bool header) = 0;
     virtual Value getConst(std::string const &name) = 0;
     virtual bool blocked() = 0;
     virtual void assignExternal(Value ext, TruthValue val) = 0;
@@ -185,6 +202,10 @@ struct Control {
     virtual void useEnumAssumption(bool enable) = 0;
     virtual bool useEnumAssumption() = 0;
     virtual void cleanupDomains() = 0;
+    // Returns the assumptions of the last unsatisfiable search the result
+    // depends on; if minimize is true, redundant assumptions are removed for
+    // at most timeLimit seconds (0 means no limit).
+    virtual Assumptions unsatCore(bool minimize, double timeLimit) = 0;
     virtual ~Control() { }
 };
 
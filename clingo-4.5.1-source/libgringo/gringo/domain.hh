@@ -67,6 +67,8 @@ struct Exports {
     unsigned    incOffset      = 0;
     //! Used to decouple symbol table generation from grounding
     unsigned    showOffset     = 0;
+    //! Divides elements already looked up by OutputBase::simplify from new ones.
+    unsigned    simplifyOffset = 0;
 };
 
 // }}}
@@ -304,6 +306,7 @@ void Exports<Element>::clear() {
     nextGeneration_ = 0;
     incOffset      = 0;
     showOffset     = 0;
+    simplifyOffset = 0;
 }
 
 // }}}
@@ -535,7 +538,7 @@ inline bool AtomState::fact(bool) const       { return _uid < 0; }
 inline void AtomState::setFact(bool x)        { if (x != fact(false)) { _uid = -_uid; } }
 inline bool AtomState::defined() const        { return std::abs(_generation) > 1; }
 inline unsigned AtomState::generation() const { return std::abs(_generation) - 2; }
-inline void AtomState::generation(unsigned x) { _generation = x + 2; }
+inline void AtomState::generation(unsigned x) { _generation = _generation < 0 ? -int(x) - 2 : int(x) + 2; }
 inline bool AtomState::isFalse() const        { return _uid == 0; }
 inline std::pair<Value const,AtomState> &AtomState::ignore() {
     static AbstractDomain<AtomState>::element_type x{{Value::createId("#false")}, {nullptr}};
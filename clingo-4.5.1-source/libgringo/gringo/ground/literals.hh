@@ -46,6 +46,18 @@ inline double estimate(unsigned size, Term const &term, Term::VarSet const &boun
 
 // {{{ declaration of RangeLiteral
 
+// A comparison m*X+n rel term restricting the variable X of a range literal.
+struct RangeBound {
+    RangeBound(Relation rel, int m, int n, Term const &term);
+
+    Relation rel;
+    int m;
+    int n;
+    Term const *term;
+    Term::VarSet vars;
+};
+using RangeBoundVec = std::vector<RangeBound>;
+
 using RangeLiteralShared = std::pair<UTerm, UTerm>;
 struct RangeLiteral : Literal {
     RangeLiteral(UTerm &&assign, UTerm &&left, UTerm &&right);
@@ -60,8 +72,16 @@ struct RangeLiteral : Literal {
 
     UTerm assign;
     RangeLiteralShared range;
+    RangeBoundVec bounds;
 };
 
+// Collects the comparisons among lits that restrict the variables assigned by
+// range literals. Equalities between variables are followed, e.g., in
+// #Range0=1..T,X=#Range0,X>7 the interval is narrowed to 8..T. Comparisons
+// whose other side is bound when the range literal is instantiated narrow
+// its interval before it is enumerated.
+void narrowRanges(std::vector<Literal*> const &lits);
+
 // }}}
 // {{{ declaration of ScriptLiteral
 
@@ -24,6 +24,7 @@
 #include <gringo/ground/literals.hh>
 #include <gringo/output/statements.hh>
 #include <gringo/intervals.hh>
+#include <gringo/termcode.hh>
 
 namespace Gringo { namespace Ground {
 
@@ -33,12 +34,14 @@ struct HeadDefinition : HeadOccurrence {
     HeadDefinition(UTerm &&repr, Domain *domain);
     HeadDefinition(HeadDefinition &&) = default;
     UGTerm getRepr() const;
+    Value eval(bool &undefined) const;
     void collectImportant(Term::VarSet &vars);
     void enqueue(Queue &queue);
     virtual void defines(IndexUpdater &update, Instantiator *inst);
     virtual ~HeadDefinition();
 
     UTerm repr;
+    mutable TermCode code;
     using OffsetMap = std::unordered_map<IndexUpdater*, unsigned>;
     using RInstVec = std::vector<std::reference_wrapper<Instantiator>>;
     using EnqueueVec = std::vector<std::pair<IndexUpdater*, RInstVec>>;
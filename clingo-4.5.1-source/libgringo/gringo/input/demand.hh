@@ -0,0 +1,54 @@
+// {{{ GPL License
+
+// This file is part of gringo - a grounder for logic programs.
+// Copyright (C) 2013  Roland Kaminski
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// }}}
+
+#ifndef _GRINGO_INPUT_DEMAND_HH
+#define _GRINGO_INPUT_DEMAND_HH
+
+#include <gringo/input/literal.hh>
+#include <gringo/input/statement.hh>
+
+namespace Gringo { namespace Input {
+
+// {{{ declaration of rewriteDemand
+
+// Applies the magic set transformation to the statements of a program part
+// such that rules are only instantiated as far as needed to derive the atoms
+// matching the given query atoms.
+//
+// Predicates defined by positive rules (with predicate literals and
+// comparisons in the body) that are reachable from a query are rewritten
+// with the binding patterns of the query: arguments without variables are
+// bound and further bindings are passed from left to right through the rule
+// bodies. Predicates used by any other statement of the part are grounded in
+// full; so are the predicates in negated, which occur classically negated in
+// the program, and their complements because they are used by the constraints
+// discarding inconsistent interpretations. Returns false if the part contains statements that cannot be
+// analyzed; the statements are left untouched in this case.
+//
+// NOTE: atoms of rewritten predicates that are not relevant for the queries
+//       are not derived; the queries have to cover all uses of these
+//       predicates outside of the program part
+bool rewriteDemand(ULitVec const &queries, UStmVec &stms, std::vector<FWSignature> const &negated);
+
+// }}}
+
+} } // namespace Input Gringo
+
+#endif // _GRINGO_INPUT_DEMAND_HH
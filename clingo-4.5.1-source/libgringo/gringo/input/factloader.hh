@@ -0,0 +1,94 @@
+// {{{ GPL License
+
+// This file is part of gringo - a grounder for logic programs.
+// Copyright (C) 2013  Roland Kaminski
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// }}}
+
+#ifndef _GRINGO_INPUT_FACTLOADER_HH
+#define _GRINGO_INPUT_FACTLOADER_HH
+
+#include <gringo/value.hh>
+#include <functional>
+#include <memory>
+
+namespace Gringo { namespace Input {
+
+// {{{ declaration of FactFormat
+
+// CSV:    comma separated values, one tuple per line
+// TSV:    tab separated values, one tuple per line
+// BINARY: columnar binary format (see FactLoader)
+enum class FactFormat { CSV, TSV, BINARY };
+
+// maps a format name ("csv", "tsv", "bin") to a format
+// an empty name selects the format based on the file extension
+FactFormat factFormat(std::string const &format, std::string const &filename);
+
+// }}}
+// {{{ declaration of FactLoader
+
+// Reads tuples of a delimited or binary columnar file and turns each of them
+// into an atom over a given predicate name.
+//
+// Fields of delimited files are mapped to numbers if they are integers, to
+// constants if they are identifiers, and to strings otherwise. Quoted fields
+// are always strings; a quote inside a quoted field is written as "". Quoted
+// fields must not contain line breaks.
+//
+// Binary files (all integers little endian) consist of
+// - the magic string "GCOL",
+// - a 32 bit version (1), a 32 bit column count, and a 64 bit row count,
+// - one byte per column giving its type (0 = 32 bit integer, 1 = constant, 2 = string),
+// - the columns one after the other; an integer column stores one integer
+//   per row, the other columns store row count + 1 64 bit offsets relative
+//   to the end of the offsets followed by the characters of all rows.
+//
+// Parsing is split into tasks that can be run in parallel by a FactRunner.
+// Only numbers are converted in the tasks; constants and strings are
+// interned afterwards because symbols can only be created sequentially.
+using FactTasks  = std::vector<std::function<void ()>>;
+using FactRunner = std::function<void (FactTasks &)>;
+
+class FactLoader {
+public:
+    FactLoader(std::string const &filename, FactFormat format, bool header = false);
+    // calls out for each atom in the order of the rows in the file
+    void load(FWString name, unsigned tasks, FactRunner const &run, std::function<void (Value)> const &out);
+    ~FactLoader();
+
+    // runs the tasks one after the other
+    static void sequential(FactTasks &tasks);
+
+private:
+    struct Mapped;
+    struct Cell;
+    using CellVec = std::vector<Cell>;
+
+    void loadDelimited(FWString name, unsigned tasks, FactRunner const &run, std::function<void (Value)> const &out);
+    void loadBinary(FWString name, unsigned tasks, FactRunner const &run, std::function<void (Value)> const &out);
+
+    std::string             filename_;
+    std::unique_ptr<Mapped> file_;
+    FactFormat              format_;
+    bool                    header_;
+};
+
+// }}}
+
+} } // namespace Input Gringo
+
+#endif // _GRINGO_INPUT_FACTLOADER_HH
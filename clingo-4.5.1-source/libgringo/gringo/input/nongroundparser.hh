@@ -22,6 +22,7 @@
 #define _GRINGO_INPUT_NONGROUNDPARSER_HH
 
 #include <gringo/input/programbuilder.hh>
+#include <gringo/input/factloader.hh>
 #include <gringo/lexerstate.hh>
 #include <memory>
 #include <iosfwd>
@@ -39,6 +40,7 @@ public:
     NonGroundParser(INongroundProgramBuilder &pb);
     void parseError(Location const &loc, std::string const &token);
     void pushFile(std::string &&filename);
+    void pushFile(std::string &&filename, std::unique_ptr<std::istream> in);
     void pushStream(std::string &&name, std::unique_ptr<std::istream>);
     void pushBlock(std::string const &name, IdVec const &vec, std::string const &block);
     int lex(void *pValue, Location &loc);
@@ -46,6 +48,9 @@ public:
     bool parse();
     bool empty() { return LexerState::empty(); }
     void include(unsigned sUid, Location const &loc, bool include);
+    void facts(unsigned fUid, unsigned nameUid, Location const &loc);
+    void loadFacts(std::string const &filename, FWString name, std::string const &format, bool header);
+    void setFactRunner(unsigned tasks, FactRunner run);
     INongroundProgramBuilder &builder();
     // {{{ aggregate helper functions
     BoundVecUid boundvec(Relation ra, TermUid ta, Relation rb, TermUid tb);
@@ -57,6 +62,7 @@ public:
 
 private:
     int lex_impl(void *pValue, Location &loc);
+    bool fact(Location &loc);
     void lexerError(std::string const &token);
     bool push(std::string const &filename, bool include = false);
     bool push(std::string const &file, std::unique_ptr<std::istream> in);
@@ -67,6 +73,9 @@ private:
 private:
     std::set<std::string> filenames_;
     bool                  incmodeIncluded_ = false;
+    bool                  factStart_ = false;
+    unsigned              factTasks_ = 1;
+    FactRunner            factRunner_ = FactLoader::sequential;
     unsigned not_;
     INongroundProgramBuilder &pb_;
     struct Aggr
@@ -44,6 +44,7 @@ struct Block {
     ValVec          addedEdb;
     Ground::SEdb    edb;
     UStmVec         addedStms;
+    ULitVec         addedQueries;
     UStmVec         stms;
 };
 using BlockMap = unique_list<Block, identity<Term>>;
@@ -56,6 +57,8 @@ public:
     Program(Program &&x);
     void begin(Location const &loc, FWString name, IdVec &&params);
     void add(UStm &&stm);
+    void add(Value fact);
+    void addQuery(ULit &&lit);
     void addClassicalNegation(FWSignature x);
     void rewrite(Defines &defs);
     bool check();
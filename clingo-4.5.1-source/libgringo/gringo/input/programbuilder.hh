@@ -143,6 +143,7 @@ public:
     // {{{2 statements
     virtual void rule(Location const &loc, HdLitUid head) = 0;
     virtual void rule(Location const &loc, HdLitUid head, BdLitVecUid body) = 0;
+    virtual void fact(Location const &loc, Value atom) = 0;
     virtual void define(Location const &loc, FWString name, TermUid value, bool defaultDef) = 0;
     virtual void optimize(Location const &loc, TermUid weight, TermUid priority, TermVecUid cond, BdLitVecUid body) = 0;
     virtual void showsig(Location const &loc, FWSignature, bool csp) = 0;
@@ -151,6 +152,7 @@ public:
     virtual void lua(Location const &loc, FWString code) = 0;
     virtual void block(Location const &loc, FWString name, IdVecUid args) = 0;
     virtual void external(Location const &loc, LitUid head, BdLitVecUid body) = 0;
+    virtual void query(Location const &loc, LitUid lit) = 0;
     // }}}2
     virtual ~INongroundProgramBuilder() { }
 };
@@ -242,6 +244,7 @@ public:
     // {{{2 statements
     virtual void rule(Location const &loc, HdLitUid head);
     virtual void rule(Location const &loc, HdLitUid head, BdLitVecUid body);
+    virtual void fact(Location const &loc, Value atom);
     virtual void define(Location const &loc, FWString name, TermUid value, bool defaultDef);
     virtual void optimize(Location const &loc, TermUid weight, TermUid priority, TermVecUid cond, BdLitVecUid body);
     virtual void showsig(Location const &loc, FWSignature sig, bool csp);
@@ -250,6 +253,7 @@ public:
     virtual void lua(Location const &loc, FWString code);
     virtual void block(Location const &loc, FWString name, IdVecUid args);
     virtual void external(Location const &loc, LitUid head, BdLitVecUid body);
+    virtual void query(Location const &loc, LitUid lit);
     // }}}2
     virtual ~NongroundProgramBuilder();
 
@@ -39,6 +39,7 @@ enum Warnings {
     W_FILE_INCLUDED,         //< Same file included multiple times.
     W_VARIABLE_UNBOUNDED,    //< CSP Domain undefined.
     W_GLOBAL_VARIABLE,       //< Global variable in tuple of aggregate element.
+    W_QUERY_IGNORED,         //< Queries of a program part that cannot be rewritten.
     W_TOTAL,                 //< Not a warning but the total number of warnings.
 };
 
@@ -70,6 +70,15 @@ struct SumTranslator {
     ULitUintVec litsNegStrat;
 };
 
+// Passes aggregates as sum constraints to the outputter.
+// Each bound of a sum is handled by one constraint with possibly negative weights;
+// min and max aggregates are reduced to one constraint per excluded interval.
+// Constraints of recursive aggregates are passed as weight rules defining their auxiliary atom
+// so that the unfounded set check sees them; non-monotone recursive aggregates are not supported.
+struct NativeTranslator {
+    ULit translate(LparseTranslator &x, AggregateAnalyzer &res, AggregateFunction fun, ULitValVec &&elems, bool recursive);
+};
+
 ULit getEqualClause(LparseTranslator &x, ULitVec &&clause, bool conjunctive, bool equivalence);
 ULit getEqualClause(LparseTranslator &x, ULitVec const &clause, bool conjunctive, bool equivalence);
 ULit getEqualFormula(LparseTranslator &x, std::vector<ULitVec> const &clauses, bool conjunctive, bool equivalence);
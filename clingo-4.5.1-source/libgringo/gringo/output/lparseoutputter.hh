@@ -26,6 +26,7 @@
 #include <gringo/comparable.hh>
 #include <gringo/hashable.hh>
 #include <gringo/domain.hh>
+#include <stdexcept>
 
 namespace Gringo { namespace Output {
 
@@ -37,6 +38,9 @@ struct LparseOutputter {
     using AtomVec          = std::vector<unsigned>;
     using LitVec           = std::vector<int>;
     using LitWeightVec     = std::vector<std::pair<int, unsigned>>;
+    using OrderVec         = std::vector<std::pair<int, unsigned>>;
+    using LinearTermVec    = std::vector<std::pair<int, unsigned>>;
+    using LitCoefVec       = std::vector<std::pair<int, int>>;
 
     virtual unsigned falseUid() = 0;
     virtual unsigned newUid() = 0;
@@ -52,8 +56,27 @@ struct LparseOutputter {
     virtual void printExternal(unsigned atomUid, TruthValue type) = 0;
     virtual void finishSymbols() = 0;
     virtual bool &disposeMinimize() = 0;
+    // Linear constraints are only passed to the outputter if csp() returns true.
+    // Otherwise, they are translated into rules.
+    virtual bool csp() const { return false; }
+    // Adds an integer variable with the given values and order atoms and returns its id.
+    // The variable takes a value smaller than values[i].first iff atom values[i].second holds.
+    // The atom of the smallest value is 0.
+    virtual unsigned printOrderVariable(OrderVec const &) { throw std::logic_error("linear constraints not supported"); }
+    // Adds a linear constraint over variables returned by printOrderVariable.
+    // The head holds iff the weighted sum of the variables is at most the bound.
+    virtual void printLinearConstraint(unsigned, LinearTermVec const &, int) { throw std::logic_error("linear constraints not supported"); }
+    // Aggregates are only passed as sum constraints if nativeAggregates() returns true.
+    virtual bool nativeAggregates() const { return false; }
+    // Adds the constraint head == (sum(lits) >= bound).
+    // Weights may be negative.
+    virtual void printSumConstraint(unsigned, LitCoefVec const &, int) { throw std::logic_error("sum constraints not supported"); }
+    // Called before finishRules() with the number of rules of the current step
+    // that were dropped as duplicates or subsumed (see DedupLparseOutputter).
+    virtual void removedRules(unsigned) { }
     virtual ~LparseOutputter() { }
 };
+using ULparseOutputter = std::unique_ptr<LparseOutputter>;
 
 // }}}
 
@@ -24,6 +24,7 @@
 #include <gringo/output/statements.hh>
 #include <gringo/output/lparseoutputter.hh>
 #include <gringo/control.hh>
+#include <unordered_map>
 
 namespace Gringo { namespace Output {
 
@@ -50,6 +51,53 @@ struct PlainLparseOutputter : LparseOutputter {
     bool          disposeMinimize_ = true;
 };
 
+// Forwards rules to another outputter dropping rules that are equal to or
+// (for normal rules and integrity constraints) subsumed by one of the last
+// window rules of the current step. Bodies of normal and choice rules are
+// compared as sets; minimize statements are never dropped.
+struct DedupLparseOutputter : LparseOutputter {
+    DedupLparseOutputter(ULparseOutputter &&out, unsigned window);
+    virtual void incremental();
+    virtual void printBasicRule(unsigned head, LitVec const &body);
+    virtual void printChoiceRule(AtomVec const &head, LitVec const &body);
+    virtual void printCardinalityRule(unsigned head, unsigned lower, LitVec const &body);
+    virtual void printWeightRule(unsigned head, unsigned lower, LitWeightVec const &body);
+    virtual void printMinimize(LitWeightVec const &body);
+    virtual void printDisjunctiveRule(AtomVec const &head, LitVec const &body);
+    virtual unsigned falseUid();
+    virtual unsigned newUid();
+    virtual void finishRules();
+    virtual void printSymbol(unsigned atomUid, Value v);
+    virtual void printExternal(unsigned atomUid, TruthValue type);
+    virtual void finishSymbols();
+    virtual bool &disposeMinimize();
+    virtual bool csp() const;
+    virtual unsigned printOrderVariable(OrderVec const &order);
+    virtual void printLinearConstraint(unsigned head, LinearTermVec const &terms, int bound);
+    virtual bool nativeAggregates() const;
+    virtual void printSumConstraint(unsigned head, LitCoefVec const &lits, int bound);
+    virtual void removedRules(unsigned n);
+    virtual ~DedupLparseOutputter();
+
+private:
+    enum RuleKind : int { BASIC = 1, CHOICE = 3, CARDINALITY = 2, WEIGHT = 5, DISJUNCTIVE = 8 };
+    // rules are encoded as: kind, head, bound, body
+    // where head and body are sorted and heads are prefixed by their number
+    using Key = std::vector<int>;
+    bool add(Key const &key);
+    bool subsumed(Key const &key) const;
+    void evict(unsigned slot);
+    void clear();
+
+    ULparseOutputter                           out_;
+    std::vector<Key>                           ring_;
+    std::unordered_multimap<size_t, unsigned>  index_;
+    std::unordered_multimap<unsigned, unsigned> heads_;
+    Key                                        key_;
+    unsigned                                   next_    = 0;
+    unsigned                                   removed_ = 0;
+};
+
 struct StmHandler {
     virtual void operator()(Statement &x) = 0;
     // TODO: this should go into a statement!!
@@ -69,7 +117,9 @@ struct OutputBase {
     OutputBase(OutputPredicates &&outPreds, LparseOutputter &out, LparseDebug debug = LparseDebug::NONE);
     void output(Value const &val);
     
-    std::pair<unsigned, unsigned> simplify(AssignmentLookup assignment);
+    //! Marks atoms that became true as facts and removes atoms that became false.
+    //! Only atoms exported since the last call and the atoms with uids in changed are looked up.
+    std::pair<unsigned, unsigned> simplify(AssignmentLookup assignment, std::vector<unsigned> const &changed);
     void incremental();
     void createExternal(PredicateDomain::element_type &head);
     void assignExternal(PredicateDomain::element_type &head, TruthValue type);
@@ -90,6 +140,9 @@ struct OutputBase {
     UStmHandler       handler;
     OutputPredicates  outPreds;
     OutputPredicates  outPredsForce;
+    unsigned          outPredsChecked = 0;
+    ValVec            uidAtoms;   // atoms by uid (see simplify)
+    ValVec            uidPending; // atoms without uid when last simplified
 };
 
 } } // namespace Output Gringo
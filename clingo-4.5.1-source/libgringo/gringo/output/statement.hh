@@ -59,6 +59,7 @@ struct LparseTranslator {
     virtual ULit makeAux(NAF naf=NAF::POS) = 0;
     virtual ULit getTrueLit() = 0;
     virtual void simplify(AssignmentLookup assignment) = 0;
+    virtual bool nativeAggregates() const { return false; }
     virtual ~LparseTranslator() { }
 };
 
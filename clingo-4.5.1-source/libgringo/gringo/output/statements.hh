@@ -93,6 +93,27 @@ struct WeightRule : Statement {
     unsigned     lower;
 };
 
+// }}}
+// {{{ declaration of SumConstraint
+
+// Constraint head == (sum(body) >= bound) with
+// possibly negative weights that is passed to the outputter as is.
+struct SumConstraint : Statement {
+    using ULitWeightVec = std::vector<std::pair<ULit, int>>;
+
+    SumConstraint(SAuxAtom head, int bound, ULitWeightVec &&body);
+    virtual void printPlain(std::ostream &out) const;
+    virtual void toLparse(LparseTranslator &x);
+    virtual void printLparse(LparseOutputter &out) const;
+    virtual SumConstraint *clone() const;
+    virtual bool isIncomplete() const;
+    virtual ~SumConstraint();
+
+    SAuxAtom      head;
+    ULitWeightVec body;
+    int           bound;
+};
+
 // }}}
 // {{{ declaration of HeadAggregateState
 
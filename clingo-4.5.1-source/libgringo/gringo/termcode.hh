@@ -0,0 +1,75 @@
+// {{{ GPL License
+
+// This file is part of gringo - a grounder for logic programs.
+// Copyright (C) 2013  Roland Kaminski
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// }}}
+
+#ifndef _GRINGO_TERMCODE_HH
+#define _GRINGO_TERMCODE_HH
+
+#include <gringo/term.hh>
+
+namespace Gringo {
+
+// {{{ declaration of TermCode
+
+// Flat representation of a non-ground term after rewriting.
+// Evaluation runs over the term in postfix order and matching in prefix order
+// using a value stack instead of recursive virtual calls.
+// Subterms that are not known to the compiler are evaluated/matched via the
+// Term interface.
+// NOTE: the code refers to the compiled term, which has to outlive it
+class TermCode {
+public:
+    TermCode() = default;
+    TermCode(Term const &term);
+    bool empty() const { return evalCode_.empty(); }
+    Value eval(bool &undefined) const;
+    bool match(Value const &x) const;
+
+private:
+    // XOR to POW have to be in the same order as in BinOp
+    enum class Op : unsigned char { VAL, VAR, LINEAR, NEG, ABS, NOT, XOR, OR, AND, ADD, SUB, MUL, DIV, MOD, POW, FUN, TERM };
+    struct Instr {
+        Instr(Op op, Term const &term, Value val = Value(), Value *ref = nullptr, int m = 1, int n = 0, unsigned arity = 0)
+        : op(op), arity(arity), m(m), n(n), val(val), ref(ref), term(&term) { }
+        Op op;
+        unsigned arity;
+        int m;
+        int n;
+        Value val;
+        Value *ref;
+        Term const *term;
+    };
+    using InstrVec = std::vector<Instr>;
+
+    void compileEval(Term const &term);
+    void compileMatch(Term const &term);
+    static Value undefinedOp(Term const &term, bool &undefined);
+
+    InstrVec evalCode_;
+    InstrVec matchCode_;
+    // sized such that the code cannot overflow it
+    mutable ValVec stack_;
+    mutable ValVec args_;
+};
+
+// }}}
+
+} // namespace Gringo
+
+#endif // _GRINGO_TERMCODE_HH
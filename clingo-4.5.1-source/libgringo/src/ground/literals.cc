@@ -20,6 +20,7 @@
 
 #include "gringo/ground/literals.hh"
 #include "gringo/ground/binders.hh"
+#include "gringo/termcode.hh"
 #include "gringo/logger.hh"
 #include "gringo/scripts.hh"
 #include <cmath>
@@ -30,10 +31,16 @@ namespace {
 
 // {{{ declaration of RangeBinder
 
+// floor(n/d) for d > 0
+inline int64_t floorDiv(int64_t n, int64_t d) {
+    return n >= 0 ? n / d : -((-n + d - 1) / d);
+}
+
 struct RangeBinder : Binder {
-    RangeBinder(UTerm &&assign, RangeLiteralShared &range) 
+    RangeBinder(UTerm &&assign, RangeLiteralShared &range, std::vector<RangeBound const *> &&bounds) 
         : assign(std::move(assign))
-        , range(range) { }
+        , range(range)
+        , bounds(std::move(bounds)) { }
     virtual IndexUpdater *getUpdater() { return nullptr; }
     virtual void match() {
         bool undefined = false;
@@ -51,6 +58,56 @@ struct RangeBinder : Binder {
             current = 1;
             end     = 0;
         }
+        for (auto &x : bounds) {
+            if (current > end) { break; }
+            narrow(*x);
+        }
+    }
+    // Restricts the interval to the values X such that m*X+n rel term.
+    void narrow(RangeBound const &bound) {
+        bool undefined = false;
+        Value v(bound.term->eval(undefined));
+        int64_t lo = current, hi = end;
+        if (undefined) { hi = lo - 1; }
+        else if (v.type() != Value::NUM) {
+            // Note: numbers are greater than #inf and smaller than all other values
+            bool greater = Value::createNum(0) < v;
+            switch (bound.rel) {
+                case Relation::LT:
+                case Relation::LEQ: { if (!greater) { hi = lo - 1; } break; }
+                case Relation::GT:
+                case Relation::GEQ: { if (greater) { hi = lo - 1; } break; }
+                case Relation::EQ:  { hi = lo - 1; break; }
+                case Relation::NEQ: { break; }
+            }
+        }
+        else {
+            int64_t m = bound.m, d = int64_t(v.num()) - bound.n;
+            auto leq = [&](int64_t d) {
+                if (m > 0) { hi = std::min(hi, floorDiv(d, m)); }
+                else       { lo = std::max(lo, -floorDiv(d, -m)); }
+            };
+            auto geq = [&](int64_t d) {
+                if (m > 0) { lo = std::max(lo, -floorDiv(-d, m)); }
+                else       { hi = std::min(hi, floorDiv(-d, -m)); }
+            };
+            switch (bound.rel) {
+                case Relation::LT:  { leq(d - 1); break; }
+                case Relation::LEQ: { leq(d); break; }
+                case Relation::GT:  { geq(d + 1); break; }
+                case Relation::GEQ: { geq(d); break; }
+                case Relation::EQ:  { leq(d); geq(d); break; }
+                case Relation::NEQ: { break; }
+            }
+        }
+        if (lo <= hi) {
+            current = lo;
+            end     = hi;
+        }
+        else {
+            current = 1;
+            end     = 0;
+        }
     }
     virtual bool next() {
         // Note: if assign does not match it is not a variable and will not match at all
@@ -62,10 +119,11 @@ struct RangeBinder : Binder {
     virtual void print(std::ostream &out) const { out << *assign << "=" << *range.first << ".." << *range.second; }
     virtual ~RangeBinder() { }
 
-    UTerm               assign;
-    RangeLiteralShared &range;
-    int                 current = 0;
-    int                 end     = 0;
+    UTerm                           assign;
+    RangeLiteralShared             &range;
+    std::vector<RangeBound const *> bounds;
+    int                             current = 0;
+    int                             end     = 0;
     
 };
 
@@ -153,12 +211,14 @@ struct ScriptBinder : Binder {
 
 struct RelationMatcher : Binder {
     RelationMatcher(RelationShared &shared)
-        : shared(shared) { }
+        : shared(shared)
+        , left(*std::get<1>(shared))
+        , right(*std::get<2>(shared)) { }
     virtual IndexUpdater *getUpdater() { return nullptr; }
     virtual void match() {
         bool undefined = false;
-        Value l(std::get<1>(shared)->eval(undefined));
-        Value r(std::get<2>(shared)->eval(undefined));
+        Value l(left.eval(undefined));
+        Value r(right.eval(undefined));
         if (!undefined) {
             switch (std::get<0>(shared)) {
                 case Relation::GT:  { firstMatch = l >  r; break; }
@@ -182,6 +242,8 @@ struct RelationMatcher : Binder {
     virtual ~RelationMatcher() { }
     
     RelationShared &shared;
+    TermCode left;
+    TermCode right;
     bool firstMatch = false;
 };
 
@@ -191,13 +253,15 @@ struct RelationMatcher : Binder {
 struct AssignBinder : Binder {
     AssignBinder(UTerm &&lhs, Term &rhs)
         : lhs(std::move(lhs))
-        , rhs(rhs) { }
+        , rhs(rhs)
+        , lhsCode(*this->lhs)
+        , rhsCode(rhs) { }
     virtual IndexUpdater *getUpdater() { return nullptr; }
     virtual void match() { 
         bool undefined = false;
-        Value valRhs = rhs.eval(undefined);
+        Value valRhs = rhsCode.eval(undefined);
         if (!undefined) {
-            firstMatch = lhs->match(valRhs);
+            firstMatch = lhsCode.match(valRhs);
         }
         else { firstMatch = false; }
     }
@@ -211,6 +275,8 @@ struct AssignBinder : Binder {
     virtual void print(std::ostream &out) const { out << *lhs << "=" << rhs; }
     UTerm lhs;
     Term &rhs;
+    TermCode lhsCode;
+    TermCode rhsCode;
     bool firstMatch = false;
 };
 
@@ -274,6 +340,12 @@ ExternalBodyOcc::~ExternalBodyOcc()              { }
 
 // {{{ definition of *Literal::*Literal
 
+RangeBound::RangeBound(Relation rel, int m, int n, Term const &term)
+    : rel(rel)
+    , m(m)
+    , n(n)
+    , term(&term) { term.collect(vars); }
+
 RangeLiteral::RangeLiteral(UTerm &&assign, UTerm &&lower, UTerm &&upper)
     : assign(std::move(assign))
     , range(std::move(lower), std::move(upper)) { }
@@ -377,7 +449,13 @@ void CSPLiteral::collectImportant(Term::VarSet &vars) {
 // {{{ definition of *Literal::index
 
 UIdx RangeLiteral::index(Scripts &, BinderType, Term::VarSet &bound) {
-    if (assign->bind(bound)) { return make_unique<RangeBinder>(get_clone(assign), range); }
+    std::vector<RangeBound const *> narrow;
+    for (auto &x : bounds) {
+        if (std::all_of(x.vars.begin(), x.vars.end(), [&bound](FWString var) { return bound.find(var) != bound.end(); })) {
+            narrow.emplace_back(&x);
+        }
+    }
+    if (assign->bind(bound)) { return make_unique<RangeBinder>(get_clone(assign), range, std::move(narrow)); }
     else                     { return make_unique<RangeMatcher>(*assign, range); }
 }
 UIdx ScriptLiteral::index(Scripts &scripts, BinderType, Term::VarSet &bound) {
@@ -454,6 +532,70 @@ Output::Literal *CSPLiteral::toOutput() {
     return &repr;
 }
 
+// }}}
+// {{{ definition of narrowRanges
+
+namespace {
+
+VarTerm const *_linear(Term const &term, int &m, int &n) {
+    if (auto var = dynamic_cast<VarTerm const*>(&term)) {
+        m = 1;
+        n = 0;
+        return var;
+    }
+    if (auto lin = dynamic_cast<LinearTerm const*>(&term)) {
+        m = lin->m;
+        n = lin->n;
+        return lin->var.get();
+    }
+    return nullptr;
+}
+
+bool _isVar(Term const &term) {
+    int m, n;
+    return _linear(term, m, n) && m == 1 && n == 0;
+}
+
+} // namespace
+
+void narrowRanges(std::vector<Literal*> const &lits) {
+    std::vector<RelationShared const *> rels;
+    for (auto &lit : lits) {
+        if (auto rel = dynamic_cast<RelationLiteral const*>(lit)) { rels.emplace_back(&rel->shared); }
+    }
+    for (auto &lit : lits) {
+        auto range = dynamic_cast<RangeLiteral*>(lit);
+        if (!range) { continue; }
+        range->bounds.clear();
+        if (!_isVar(*range->assign)) { continue; }
+        std::unordered_set<FWString> alias{static_cast<VarTerm const&>(*range->assign).name};
+        for (bool changed = true; changed; ) {
+            changed = false;
+            for (auto &rel : rels) {
+                Term const &l = *std::get<1>(*rel), &r = *std::get<2>(*rel);
+                if (std::get<0>(*rel) == Relation::EQ && _isVar(l) && _isVar(r)) {
+                    FWString a = static_cast<VarTerm const&>(l).name, b = static_cast<VarTerm const&>(r).name;
+                    if ((alias.find(a) != alias.end()) != (alias.find(b) != alias.end())) {
+                        alias.emplace(a);
+                        alias.emplace(b);
+                        changed = true;
+                    }
+                }
+            }
+        }
+        auto add = [&](Relation rel, Term const &lhs, Term const &rhs) {
+            int m, n;
+            VarTerm const *var = _linear(lhs, m, n);
+            if (var && m != 0 && alias.find(var->name) != alias.end()) { range->bounds.emplace_back(rel, m, n, rhs); }
+        };
+        for (auto &rel : rels) {
+            if (std::get<0>(*rel) == Relation::NEQ) { continue; }
+            add(std::get<0>(*rel), *std::get<1>(*rel), *std::get<2>(*rel));
+            add(inv(std::get<0>(*rel)), *std::get<2>(*rel), *std::get<1>(*rel));
+        }
+    }
+}
+
 // }}}
 // {{{ definition of *Literal::~*Literal
 
@@ -92,6 +92,9 @@ InstVec _linearize(Scripts &scripts, bool positive, SolutionCallback &cb, Term::
         if (x->isRecursive() && x->occurrence() && !x->occurrence()->isNegative()) { rec.emplace_back(i); }
         ++i;
     }
+    std::vector<Literal*> body;
+    for (auto &x : todo.back()) { body.emplace_back(x.second); }
+    narrowRanges(body);
     todo.reserve(std::max(std::vector<unsigned>::size_type(1), rec.size()));
     insts.reserve(todo.capacity()); // Note: preserve references
     for (auto i : rec) {
@@ -229,6 +232,10 @@ std::ostream &operator <<(std::ostream &out, OccurrenceType x) {
 
 HeadDefinition::HeadDefinition(UTerm &&repr, Domain *domain) : repr(std::move(repr)), domain(domain) { }
 UGTerm HeadDefinition::getRepr() const { return repr->gterm(); }
+Value HeadDefinition::eval(bool &undefined) const {
+    if (code.empty()) { code = TermCode(*repr); }
+    return code.eval(undefined);
+}
 void HeadDefinition::defines(IndexUpdater &update, Instantiator *inst) {
     auto ret(offsets.emplace(&update, enqueueVec.size()));
     if (ret.second)     { enqueueVec.emplace_back(&update, RInstVec{}); }
@@ -324,7 +331,7 @@ void Rule::report(Output::OutputBase &out) {
             if (def.repr) {
                 // just insert the atom into the domain and report it to the output
                 bool undefined = false;
-                Value val(def.repr->eval(undefined));
+                Value val(def.eval(undefined));
                 if (!undefined) {
                     auto ret(static_cast<PredicateDomain*>(def.domain)->insert(val, false));
                     out.createExternal(*std::get<0>(ret));
@@ -340,7 +347,7 @@ void Rule::report(Output::OutputBase &out) {
             }
             if (def.repr) {
                 bool undefined = false;
-                Value val = def.repr->eval(undefined);
+                Value val = def.eval(undefined);
                 if (!undefined) {
                     auto ret(static_cast<PredicateDomain*>(def.domain)->insert(val, rule.body.empty()));
                     if (!std::get<2>(ret)) {
@@ -566,7 +573,7 @@ void BodyAggregateAccumulate::report(Output::OutputBase &out) {
     out.tempVals.clear();
     bool undefined = false;
     for (auto &x : tuple) { out.tempVals.emplace_back(x->eval(undefined)); }
-    Value repr(complete.def.repr->eval(undefined));
+    Value repr(complete.def.eval(undefined));
     if (!undefined) {
         out.tempLits.clear();
         for (auto &x : lits) {
@@ -978,13 +985,13 @@ bool ConjunctionAccumulateEmpty::isNormal() const {
 
 void ConjunctionAccumulateEmpty::report(Output::OutputBase &) {
     bool undefined = false;
-    Value repr(complete.def.repr->eval(undefined));
+    Value repr(complete.def.eval(undefined));
     auto &state = *complete.dom.domain.emplace(std::piecewise_construct, std::forward_as_tuple(repr), std::forward_as_tuple()).first;
     if (state.second.numBlocked == 0 && !state.second.defined() && !state.second.enqueued()) {
         state.second.enqueue();
         complete.todo.emplace_back(state);
     }
-    complete.domEmpty.insert(def.repr->eval(undefined), false);
+    complete.domEmpty.insert(def.eval(undefined), false);
     assert(!undefined);
 }
 
@@ -1009,8 +1016,8 @@ bool ConjunctionAccumulateCond::isNormal() const {
 
 void ConjunctionAccumulateCond::report(Output::OutputBase &) {
     bool undefined = false;
-    Value litRepr(complete.def.repr->eval(undefined));
-    Value condRepr(def.repr->eval(undefined));
+    Value litRepr(complete.def.eval(undefined));
+    Value condRepr(def.eval(undefined));
     assert(!undefined);
 
     auto &state = *complete.dom.domain.emplace(std::piecewise_construct, std::forward_as_tuple(litRepr), std::forward_as_tuple()).first;
@@ -1054,8 +1061,8 @@ bool ConjunctionAccumulateHead::isNormal() const {
 
 void ConjunctionAccumulateHead::report(Output::OutputBase &) {
     bool undefined = false;
-    Value litRepr(complete.def.repr->eval(undefined));
-    Value condRepr(def.repr->eval(undefined));
+    Value litRepr(complete.def.eval(undefined));
+    Value condRepr(def.eval(undefined));
     assert(!undefined);
 
     auto &state = *complete.dom.domain.find(litRepr);
@@ -1322,7 +1329,7 @@ void DisjointAccumulate::collectImportant(Term::VarSet &vars) {
 
 void DisjointAccumulate::report(Output::OutputBase &out) {
     bool undefined = false;
-    Value repr(complete.def.repr->eval(undefined));
+    Value repr(complete.def.eval(undefined));
     assert(!undefined);
     auto &state = *complete.domain.domain.emplace(std::piecewise_construct, std::forward_as_tuple(repr), std::forward_as_tuple()).first;
     if (!neutral) {
@@ -1405,7 +1412,7 @@ void HeadAggregateRule::report(Output::OutputBase &out) {
     }
     bool undefined = false;
     for (auto &x : bounds) { rule->bounds.emplace_back(x.rel, x.bound->eval(undefined)); }
-    auto ret(domain.domain.emplace(def.repr->eval(undefined), HeadAggregateState{fun, domain.exports.size()}));
+    auto ret(domain.domain.emplace(def.eval(undefined), HeadAggregateState{fun, domain.exports.size()}));
     assert(!undefined);
     if (ret.second) {
         _initBounds(bounds, ret.first->second.bounds);
@@ -1466,9 +1473,9 @@ void HeadAggregateAccumulate::report(Output::OutputBase &out) {
         if (auto lit = x->toOutput()) { out.tempLits.emplace_back(*lit); }
     }
     if (!undefined) {
-        Value predVal(predDef ? predDef->repr->eval(undefined) : Value());
+        Value predVal(predDef ? predDef->eval(undefined) : Value());
         if (!undefined) {
-            Value headVal(headRule.def.repr->eval(undefined));
+            Value headVal(headRule.def.eval(undefined));
             assert(!undefined);
             assert(headRule.domain.domain.find(headVal) != headRule.domain.domain.end());
             auto &state(headRule.domain.domain.find(headVal)->second);
@@ -1627,7 +1634,7 @@ void DisjunctionRule::report(Output::OutputBase &out) {
         state.second.enqueue();
         complete.todo.emplace_back(state.second);
     }
-    complete.domEmpty.insert(def.repr->eval(undefined), false);
+    complete.domEmpty.insert(def.eval(undefined), false);
     assert(!undefined);
 
     std::unique_ptr<Output::DisjunctionRule> rule(make_unique<Output::DisjunctionRule>());
@@ -1651,7 +1658,7 @@ DisjunctionAccumulateCond::~DisjunctionAccumulateCond() = default;
 void DisjunctionAccumulateCond::report(Output::OutputBase &) {
     bool undefined = false;
     Value litRepr(complete.repr->eval(undefined));
-    Value condRepr(def.repr->eval(undefined));
+    Value condRepr(def.eval(undefined));
     assert(!undefined);
 
     auto &state = *complete.dom.emplace(std::piecewise_construct, std::forward_as_tuple(litRepr), std::forward_as_tuple()).first;
@@ -1689,7 +1696,7 @@ void DisjunctionAccumulateHead::report(Output::OutputBase &) {
     bool undefined = false;
     Value litRepr(complete.repr->eval(undefined));
     assert(!undefined);
-    Value headRepr(def.repr->eval(undefined));
+    Value headRepr(def.eval(undefined));
     if (!undefined) {
         auto &state = *complete.dom.find(litRepr);
         auto &cond = *state.second.elems.find(headRepr.args()[2]);
@@ -0,0 +1,323 @@
+// {{{ GPL License
+
+// This file is part of gringo - a grounder for logic programs.
+// Copyright (C) 2013  Roland Kaminski
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// }}}
+
+#include "gringo/input/demand.hh"
+#include "gringo/input/literals.hh"
+#include "gringo/input/aggregates.hh"
+#include "gringo/logger.hh"
+#include <map>
+#include <set>
+
+namespace Gringo { namespace Input {
+
+// {{{ definition of rewriteDemand
+
+namespace {
+
+using SigSet  = std::set<FWSignature>;
+using SigVec  = std::vector<FWSignature>;
+using RuleVec = std::vector<Statement*>;
+using RuleMap = std::map<FWSignature, RuleVec>;
+using Demand  = std::pair<FWSignature, std::string>;
+
+UTermVec const &atomArgs(Term const &repr) {
+    static UTermVec const none;
+    if (auto t = dynamic_cast<UnOpTerm const*>(&repr))     { return atomArgs(*t->arg); }
+    if (auto t = dynamic_cast<FunctionTerm const*>(&repr)) { return t->args; }
+    return none;
+}
+
+// whether matching the term binds all of its variables
+bool binds(Term const &term) {
+    if (dynamic_cast<VarTerm const*>(&term) || dynamic_cast<ValTerm const*>(&term)) { return true; }
+    if (auto t = dynamic_cast<FunctionTerm const*>(&term)) {
+        for (auto &x : t->args) {
+            if (!binds(*x)) { return false; }
+        }
+        return true;
+    }
+    return false;
+}
+
+// whether all variables in the term are bound
+// (parameters of the program part are always bound)
+bool bound(Term const &term, Term::VarSet const &vars) {
+    Term::VarSet occ;
+    term.collect(occ);
+    for (auto &x : occ) {
+        if (*x == "_" || (x->compare(0, 4, "#Inc") != 0 && vars.find(x) == vars.end())) { return false; }
+    }
+    return true;
+}
+
+void bindVars(Term const &term, Term::VarSet &vars) {
+    Term::VarSet occ;
+    term.collect(occ);
+    for (auto &x : occ) {
+        if (*x != "_") { vars.emplace(x); }
+    }
+}
+
+UTerm demandAtom(Location const &loc, FWSignature sig, std::string const &adornment, UTermVec &&args) {
+    Signature s(*sig);
+    FWString name("#d_" + std::string(s.sign() ? "-" : "") + *s.name() + "_" + adornment);
+    if (args.empty()) { return make_locatable<ValTerm>(loc, Value::createId(name)); }
+    return make_locatable<FunctionTerm>(loc, name, std::move(args));
+}
+
+enum class Kind { HORN, OTHER, UNSUPPORTED };
+
+// classifies a statement and collects the predicates in its head and body
+Kind classify(Statement const &stm, SigVec &head, SigVec &body) {
+    auto hd = dynamic_cast<SimpleHeadLiteral const*>(stm.head.get());
+    if (!hd) { return Kind::UNSUPPORTED; }
+    bool horn = stm.type == StatementType::RULE && !stm.body.empty();
+    if (auto lit = dynamic_cast<PredicateLiteral const*>(hd->lit.get())) {
+        head.emplace_back(lit->repr->getSig());
+        horn = horn && (*(*head.back()).name()).compare(0, 1, "#") != 0;
+    }
+    else if (dynamic_cast<RelationLiteral const*>(hd->lit.get())) { horn = false; }
+    else { return Kind::UNSUPPORTED; }
+    for (auto &elem : stm.body) {
+        auto bd = dynamic_cast<SimpleBodyLiteral const*>(elem.get());
+        if (!bd) { return Kind::UNSUPPORTED; }
+        if (auto lit = dynamic_cast<PredicateLiteral const*>(bd->lit.get())) {
+            body.emplace_back(lit->repr->getSig());
+            horn = horn && lit->naf == NAF::POS;
+        }
+        else if (!dynamic_cast<RelationLiteral const*>(bd->lit.get())) { return Kind::UNSUPPORTED; }
+    }
+    return horn ? Kind::HORN : Kind::OTHER;
+}
+
+class DemandRewriter {
+public:
+    DemandRewriter(UStmVec &stms) : stms_(stms) { }
+    bool analyze(ULitVec const &queries, SigVec const &negated);
+    void rewrite(ULitVec const &queries);
+
+private:
+    void addFull(FWSignature sig);
+    void enqueue(FWSignature sig, std::string const &adornment);
+    void rewrite(Statement &rule, std::string const &adornment);
+
+    UStmVec        &stms_;
+    RuleMap         rules_;
+    SigSet          full_;
+    SigSet          demand_;
+    std::set<Demand> seen_;
+    std::vector<Demand> queue_;
+    UStmVec         out_;
+};
+
+void DemandRewriter::addFull(FWSignature sig) {
+    SigVec todo;
+    if (full_.emplace(sig).second) { todo.emplace_back(sig); }
+    while (!todo.empty()) {
+        auto it = rules_.find(todo.back());
+        todo.pop_back();
+        if (it == rules_.end()) { continue; }
+        for (auto &rule : it->second) {
+            SigVec head, body;
+            classify(*rule, head, body);
+            for (auto &x : body) {
+                if (full_.emplace(x).second) { todo.emplace_back(x); }
+            }
+        }
+    }
+}
+
+bool DemandRewriter::analyze(ULitVec const &queries, SigVec const &negated) {
+    // predicates occurring classically negated and their complements are used
+    // by the constraints added when the program is grounded
+    SigVec used;
+    for (auto &x : negated) {
+        used.emplace_back(x);
+        used.emplace_back((*x).flipSign());
+    }
+    for (auto &stm : stms_) {
+        SigVec head, body;
+        switch (classify(*stm, head, body)) {
+            case Kind::HORN: {
+                rules_[head.front()].emplace_back(stm.get());
+                break;
+            }
+            case Kind::OTHER: {
+                used.insert(used.end(), body.begin(), body.end());
+                break;
+            }
+            case Kind::UNSUPPORTED: {
+                GRINGO_REPORT(W_QUERY_IGNORED)
+                    << stm->loc() << ": info: queries ignored, statement not supported in demand-driven grounding:\n"
+                    << "  " << *stm << "\n";
+                return false;
+            }
+        }
+    }
+    // predicates reachable from the queries via positive rules
+    SigVec todo;
+    for (auto &query : queries) {
+        auto lit = dynamic_cast<PredicateLiteral const*>(query.get());
+        if (lit && rules_.find(lit->repr->getSig()) != rules_.end() && demand_.emplace(lit->repr->getSig()).second) { todo.emplace_back(lit->repr->getSig()); }
+    }
+    while (!todo.empty()) {
+        auto &rules = rules_[todo.back()];
+        todo.pop_back();
+        for (auto &rule : rules) {
+            SigVec head, body;
+            classify(*rule, head, body);
+            for (auto &x : body) {
+                if (rules_.find(x) != rules_.end() && demand_.emplace(x).second) { todo.emplace_back(x); }
+            }
+        }
+    }
+    // predicates used by statements that are not rewritten have to be complete
+    for (auto &x : rules_) {
+        if (demand_.find(x.first) == demand_.end()) {
+            for (auto &rule : x.second) {
+                SigVec head, body;
+                classify(*rule, head, body);
+                used.insert(used.end(), body.begin(), body.end());
+            }
+        }
+    }
+    for (auto &x : used) { addFull(x); }
+    for (auto &x : full_) { demand_.erase(x); }
+    return true;
+}
+
+void DemandRewriter::enqueue(FWSignature sig, std::string const &adornment) {
+    if (seen_.emplace(sig, adornment).second) { queue_.emplace_back(sig, adornment); }
+}
+
+void DemandRewriter::rewrite(Statement &rule, std::string const &adornment) {
+    Location const &loc(rule.loc());
+    auto &head = static_cast<PredicateLiteral&>(*static_cast<SimpleHeadLiteral&>(*rule.head).lit);
+    FWSignature sig(head.repr->getSig());
+    // the guard restricts the rule to demanded atoms
+    Term::VarSet vars;
+    UTermVec guardArgs;
+    auto it = adornment.begin();
+    for (auto &arg : atomArgs(*head.repr)) {
+        if (*it++ != 'b') { continue; }
+        if (binds(*arg)) {
+            bindVars(*arg, vars);
+            guardArgs.emplace_back(get_clone(arg));
+        }
+        else { guardArgs.emplace_back(make_locatable<VarTerm>(loc, FWString("_"), nullptr)); }
+    }
+    UTerm guard(demandAtom(loc, sig, adornment, std::move(guardArgs)));
+    // demand for the body literals is passed from left to right
+    ULitVec prefix;
+    for (auto &elem : rule.body) {
+        auto &lit = *static_cast<SimpleBodyLiteral&>(*elem).lit;
+        if (auto pred = dynamic_cast<PredicateLiteral const*>(&lit)) {
+            FWSignature bodySig(pred->repr->getSig());
+            bool include = true;
+            for (auto &arg : atomArgs(*pred->repr)) { include = include && (binds(*arg) || bound(*arg, vars)); }
+            if (demand_.find(bodySig) != demand_.end()) {
+                std::string bodyAdornment;
+                UTermVec args;
+                for (auto &arg : atomArgs(*pred->repr)) {
+                    if (bound(*arg, vars)) {
+                        bodyAdornment.push_back('b');
+                        args.emplace_back(get_clone(arg));
+                    }
+                    else { bodyAdornment.push_back('f'); }
+                }
+                UTerm demand(demandAtom(loc, bodySig, bodyAdornment, std::move(args)));
+                // a recursive call with the same bindings is already demanded
+                if (!prefix.empty() || !(*demand == *guard)) {
+                    UBodyAggrVec body;
+                    body.emplace_back(make_unique<SimpleBodyLiteral>(make_locatable<PredicateLiteral>(loc, NAF::POS, get_clone(guard))));
+                    for (auto &x : prefix) { body.emplace_back(make_unique<SimpleBodyLiteral>(get_clone(x))); }
+                    out_.emplace_back(make_locatable<Statement>(loc,
+                        make_unique<SimpleHeadLiteral>(make_locatable<PredicateLiteral>(loc, NAF::POS, std::move(demand))),
+                        std::move(body), StatementType::RULE));
+                }
+                enqueue(bodySig, bodyAdornment);
+            }
+            if (include) {
+                for (auto &arg : atomArgs(*pred->repr)) {
+                    if (binds(*arg)) { bindVars(*arg, vars); }
+                }
+                prefix.emplace_back(get_clone(&lit));
+            }
+        }
+        else if (auto rel = dynamic_cast<RelationLiteral const*>(&lit)) {
+            bool left = bound(*rel->left, vars), right = bound(*rel->right, vars);
+            auto assign = [&](Term const &lhs) {
+                auto var = dynamic_cast<VarTerm const*>(&lhs);
+                return rel->rel == Relation::EQ && var && *var->name != "_";
+            };
+            if      (left && right)                  { prefix.emplace_back(get_clone(&lit)); }
+            else if (right && assign(*rel->left))    { bindVars(*rel->left, vars); prefix.emplace_back(get_clone(&lit)); }
+            else if (left && assign(*rel->right))    { bindVars(*rel->right, vars); prefix.emplace_back(get_clone(&lit)); }
+        }
+    }
+    out_.emplace_back(make_locatable<Statement>(loc, get_clone(rule.head), get_clone(rule.body), rule.type));
+    out_.back()->add(make_locatable<PredicateLiteral>(loc, NAF::POS, std::move(guard)));
+}
+
+void DemandRewriter::rewrite(ULitVec const &queries) {
+    for (auto &x : stms_) {
+        SigVec head, body;
+        if (classify(*x, head, body) != Kind::HORN || demand_.find(head.front()) == demand_.end()) { out_.emplace_back(std::move(x)); }
+    }
+    for (auto &query : queries) {
+        auto lit = dynamic_cast<PredicateLiteral const*>(query.get());
+        if (!lit) { continue; }
+        FWSignature sig(lit->repr->getSig());
+        if (demand_.find(sig) == demand_.end()) { continue; }
+        std::string adornment;
+        UTermVec args;
+        for (auto &arg : atomArgs(*lit->repr)) {
+            if (bound(*arg, {})) {
+                adornment.push_back('b');
+                args.emplace_back(get_clone(arg));
+            }
+            else { adornment.push_back('f'); }
+        }
+        Location const &loc(lit->loc());
+        out_.emplace_back(make_locatable<Statement>(loc,
+            make_unique<SimpleHeadLiteral>(make_locatable<PredicateLiteral>(loc, NAF::POS, demandAtom(loc, sig, adornment, std::move(args)))),
+            UBodyAggrVec{}, StatementType::RULE));
+        enqueue(sig, adornment);
+    }
+    while (!queue_.empty()) {
+        Demand demand(queue_.back());
+        queue_.pop_back();
+        for (auto &rule : rules_[demand.first]) { rewrite(*rule, demand.second); }
+    }
+    stms_ = std::move(out_);
+}
+
+} // namespace
+
+bool rewriteDemand(ULitVec const &queries, UStmVec &stms, std::vector<FWSignature> const &negated) {
+    DemandRewriter rewriter(stms);
+    if (!rewriter.analyze(queries, negated)) { return false; }
+    rewriter.rewrite(queries);
+    return true;
+}
+
+// }}}
+
+} } // namespace Input Gringo
@@ -0,0 +1,390 @@
+// {{{ GPL License
+
+// This file is part of gringo - a grounder for logic programs.
+// Copyright (C) 2013  Roland Kaminski
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// }}}
+
+#include "gringo/input/factloader.hh"
+#include "gringo/utility.hh"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#if defined __unix__ || defined __APPLE__
+#  define GRINGO_FACTS_MMAP 1
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace Gringo { namespace Input {
+
+namespace {
+
+// number of bytes of delimited input parsed per round
+size_t const batchBytes = 64 << 20;
+// number of rows of binary input converted per round
+size_t const batchRows  = 1 << 20;
+
+bool endsWith(std::string const &str, char const *suffix) {
+    size_t n = strlen(suffix);
+    return str.size() >= n && str.compare(str.size() - n, n, suffix) == 0;
+}
+
+uint64_t readInt(char const *it, unsigned bytes) {
+    uint64_t ret = 0;
+    for (unsigned i = 0; i < bytes; ++i) { ret |= uint64_t(static_cast<unsigned char>(it[i])) << (8 * i); }
+    return ret;
+}
+
+bool isNumber(char const *begin, char const *end, int &num) {
+    bool neg = begin != end && *begin == '-';
+    if (neg) { ++begin; }
+    if (begin == end || end - begin > 10 || (*begin == '0' && end - begin > 1)) { return false; }
+    int64_t ret = 0;
+    for (; begin != end; ++begin) {
+        if (*begin < '0' || *begin > '9') { return false; }
+        ret = ret * 10 + (*begin - '0');
+    }
+    if (neg) { ret = -ret; }
+    if (ret < std::numeric_limits<int>::min() || ret > std::numeric_limits<int>::max()) { return false; }
+    num = static_cast<int>(ret);
+    return true;
+}
+
+bool isIdentifier(char const *begin, char const *end) {
+    while (begin != end && *begin == '_') { ++begin; }
+    if (begin == end || *begin < 'a' || *begin > 'z') { return false; }
+    for (; begin != end; ++begin) {
+        if (!std::isalnum(static_cast<unsigned char>(*begin)) && *begin != '_' && *begin != '\'') { return false; }
+    }
+    return true;
+}
+
+char const *nextLine(char const *it, char const *end) {
+    it = static_cast<char const *>(memchr(it, '\n', end - it));
+    return it ? it + 1 : end;
+}
+
+unsigned lineOf(char const *begin, char const *pos) {
+    return std::count(begin, pos, '\n') + 1;
+}
+
+} // namespace
+
+// {{{ definition of FactFormat
+
+FactFormat factFormat(std::string const &format, std::string const &filename) {
+    if (format == "csv") { return FactFormat::CSV; }
+    if (format == "tsv") { return FactFormat::TSV; }
+    if (format == "bin") { return FactFormat::BINARY; }
+    if (!format.empty()) { throw std::runtime_error("unknown fact format: " + format); }
+    if (endsWith(filename, ".tsv") || endsWith(filename, ".tab")) { return FactFormat::TSV; }
+    if (endsWith(filename, ".bin") || endsWith(filename, ".col")) { return FactFormat::BINARY; }
+    return FactFormat::CSV;
+}
+
+// }}}
+// {{{ definition of FactLoader::Mapped
+
+struct FactLoader::Mapped {
+    Mapped(std::string const &filename);
+    ~Mapped();
+
+    char const *data = nullptr;
+    size_t      size = 0;
+#ifdef GRINGO_FACTS_MMAP
+    void       *addr = nullptr;
+#else
+    std::string buffer;
+#endif
+};
+
+#ifdef GRINGO_FACTS_MMAP
+
+FactLoader::Mapped::Mapped(std::string const &filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) { throw std::runtime_error("file could not be opened: " + filename); }
+    struct stat sb;
+    if (fstat(fd, &sb) < 0) {
+        close(fd);
+        throw std::runtime_error("file could not be opened: " + filename);
+    }
+    size = sb.st_size;
+    if (size > 0) {
+        addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("file could not be mapped: " + filename);
+        }
+#ifdef MADV_SEQUENTIAL
+        madvise(addr, size, MADV_SEQUENTIAL);
+#endif
+        data = static_cast<char const *>(addr);
+    }
+    close(fd);
+}
+
+FactLoader::Mapped::~Mapped() {
+    if (addr) { munmap(addr, size); }
+}
+
+#else
+
+FactLoader::Mapped::Mapped(std::string const &filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) { throw std::runtime_error("file could not be opened: " + filename); }
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    buffer = ss.str();
+    data   = buffer.data();
+    size   = buffer.size();
+}
+
+FactLoader::Mapped::~Mapped() { }
+
+#endif
+
+// }}}
+// {{{ definition of FactLoader::Cell
+
+struct FactLoader::Cell {
+    enum Type : unsigned char { NUM, ID, STR, ESC };
+    Cell(Value num) : num(num), type(NUM) { }
+    Cell(Type type, char const *begin, char const *end) : begin(begin), length(end - begin), type(type) { }
+    Value value() const {
+        switch (type) {
+            case NUM: { return num; }
+            case ID:  { return Value::createId(std::string(begin, length)); }
+            case STR: { return Value::createStr(std::string(begin, length)); }
+            case ESC: { break; }
+        }
+        std::string str;
+        str.reserve(length);
+        for (char const *it = begin, *ie = begin + length; it != ie; ++it) {
+            str.push_back(*it);
+            if (*it == '"') { ++it; }
+        }
+        return Value::createStr(str);
+    }
+
+    Value       num;
+    char const *begin = nullptr;
+    unsigned    length = 0;
+    Type        type;
+};
+
+// }}}
+// {{{ definition of FactLoader
+
+namespace {
+
+// Parses the complete lines in [it, end) into cells; the number of cells of
+// each row is stored in sizes. Returns nullptr on success and the position of
+// the offending character otherwise.
+template <class CellVec>
+char const *parseRows(char const *it, char const *end, char sep, CellVec &cells, std::vector<unsigned> &sizes) {
+    using Cell = typename CellVec::value_type;
+    while (it != end) {
+        if (*it == '\n') { ++it; continue; }
+        if (*it == '\r' && it + 1 != end && it[1] == '\n') { it+= 2; continue; }
+        unsigned n = 0;
+        for (;;) {
+            if (it != end && *it == '"') {
+                char const *begin = ++it;
+                bool esc = false;
+                for (;;) {
+                    if (it == end || *it == '\n') { return it; }
+                    if (*it == '"') {
+                        if (it + 1 == end || it[1] != '"') { break; }
+                        esc = true;
+                        ++it;
+                    }
+                    ++it;
+                }
+                cells.emplace_back(esc ? Cell::ESC : Cell::STR, begin, it++);
+                if (it != end && *it == '\r') { ++it; }
+            }
+            else {
+                char const *begin = it;
+                while (it != end && *it != sep && *it != '\n') { ++it; }
+                char const *fieldEnd = it;
+                if (fieldEnd != begin && fieldEnd[-1] == '\r') { --fieldEnd; }
+                int num;
+                if (isNumber(begin, fieldEnd, num))      { cells.emplace_back(Value::createNum(num)); }
+                else if (isIdentifier(begin, fieldEnd)) { cells.emplace_back(Cell::ID, begin, fieldEnd); }
+                else                                    { cells.emplace_back(Cell::STR, begin, fieldEnd); }
+            }
+            ++n;
+            if (it == end || *it == '\n') { break; }
+            if (*it != sep) { return it; }
+            ++it;
+        }
+        if (it != end) { ++it; }
+        sizes.emplace_back(n);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+FactLoader::FactLoader(std::string const &filename, FactFormat format, bool header)
+    : filename_(filename)
+    , file_(make_unique<Mapped>(filename))
+    , format_(format)
+    , header_(header) { }
+
+void FactLoader::sequential(FactTasks &tasks) {
+    for (auto &x : tasks) { x(); }
+}
+
+void FactLoader::load(FWString name, unsigned tasks, FactRunner const &run, std::function<void (Value)> const &out) {
+    if (tasks == 0) { tasks = 1; }
+    if (format_ == FactFormat::BINARY) { loadBinary(name, tasks, run, out); }
+    else                               { loadDelimited(name, tasks, run, out); }
+}
+
+void FactLoader::loadDelimited(FWString name, unsigned tasks, FactRunner const &run, std::function<void (Value)> const &out) {
+    char sep = format_ == FactFormat::TSV ? '\t' : ',';
+    char const *data = file_->data, *end = data + file_->size, *it = data;
+    if (header_ && it != end) { it = nextLine(it, end); }
+    std::vector<CellVec> cells(tasks);
+    std::vector<std::vector<unsigned>> sizes(tasks);
+    std::vector<char const *> errors(tasks);
+    ValVec args;
+    while (it != end) {
+        // split the next batch at line breaks into one chunk per task
+        char const *batchEnd = nextLine(it + std::min<size_t>(batchBytes, end - it - 1), end);
+        size_t chunk = (batchEnd - it) / tasks + 1;
+        FactTasks parse;
+        for (unsigned i = 0; i < tasks && it != batchEnd; ++i) {
+            char const *chunkEnd = i + 1 == tasks ? batchEnd : nextLine(it + std::min<size_t>(chunk, batchEnd - it - 1), batchEnd);
+            cells[i].clear();
+            sizes[i].clear();
+            parse.emplace_back([&, i, it, chunkEnd]() { errors[i] = parseRows(it, chunkEnd, sep, cells[i], sizes[i]); });
+            it = chunkEnd;
+        }
+        run(parse);
+        for (unsigned i = 0; i < parse.size(); ++i) {
+            if (errors[i]) {
+                std::ostringstream msg;
+                msg << filename_ << ":" << lineOf(data, errors[i]) << ": unexpected character in delimited file";
+                throw std::runtime_error(msg.str());
+            }
+            auto cell = cells[i].begin();
+            for (auto n : sizes[i]) {
+                args.clear();
+                for (auto ie = cell + n; cell != ie; ++cell) { args.emplace_back(cell->value()); }
+                out(Value::createFun(name, args));
+            }
+        }
+    }
+}
+
+void FactLoader::loadBinary(FWString name, unsigned tasks, FactRunner const &run, std::function<void (Value)> const &out) {
+    char const *data = file_->data, *end = data + file_->size;
+    auto fail = [this](char const *what) -> void {
+        throw std::runtime_error(filename_ + ": " + what);
+    };
+    if (file_->size < 20 || memcmp(data, "GCOL", 4) != 0) { fail("not a binary fact file"); }
+    if (readInt(data + 4, 4) != 1) { fail("unsupported binary fact file version"); }
+    uint64_t cols = readInt(data + 8, 4);
+    uint64_t rows = readInt(data + 12, 8);
+    char const *it = data + 20;
+    if (cols == 0 || uint64_t(end - it) < cols) { fail("invalid column count"); }
+    // locate the columns
+    struct Column {
+        unsigned char type;
+        char const   *begin;
+        char const   *chars;
+    };
+    std::vector<Column> columns;
+    for (uint64_t i = 0; i < cols; ++i) { columns.push_back({static_cast<unsigned char>(it[i]), nullptr, nullptr}); }
+    it+= cols;
+    for (auto &col : columns) {
+        col.begin = it;
+        if (col.type == 0) {
+            if (uint64_t(end - it) / 4 < rows) { fail("truncated integer column"); }
+            it+= 4 * rows;
+        }
+        else if (col.type == 1 || col.type == 2) {
+            if (uint64_t(end - it) / 8 <= rows) { fail("truncated offsets"); }
+            col.chars = it + 8 * (rows + 1);
+            uint64_t length = readInt(it + 8 * rows, 8);
+            if (uint64_t(end - col.chars) < length) { fail("truncated character data"); }
+            it = col.chars + length;
+        }
+        else { fail("unknown column type"); }
+    }
+    // convert the rows in batches, one task per column
+    std::vector<CellVec> cells(cols);
+    std::vector<char> errors(cols);
+    ValVec args;
+    for (uint64_t row = 0; row < rows; ) {
+        uint64_t batchEnd = std::min<uint64_t>(rows, row + batchRows);
+        FactTasks parse;
+        for (unsigned i = 0; i < cols; ++i) {
+            parse.emplace_back([&, i, row, batchEnd]() {
+                Column const &col = columns[i];
+                CellVec &cs = cells[i];
+                cs.clear();
+                cs.reserve(batchEnd - row);
+                errors[i] = false;
+                if (col.type == 0) {
+                    for (uint64_t r = row; r < batchEnd; ++r) {
+                        cs.emplace_back(Value::createNum(static_cast<int32_t>(readInt(col.begin + 4 * r, 4))));
+                    }
+                }
+                else {
+                    uint64_t length = readInt(col.begin + 8 * rows, 8);
+                    uint64_t a = readInt(col.begin + 8 * row, 8);
+                    for (uint64_t r = row; r < batchEnd; ++r) {
+                        uint64_t b = readInt(col.begin + 8 * (r + 1), 8);
+                        if (b < a || b > length) {
+                            errors[i] = true;
+                            return;
+                        }
+                        cs.emplace_back(col.type == 1 ? Cell::ID : Cell::STR, col.chars + a, col.chars + b);
+                        a = b;
+                    }
+                }
+            });
+        }
+        if (tasks == 1) { sequential(parse); }
+        else            { run(parse); }
+        for (unsigned i = 0; i < cols; ++i) {
+            if (errors[i]) { fail("invalid offsets"); }
+        }
+        for (uint64_t r = 0, re = batchEnd - row; r < re; ++r) {
+            args.clear();
+            for (auto &cs : cells) { args.emplace_back(cs[r].value()); }
+            out(Value::createFun(name, args));
+        }
+        row = batchEnd;
+    }
+}
+
+FactLoader::~FactLoader() { }
+
+// }}}
+
+} } // namespace Input Gringo
@@ -209,6 +209,7 @@ void NonGroundGrammar::parser::error(DefaultLocation const &l, std::string const
     DOTS        ".."
     END         0 "<EOF>"
     EXTERNAL    "#external"
+    FACTS       "#facts"
     FALSE       "#false"
     FORGET      "#forget"
     GEQ         ">="
@@ -229,6 +230,7 @@ void NonGroundGrammar::parser::error(DefaultLocation const &l, std::string const
     MUL         "*"
     NEQ         "!="
     POW         "**"
+    QUERY       "#query"
     QUESTION    "?"
     RBRACE      "}"
     RBRACK      "]"
@@ -773,6 +775,13 @@ statement
     | INCLUDE LT IDENTIFIER[file] GT DOT { lexer->include($file, @$, true); }
     ;
 
+// }}}
+// {{{ facts
+
+statement
+    : FACTS STRING[file] IDENTIFIER[name] DOT { lexer->facts($file, $name, @$); }
+    ;
+
 // }}}
 // {{{ blocks
 
@@ -800,6 +809,13 @@ statement
     | EXTERNAL atom[hd] DOT               { BUILDER.external(@$, BUILDER.predlit(@hd, NAF::POS, $hd.second & 1, FWString($hd.first), TermVecVecUid($hd.second >> 1u)), BUILDER.body()); }
     ;
 
+// }}}
+// {{{ query
+
+statement
+    : QUERY atom[a] DOT { BUILDER.query(@$, BUILDER.predlit(@a, NAF::POS, $a.second & 1, FWString($a.first), TermVecVecUid($a.second >> 1u))); }
+    ;
+
 // }}}
 // }}}
 
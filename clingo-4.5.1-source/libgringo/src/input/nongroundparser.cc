@@ -38,6 +38,7 @@
 #include <fstream>
 #include <vector>
 #include <algorithm>
+#include <cctype>
 
 
 namespace Gringo { namespace Input {
@@ -143,6 +144,81 @@ std::pair<std::string, std::string> check_file(std::string const &filename, std:
 
 #endif
 
+// Parses the ground atoms matched by the FACT rule of the lexer.
+class FactParser {
+public:
+    FactParser(std::string const &str)
+    : it_(str.c_str())
+    , not_(FWString::uid("not")) { }
+    bool parse(Value &atom) {
+        ws();
+        if (!fun(atom)) { return false; }
+        ws();
+        return *it_ == '.';
+    }
+private:
+    void ws() {
+        while (*it_ == ' ' || *it_ == '\t' || *it_ == '\r') { ++it_; }
+    }
+    bool id(FWString &name) {
+        char const *begin = it_;
+        while (*it_ == '_') { ++it_; }
+        if (!std::islower(static_cast<unsigned char>(*it_))) { return false; }
+        while (std::isalnum(static_cast<unsigned char>(*it_)) || *it_ == '_' || *it_ == '\'') { ++it_; }
+        name = std::string(begin, it_);
+        return name.uid() != not_;
+    }
+    bool fun(Value &val) {
+        FWString name;
+        if (!id(name)) { return false; }
+        ws();
+        ValVec args;
+        if (*it_ == '(') {
+            ++it_;
+            ws();
+            if (*it_ != ')') {
+                for (;;) {
+                    args.emplace_back();
+                    if (!term(args.back())) { return false; }
+                    ws();
+                    if (*it_ != ',') { break; }
+                    ++it_;
+                    ws();
+                }
+            }
+            if (*it_ != ')') { return false; }
+            ++it_;
+        }
+        val = args.empty() ? Value::createId(name) : Value::createFun(name, args);
+        return true;
+    }
+    bool term(Value &val) {
+        if (*it_ == '"') {
+            char const *begin = ++it_;
+            for (; *it_ != '"'; ++it_) {
+                if (*it_ == '\\') { ++it_; }
+            }
+            val = Value::createStr(unquote(std::string(begin, it_++)));
+            return true;
+        }
+        bool neg = *it_ == '-';
+        if (neg) { ++it_; }
+        if (std::isdigit(static_cast<unsigned char>(*it_))) {
+            int num = 0;
+            for (; std::isdigit(static_cast<unsigned char>(*it_)); ++it_) {
+                num *= 10;
+                num += *it_ - '0';
+            }
+            val = Value::createNum(neg ? -num : num);
+            return true;
+        }
+        return !neg && fun(val);
+    }
+
+    char const *it_;
+    unsigned    not_;
+};
+
 }
 
 // {{{ defintion of NonGroundParser
@@ -156,6 +232,16 @@ void NonGroundParser::parseError(Location const &loc, std::string const &msg) {
     GRINGO_REPORT(E_ERROR) << loc << ": error: " << msg << "\n";
 }
 
+bool NonGroundParser::fact(Location &loc) {
+    Value atom;
+    if (!FactParser(string()).parse(atom)) { return false; }
+    loc.endFilename = filename();
+    loc.endLine     = line();
+    loc.endColumn   = column();
+    pb_.fact(loc, atom);
+    return true;
+}
+
 void NonGroundParser::lexerError(std::string const &token) {
     GRINGO_REPORT(E_ERROR) << filename() << ":" << line() << ":" << column() << ": error: lexer error, unexpected " << token << "\n";
 }
@@ -185,6 +271,20 @@ void NonGroundParser::pushFile(std::string &&file) {
     }
 }
 
+void NonGroundParser::pushFile(std::string &&file, std::unique_ptr<std::istream> in) {
+    auto checked = check_file(file);
+    if (!checked.empty() && !filenames_.insert(checked).second) {
+        report_included("<cmd>", file);
+    }
+    else if (checked.empty()) {
+        report_not_found("<cmd>", file);
+    }
+    else {
+        FWString data = file;
+        LexerState::push(std::move(in), {data, {"base", {}}});
+    }
+}
+
 void NonGroundParser::pushStream(std::string &&file, std::unique_ptr<std::istream> in) {
     auto res = filenames_.insert(std::move(file));
     if (!res.second) {
@@ -219,7 +319,10 @@ int NonGroundParser::lex(void *pValue, Location &loc) {
         loc.endFilename = filename();
         loc.endLine     = line();
         loc.endColumn   = column();
-        if (minor) { return minor; }
+        if (minor) {
+            factStart_ = minor == NonGroundGrammar::parser::token::DOT;
+            return minor;
+        }
         else       { 
             pop();
             _init();
@@ -295,9 +398,36 @@ end
     }
 }
 
+void NonGroundParser::facts(unsigned fUid, unsigned nameUid, Location const &loc) {
+    auto paths = check_file(*FWString(fUid), *loc.beginFilename);
+    if (paths.first.empty()) {
+        report_not_found(loc, *FWString(fUid));
+        return;
+    }
+    try {
+        FactLoader(paths.second, factFormat("", paths.second), false).load(FWString(nameUid), factTasks_, factRunner_, [&](Value atom) { pb_.fact(loc, atom); });
+    }
+    catch (std::runtime_error const &e) {
+        GRINGO_REPORT(E_ERROR) << loc << ": error: " << e.what() << "\n";
+    }
+}
+
+void NonGroundParser::loadFacts(std::string const &filename, FWString name, std::string const &format, bool header) {
+    Location loc(filename, 1, 1, filename, 1, 1);
+    FactLoader loader(filename, factFormat(format, filename), header);
+    pb_.block(loc, "base", pb_.idvec());
+    loader.load(name, factTasks_, factRunner_, [&](Value atom) { pb_.fact(loc, atom); });
+}
+
+void NonGroundParser::setFactRunner(unsigned tasks, FactRunner run) {
+    factTasks_  = tasks;
+    factRunner_ = std::move(run);
+}
+
 bool NonGroundParser::parseDefine(std::string const &define) {
     pushStream("<" + define + ">", make_unique<std::stringstream>(define));
     _startSymbol = NonGroundGrammar::parser::token::PARSE_DEF;
+    factStart_   = false;
     NonGroundGrammar::parser parser(this);
     auto ret = parser.parse();
     filenames_.clear();
@@ -307,6 +437,7 @@ bool NonGroundParser::parseDefine(std::string const &define) {
 bool NonGroundParser::parse() {
     if (empty()) { return true; }
     _startSymbol = NonGroundGrammar::parser::token::PARSE_LP;
+    factStart_   = true;
     NonGroundGrammar::parser parser(this);
     _init();
     auto ret = parser.parse();
@@ -21,6 +21,7 @@
 #include "gringo/input/program.hh"
 #include "gringo/input/literals.hh"
 #include "gringo/input/aggregates.hh"
+#include "gringo/input/demand.hh"
 #include "gringo/ground/literal.hh"
 #include "gringo/ground/statements.hh"
 #include "gringo/term.hh"
@@ -69,6 +70,14 @@ void Program::add(UStm &&stm) {
     }
 }
 
+void Program::add(Value fact) {
+    current_->addedEdb.emplace_back(fact);
+}
+
+void Program::addQuery(ULit &&lit) {
+    current_->addedQueries.emplace_back(std::move(lit));
+}
+
 void Program::rewrite(Defines &defs) {
     for (auto &block : blocks_) {
         // {{{3 replacing definitions
@@ -126,11 +135,32 @@ void Program::rewrite(Defines &defs) {
                 else                   { rewrite2(x); } 
             }
         };
-        for (auto &x : block.addedStms) {
-            x->replace(defs);
-            x->replace(incDefs);
-            if (x->hasPool(true)) { for (auto &y : x->unpool(true)) { rewrite1(y); } }
-            else                  { rewrite1(x); }
+        if (block.addedQueries.empty()) {
+            for (auto &x : block.addedStms) {
+                x->replace(defs);
+                x->replace(incDefs);
+                if (x->hasPool(true)) { for (auto &y : x->unpool(true)) { rewrite1(y); } }
+                else                  { rewrite1(x); }
+            }
+        }
+        else {
+            // the demand transformation needs the statements of the whole part
+            UStmVec stms;
+            for (auto &x : block.addedStms) {
+                x->replace(defs);
+                x->replace(incDefs);
+                if (x->hasPool(true)) { for (auto &y : x->unpool(true)) { stms.emplace_back(std::move(y)); } }
+                else                  { stms.emplace_back(std::move(x)); }
+            }
+            ULitVec queries;
+            for (auto &x : block.addedQueries) {
+                x->replace(defs);
+                x->replace(incDefs);
+                for (auto &y : x->unpool(true)) { queries.emplace_back(std::move(y)); }
+            }
+            rewriteDemand(queries, stms, std::vector<FWSignature>(neg_.begin(), neg_.end()));
+            for (auto &x : stms) { rewrite1(x); }
+            block.addedQueries.clear();
         }
         block.addedStms.clear();
         // }}}3
@@ -167,6 +197,7 @@ void Program::print(std::ostream &out) const {
     for (auto &block : blocks_) {
         for (auto &x : block.addedEdb)          { out << x << "." << "\n"; }
         for (auto &x : std::get<1>(*block.edb)) { out << x << "." << "\n"; }
+        for (auto &x : block.addedQueries)      { out << "#query " << *x << "." << "\n"; }
         for (auto &x : block.addedStms)         { out << *x << "\n"; }
         for (auto &x : block.stms)              { out << *x << "\n"; }
     }
@@ -323,6 +323,10 @@ void NongroundProgramBuilder::rule(Location const &loc, HdLitUid head) {
     rule(loc, head, body());
 }
 
+void NongroundProgramBuilder::fact(Location const &, Value atom) {
+    prg_.add(atom);
+}
+
 void NongroundProgramBuilder::rule(Location const &loc, HdLitUid head, BdLitVecUid body) {
     prg_.add(make_locatable<Statement>(loc, heads_.erase(head), bodies_.erase(body), StatementType::RULE));
 }
@@ -368,6 +372,10 @@ void NongroundProgramBuilder::external(Location const &loc, LitUid head, BdLitVe
     prg_.add(make_locatable<Statement>(loc, heads_.erase(headlit(head)), bodies_.erase(body), StatementType::EXTERNAL));
 }
 
+void NongroundProgramBuilder::query(Location const &, LitUid lit) {
+    prg_.addQuery(lits_.erase(lit));
+}
+
 // }}}
 
 NongroundProgramBuilder::~NongroundProgramBuilder() { }
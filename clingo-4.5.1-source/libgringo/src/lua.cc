@@ -26,7 +26,10 @@
 #include "gringo/control.hh"
 
 #include <lua.hpp>
+#include <algorithm>
 #include <cstring>
+#include <cstdint>
+#include <limits>
 
 namespace Gringo {
 
@@ -35,22 +38,25 @@ namespace {
 // {{{1 auxiliary functions
 
 #define VALUE_CMP(TYPE) \
+static Value check(lua_State *L, int idx) { \
+    return *static_cast<Value*>(luaL_checkudata(L, idx, "gringo."#TYPE)); \
+} \
 static int eq##TYPE(lua_State *L) { \
-    Value *a = static_cast<Value*>(luaL_checkudata(L, 1, "gringo."#TYPE)); \
-    Value *b = static_cast<Value*>(luaL_checkudata(L, 2, "gringo."#TYPE)); \
-    lua_pushboolean(L, *a == *b); \
+    Value a = check(L, 1); \
+    Value b = check(L, 2); \
+    lua_pushboolean(L, a == b); \
     return 1; \
 } \
 static int lt##TYPE(lua_State *L) { \
-    Value *a = static_cast<Value*>(luaL_checkudata(L, 1, "gringo."#TYPE)); \
-    Value *b = static_cast<Value*>(luaL_checkudata(L, 2, "gringo."#TYPE)); \
-    lua_pushboolean(L, *a <= *b); \
+    Value a = check(L, 1); \
+    Value b = check(L, 2); \
+    lua_pushboolean(L, a <= b); \
     return 1; \
 } \
 static int le##TYPE(lua_State *L) { \
-    Value *a = static_cast<Value*>(luaL_checkudata(L, 1, "gringo."#TYPE)); \
-    Value *b = static_cast<Value*>(luaL_checkudata(L, 2, "gringo."#TYPE)); \
-    lua_pushboolean(L, *a < *b); \
+    Value a = check(L, 1); \
+    Value b = check(L, 2); \
+    lua_pushboolean(L, a < b); \
     return 1; \
 }
 
@@ -85,6 +91,16 @@ luaL_Reg const AnyWrap::meta[] = {
     {nullptr, nullptr}
 };
 
+// Function symbols are passed to lua as full userdata with the gringo.Fun
+// metatable. To avoid allocating (and collecting) a new userdata each time a
+// symbol is passed to lua, the userdata are cached in a registry table with
+// weak values that is indexed by light userdata holding the symbol itself.
+// The light userdata only serve as keys and never have a metatable.
+void *valToHandle(Value v) {
+    Value::POD const &pod = v;
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(uint64_t(pod.type) << 32 | pod.value));
+}
+
 Value luaToVal(lua_State *L, int idx) {
     int type = lua_type(L, idx);
     switch(type) {
@@ -121,18 +137,39 @@ Value luaToVal(lua_State *L, int idx) {
                 return false;
             };
             if (check()) { return *(Value*)lua_touserdata(L, idx); }
+            break;
         }
-        default: { luaL_error(L, "cannot convert to value"); }
     }
+    luaL_error(L, "cannot convert to value");
     throw std::runtime_error("cannot happen");
 }
+void pushFun(lua_State *L, Value v) {
+    bool cache = sizeof(void*) >= sizeof(Value);
+    if (cache) {
+        lua_getfield(L, LUA_REGISTRYINDEX, "gringo._FunCache"); // +1
+        lua_pushlightuserdata(L, valToHandle(v));               // +1
+        lua_rawget(L, -2);                                      // +0
+        if (!lua_isnil(L, -1)) {
+            lua_replace(L, -2);                                 // -1
+            return;
+        }
+        lua_pop(L, 1);                                          // -1
+    }
+    *(Value*)lua_newuserdata(L, sizeof(Value)) = v;             // +1
+    luaL_getmetatable(L, "gringo.Fun");                         // +1
+    lua_setmetatable(L, -2);                                    // -1
+    if (cache) {
+        lua_pushlightuserdata(L, valToHandle(v));               // +1
+        lua_pushvalue(L, -2);                                   // +1
+        lua_rawset(L, -4);                                      // -2
+        lua_replace(L, -2);                                     // -1
+    }
+}
 void valToLua(lua_State *L, Value v) {
     switch (v.type()) {
         case Value::ID:
         case Value::FUNC: {
-            *(Value*)lua_newuserdata(L, sizeof(Value)) = v;
-            luaL_getmetatable(L, "gringo.Fun");
-            lua_setmetatable(L, -2);
+            pushFun(L, v);
             break;
         }
         case Value::SUP: {
@@ -165,6 +202,10 @@ int lua_absindex(lua_State *L, int idx) {
     return (idx < 0) ? lua_gettop(L) + idx + 1 : idx;
 }
 
+size_t lua_rawlen(lua_State *L, int idx) {
+    return lua_objlen(L, idx);
+}
+
 #endif
 
 ValVec *luaToVals(lua_State *L, int idx) {
@@ -334,34 +375,42 @@ struct Fun {
         char const *name = luaL_checklstring(L, 1, nullptr);
         if (name[0] == '\0') { luaL_argerror(L, 2, "function symbols must have a non-empty name"); }
         if (lua_isnone(L, 2) || lua_isnil(L, 2)) {
-            *(Value*)lua_newuserdata(L, sizeof(Value)) = protect<Value>(L, [name](){ return Value::createId(name); });
-            luaL_getmetatable(L, "gringo.Fun");
-            lua_setmetatable(L, -2);
+            pushFun(L, protect<Value>(L, [name](){ return Value::createId(name); }));
         }
         else {
             ValVec *vals = luaToVals(L, 2);
-            *(Value*)lua_newuserdata(L, sizeof(Value)) = protect<Value>(L, [name, vals](){ return vals->empty() ? Value::createId(name) : Value::createFun(name, *vals); });
-            luaL_getmetatable(L, "gringo.Fun");
-            lua_setmetatable(L, -2);
+            pushFun(L, protect<Value>(L, [name, vals](){ return vals->empty() ? Value::createId(name) : Value::createFun(name, *vals); }));
         }
         return 1;
     }
     static int newTuple(lua_State *L) {
         ValVec *vals = luaToVals(L, 1);
         if (vals->size() < 2) { luaL_argerror(L, 1, "tuples must have at least two values"); }
-        *(Value*)lua_newuserdata(L, sizeof(Value)) = protect<Value>(L, [vals](){ return Value::createTuple(*vals); });
-        luaL_getmetatable(L, "gringo.Fun");
-        lua_setmetatable(L, -2);
+        pushFun(L, protect<Value>(L, [vals](){ return Value::createTuple(*vals); }));
         return 1;
     }
     VALUE_CMP(Fun)
     static int name(lua_State *L) {
-        Value val = *(Value*)luaL_checkudata(L, 1, "gringo.Fun");
+        Value val = check(L, 1);
         lua_pushstring(L, protect<const char*>(L, [val]() { return (*val.name()).c_str(); }));
         return 1;
     }
+    static int arity(lua_State *L) {
+        Value val = check(L, 1);
+        lua_pushinteger(L, val.type() == Value::FUNC ? val.args().size() : 0);
+        return 1;
+    }
+    static int arg(lua_State *L) {
+        Value val = check(L, 1);
+        lua_Integer idx = luaL_checkinteger(L, 2);
+        if (val.type() == Value::FUNC && idx >= 1 && static_cast<size_t>(idx) <= val.args().size()) {
+            valToLua(L, val.args()[idx - 1]);
+        }
+        else { lua_pushnil(L); }
+        return 1;
+    }
     static int args(lua_State *L) {
-        Value val = *(Value*)luaL_checkudata(L, 1, "gringo.Fun");
+        Value val = check(L, 1);
         lua_createtable(L, val.args().size(), 0);
         if (val.type() == Value::FUNC) {
             int i = 1;
@@ -374,7 +423,7 @@ struct Fun {
     }
     static int toString(lua_State *L) {
         std::string *rep = AnyWrap::new_<std::string>(L);
-        Value val = *(Value*)luaL_checkudata(L, 1, "gringo.Fun");
+        Value val = check(L, 1);
         lua_pushstring(L, protect<const char*>(L, [val, rep]() {
             std::ostringstream oss;
             oss << val;
@@ -390,6 +439,8 @@ luaL_Reg const Fun::meta[] = {
     {"__tostring", toString},
     {"name", name},
     {"args", args},
+    {"arg", arg},
+    {"arity", arity},
     {"__eq", eqFun},
     {"__lt", ltFun},
     {"__le", leFun},
@@ -565,6 +616,19 @@ int newStatistics(lua_State *L, Statistics const *stats) {
 
 // {{{1 wrap SolveFuture
 
+void assumptionsToLua(lua_State *L, Control::Assumptions const &ass) {
+    lua_createtable(L, ass.size(), 0);                      // +1
+    int i = 1;
+    for (auto &x : ass) {
+        lua_createtable(L, 2, 0);                           // +1
+        valToLua(L, x.first);                               // +1
+        lua_rawseti(L, -2, 1);                              // -1
+        lua_pushboolean(L, x.second);                       // +1
+        lua_rawseti(L, -2, 2);                              // -1
+        lua_rawseti(L, -2, i++);                            // -1
+    }
+}
+
 struct SolveFuture {
     static int get(lua_State *L) {
         Gringo::SolveFuture *& future = *(Gringo::SolveFuture **)luaL_checkudata(L, 1, "gringo.SolveFuture");
@@ -588,6 +652,15 @@ struct SolveFuture {
         protect<void>(L, [future]() { future->cancel(); });
         return 0;
     }
+    static int unsat_core(lua_State *L) {
+        Gringo::SolveFuture *& future = *(Gringo::SolveFuture **)luaL_checkudata(L, 1, "gringo.SolveFuture");
+        bool minimize = lua_toboolean(L, 2);
+        double timeLimit = luaL_optnumber(L, 3, 0);
+        Control::Assumptions *core = AnyWrap::new_<Control::Assumptions>(L);
+        protect<void>(L, [future, minimize, timeLimit, core]() { *core = future->unsatCore(minimize, timeLimit); });
+        assumptionsToLua(L, *core);
+        return 1;
+    }
     static luaL_Reg const meta[];
 };
 
@@ -595,6 +668,7 @@ luaL_Reg const SolveFuture::meta[] = {
     {"get",  get},
     {"wait", wait},
     {"cancel", cancel},
+    {"unsat_core", unsat_core},
     {nullptr, nullptr}
 };
 
@@ -897,6 +971,69 @@ struct DomainProxy {
         return 1;
     }
 
+    // pushes a table of booleans for the given flag
+    static void flagsToLua(lua_State *L, std::vector<unsigned> const &flags, unsigned flag) {
+        lua_createtable(L, flags.size(), 0);               // +1
+        int i = 1;
+        for (auto x : flags) {
+            lua_pushboolean(L, (x & flag) != 0);           // +1
+            lua_rawseti(L, -2, i++);                       // -1
+        }
+    }
+
+    static int scan(lua_State *L) {
+        auto &self = get_self(L);
+        char const *name = luaL_checkstring(L, 2);
+        int arity = luaL_checkinteger(L, 3);
+        lua_Integer offset = luaL_optinteger(L, 4, 0);
+        lua_Integer size = luaL_optinteger(L, 5, 1024);
+        if (offset < 0) { luaL_argerror(L, 4, "offset must be non-negative"); }
+        if (size < 0)   { luaL_argerror(L, 5, "size must be non-negative"); }
+        auto atoms = AnyWrap::new_<ValVec>(L);              // +1
+        auto flags = AnyWrap::new_<std::vector<unsigned>>(L); // +1
+        protect<void>(L, [&self, name, arity, offset, size, atoms, flags]() {
+            Signature sig(name, arity);
+            // only allocate space for the atoms actually available
+            size_t available = self.proxy.length(sig);
+            size_t n = std::min<size_t>(size, available - std::min<size_t>(offset, available));
+            atoms->resize(n);
+            flags->resize(n);
+            n = self.proxy.scan(sig, offset, n, atoms->data(), flags->data());
+            atoms->resize(n);
+            flags->resize(n);
+        });
+        lua_createtable(L, atoms->size(), 0);               // +1
+        int i = 1;
+        for (auto x : *atoms) {
+            valToLua(L, x);                                 // +1
+            lua_rawseti(L, -2, i++);                        // -1
+        }
+        flagsToLua(L, *flags, Gringo::DomainProxy::FACT);     // +1
+        flagsToLua(L, *flags, Gringo::DomainProxy::EXTERNAL); // +1
+        return 3;
+    }
+
+    static int lookup_many(lua_State *L) {
+        auto &self = get_self(L);
+        luaL_checktype(L, 2, LUA_TTABLE);
+        auto atoms = AnyWrap::new_<ValVec>(L);              // +1
+        for (int i = 1, n = lua_rawlen(L, 2); i <= n; ++i) {
+            lua_rawgeti(L, 2, i);                           // +1
+            Value atom = luaToVal(L, -1);
+            protect<void>(L, [atom, atoms]() { atoms->push_back(atom); });
+            lua_pop(L, 1);                                  // -1
+        }
+        auto flags = AnyWrap::new_<std::vector<unsigned>>(L); // +1
+        protect<void>(L, [&self, atoms, flags]() {
+            flags->resize(atoms->size());
+            self.proxy.lookup(atoms->data(), atoms->size(), flags->data());
+        });
+        flagsToLua(L, *flags, Gringo::DomainProxy::FOUND);    // +1
+        flagsToLua(L, *flags, Gringo::DomainProxy::FACT);     // +1
+        flagsToLua(L, *flags, Gringo::DomainProxy::EXTERNAL); // +1
+        return 3;
+    }
+
     static int signatures(lua_State *L) {
         auto &self = get_self(L);
         auto ret = AnyWrap::new_<std::vector<FWSignature>>(L); // +1
@@ -922,6 +1059,8 @@ luaL_Reg const DomainProxy::meta[] = {
     {"iter", iter},
     {"lookup", lookup},
     {"by_signature", by_signature},
+    {"scan", scan},
+    {"lookup_many", lookup_many},
     {"signatures", signatures},
     {nullptr, nullptr}
 };
@@ -997,6 +1136,16 @@ struct ControlWrap {
         protect<void>(L, [&ctl, filename]() { ctl.load(filename); });
         return 0;
     }
+    static int load_facts(lua_State *L) {
+        auto &ctl = get_self(L).ctl;
+        checkBlocked(L, ctl, "load_facts");
+        char const *filename = luaL_checkstring(L, 2);
+        char const *predicate = luaL_checkstring(L, 3);
+        char const *format = luaL_optstring(L, 4, "");
+        bool header = lua_toboolean(L, 5);
+        protect<void>(L, [&ctl, filename, predicate, format, header]() { ctl.loadFacts(filename, predicate, format, header); });
+        return 0;
+    }
     static int get_const(lua_State *L) {
         auto &ctl = get_self(L).ctl;
         checkBlocked(L, ctl, "get_const");
@@ -1061,6 +1210,16 @@ struct ControlWrap {
         }));
         return 1;
     }
+    static int unsat_core(lua_State *L) {
+        auto &ctl = get_self(L).ctl;
+        checkBlocked(L, ctl, "unsat_core");
+        bool minimize = lua_toboolean(L, 2);
+        double timeLimit = luaL_optnumber(L, 3, 0);
+        Control::Assumptions *core = AnyWrap::new_<Control::Assumptions>(L);
+        protect<void>(L, [&ctl, minimize, timeLimit, core]() { *core = ctl.unsatCore(minimize, timeLimit); });
+        assumptionsToLua(L, *core);
+        return 1;
+    }
     static int cleanup_domains(lua_State *L) {
         auto &ctl = get_self(L).ctl;
         checkBlocked(L, ctl, "cleanup_domains");
@@ -1130,9 +1289,12 @@ struct ControlWrap {
         checkBlocked(L, ctl, "solve_iter");
         lua_unsetuservaluefield(L, 1, "stats");
         int assIdx  = !lua_isnone(L, 2) && !lua_isnil(L, 2) ? 2 : 0;
+        lua_Integer size = luaL_optinteger(L, 3, 0);
+        if (size < 0) { luaL_argerror(L, 3, "queue size must be non-negative"); }
+        unsigned queueSize = size > std::numeric_limits<unsigned>::max() ? std::numeric_limits<unsigned>::max() : size;
         Control::Assumptions *ass = getAssumptions(L, assIdx);
         auto &iter = *(Gringo::SolveIter **)lua_newuserdata(L, sizeof(Gringo::SolveIter*));
-        iter = protect<Gringo::SolveIter*>(L, [&ctl, ass]() { return ctl.solveIter(std::move(*ass)); });
+        iter = protect<Gringo::SolveIter*>(L, [&ctl, ass, queueSize]() { return ctl.solveIter(std::move(*ass), queueSize); });
         luaL_getmetatable(L, "gringo.SolveIter");
         lua_setmetatable(L, -2);
         return 1;
@@ -1259,8 +1421,10 @@ luaL_Reg ControlWrap::meta[] = {
     {"ground",  ground},
     {"add", add},
     {"load", load},
+    {"load_facts", load_facts},
     {"solve", solve},
     {"cleanup_domains", cleanup_domains},
+    {"unsat_core", unsat_core},
     {"solve_async", solve_async},
     {"solve_iter", solve_iter},
     {"get_const", get_const},
@@ -1331,6 +1495,13 @@ int luaopen_gringo(lua_State* L) {
     lua_newthread(L);
     lua_setfield(L, LUA_REGISTRYINDEX, "gringo._SolveThread");
 
+    lua_newtable(L);
+    lua_createtable(L, 0, 1);
+    lua_pushliteral(L, "v");
+    lua_setfield(L, -2, "__mode");
+    lua_setmetatable(L, -2);
+    lua_setfield(L, LUA_REGISTRYINDEX, "gringo._FunCache");
+
     lua_regMeta(L, "gringo.InfType",                InfType::meta);
     lua_regMeta(L, "gringo.SupType",                SupType::meta);
     lua_regMeta(L, "gringo.Fun",                Fun::meta);
@@ -1487,11 +1658,19 @@ struct LuaImpl {
         Location loc("<LuaImpl>", 1, 1, "<LuaImpl>", 1, 1);
         handleError(L, loc, ret, "running lua script failed");
         lua_settop(L, n);
+        lua_pushcfunction(L, luaTraceback);
+        traceback = luaL_ref(L, LUA_REGISTRYINDEX);
+        lua_pushcfunction(L, luaCall);
+        call = luaL_ref(L, LUA_REGISTRYINDEX);
     }
+    void pushTraceback() { lua_rawgeti(L, LUA_REGISTRYINDEX, traceback); }
+    void pushCall() { lua_rawgeti(L, LUA_REGISTRYINDEX, call); }
     ~LuaImpl() {
         if (L) { lua_close(L); }
     }
     lua_State *L;
+    int traceback;
+    int call;
 };
 
 // {{{1 definition of Lua
@@ -1505,7 +1684,7 @@ bool Lua::exec(Location const &loc, FWString code) {
     LuaClear lc(impl->L);
     std::stringstream oss;
     oss << loc;
-    lua_pushcfunction(impl->L, luaTraceback);
+    impl->pushTraceback();
     int ret = luaL_loadbuffer(impl->L, (*code).c_str(), (*code).size(), oss.str().c_str());
     handleError(impl->L, loc, ret, "parsing lua script failed");
     ret = lua_pcall(impl->L, 0, 0, -2);
@@ -1518,8 +1697,8 @@ ValVec Lua::call(Any const &context, Location const &loc, FWString name, ValVec
     LuaClear lc(impl->L);
     LuaContext const *ctx = context.get<LuaContext>();
     LuaCallArgs arg((*name).c_str(), args, {});
-    lua_pushcfunction(impl->L, luaTraceback);
-    lua_pushcfunction(impl->L, luaCall);
+    impl->pushTraceback();
+    impl->pushCall();
     lua_pushlightuserdata(impl->L, (void*)&arg);
     if (ctx) { lua_pushvalue(impl->L, ctx->idx); }
     else { lua_pushnil(impl->L); }
@@ -1541,7 +1720,7 @@ bool Lua::callable(Any const &context, FWString name) {
 void Lua::main(Control &ctl) {
     assert(impl);
     LuaClear lc(impl->L);
-    lua_pushcfunction(impl->L, luaTraceback);
+    impl->pushTraceback();
     lua_pushcfunction(impl->L, luaMain);
     lua_pushlightuserdata(impl->L, (void*)&ctl);
     switch (lua_pcall(impl->L, 1, 0, -3)) {
@@ -319,6 +319,80 @@ ULit SumTranslator::translate(LparseTranslator &x, BodyAggregate::ConjunctiveBou
     return getEqualClause(x, std::move(clause), true, false);
 }
 
+// {{{1 definition of NativeTranslator
+
+ULit NativeTranslator::translate(LparseTranslator &x, AggregateAnalyzer &res, AggregateFunction fun, ULitValVec &&elems, bool recursive) {
+    assert(!recursive || res.monotonicity != AggregateAnalyzer::NONMONOTONE);
+    auto constraint = [&x, recursive](SumConstraint::ULitWeightVec &&body, int bound) -> ULit {
+        if (!recursive) {
+            ULit aux = x.makeAux();
+            SumConstraint(aux->isAuxAtom(), bound, std::move(body)).toLparse(x);
+            return aux;
+        }
+        // the literals of a negative weight are negated here (and not by the solver)
+        // to keep negative literals out of the positive dependencies
+        WeightRule::ULitBoundVec lits;
+        for (auto &lit : body) {
+            if (lit.second > 0) { lits.emplace_back(std::move(lit.first), lit.second); }
+            else if (lit.second < 0) {
+                bound -= lit.second;
+                lits.emplace_back(lit.first->negateLit(x), -lit.second);
+            }
+        }
+        if (bound <= 0) { return x.getTrueLit(); }
+        ULit aux = x.makeAux();
+        WeightRule(aux->isAuxAtom(), bound, std::move(lits)).toLparse(x);
+        return aux;
+    };
+    ULitVec conjunction;
+    if (fun == AggregateFunction::MIN || fun == AggregateFunction::MAX) {
+        bool isMin = fun == AggregateFunction::MIN;
+        for (auto &bound : res.bounds) {
+            // translation overview (min):
+            // |--A--|  B  |--C--|
+            // A | ~B, i.e., |B| * sum(A) - sum(B) >= 0
+            // note that B is true if C is empty!
+            // if C is empty:
+            // A, i.e., sum(A) >= 1
+            Interval const &inner = isMin ? bound.first : bound.second;
+            Interval const &outer = isMin ? bound.second : bound.first;
+            SumConstraint::ULitWeightVec body;
+            int between = 0;
+            for (auto &elem : elems) {
+                if      (inner.contains(elem.second)) { body.emplace_back(get_clone(elem.first), 1); }
+                else if (!outer.contains(elem.second)) { ++between; }
+            }
+            if (outer.empty()) {
+                conjunction.emplace_back(constraint(std::move(body), 1));
+            }
+            else if (between > 0) {
+                for (auto &lit : body) { lit.second = between; }
+                for (auto &elem : elems) {
+                    if (!inner.contains(elem.second) && !outer.contains(elem.second)) { body.emplace_back(get_clone(elem.first), -1); }
+                }
+                conjunction.emplace_back(constraint(std::move(body), 0));
+            }
+        }
+    }
+    else {
+        auto weighted = [&elems](int sign) -> SumConstraint::ULitWeightVec {
+            SumConstraint::ULitWeightVec body;
+            for (auto &elem : elems) { body.emplace_back(get_clone(elem.first), sign * elem.second.num()); }
+            return body;
+        };
+        // each hole (a,b) requires sum <= a or sum >= b
+        // where sum <= a is expressed as -sum >= -a
+        for (auto &bound : res.bounds) {
+            assert(!bound.first.empty() || !bound.second.empty());
+            ULitVec disjunction;
+            if (!bound.second.empty()) { disjunction.emplace_back(constraint(weighted(1), bound.second.left.bound.num())); }
+            if (!bound.first.empty())  { disjunction.emplace_back(constraint(weighted(-1), -bound.first.right.bound.num())); }
+            conjunction.emplace_back(getEqualClause(x, std::move(disjunction), false, false));
+        }
+    }
+    return getEqualClause(x, std::move(conjunction), true, false);
+}
+
 // {{{1 definition of translation functions
 
 ULit getEqualClause(LparseTranslator &x, ULitVec &&clause, bool conjunctive, bool equivalence) {
@@ -395,6 +469,10 @@ ULit getEqualAggregate(LparseTranslator &x, AggregateFunction fun, NAF naf, Disj
             else if (hasEmpty)       { aux = elems.front().first->negateLit(x); }
             else                     { aux = x.getTrueLit()->negateLit(x); }
         }
+        else if (!recursive && x.nativeAggregates()) {
+            NativeTranslator trans;
+            aux = trans.translate(x, res, fun, std::move(elems), incomplete);
+        }
         else {
             switch (fun) {
                 case AggregateFunction::COUNT:
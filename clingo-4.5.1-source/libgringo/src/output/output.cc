@@ -22,6 +22,7 @@
 #include "gringo/logger.hh"
 #include "gringo/output/aggregates.hh"
 #include <cstring>
+#include <unordered_set>
 
 namespace Gringo { namespace Output {
 
@@ -36,6 +37,7 @@ struct Bound {
     using atom_vec = std::vector<std::pair<int, SAuxAtom>>;
     Bound(Value var) 
         : modified(true)
+        , orderVar(-1)
         , var(var) {
         _range.add(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
     }
@@ -69,6 +71,7 @@ struct Bound {
     const_iterator end() const { return _range.end(); }
 
     bool                   modified;
+    int                    orderVar;
     Value                  var;
     
     atom_vec               atoms;
@@ -171,9 +174,10 @@ struct DefaultLparseTranslator : LparseTranslator {
     using ConstraintVec   = std::vector<LinearConstraint>;
     using DisjointConsVec = std::vector<DisjointConstraint>;
 
-    DefaultLparseTranslator(PredDomMap &domains, StmPrinter const &printer)
+    DefaultLparseTranslator(PredDomMap &domains, StmPrinter const &printer, LparseOutputter *out = nullptr)
         : domains(domains)
-        , printer(printer) { }
+        , printer(printer)
+        , out(out) { }
     BoundMap::value_type &addBound(Value x) {
         auto it = boundMap.find(x);
         return it != boundMap.end() ? *it : *boundMap.emplace_back(x).first;
@@ -228,8 +232,20 @@ struct DefaultLparseTranslator : LparseTranslator {
     virtual bool minimizeChanged() const {
         return minimizeChanged_;
     }
+    bool native() const { return out && out->csp(); }
+    virtual bool nativeAggregates() const { return out && out->nativeAggregates(); }
+    unsigned orderVariable(Bound &bound) {
+        if (bound.orderVar < 0) {
+            LparseOutputter::OrderVec order;
+            for (auto &x : bound.atoms) { order.emplace_back(x.first, x.second ? x.second->lparseUid(*out) : 0); }
+            bound.orderVar = out->printOrderVariable(order);
+        }
+        return bound.orderVar;
+    }
     virtual void translate() {
         for (auto &x : boundMap) { 
+            // order variables are only valid in one step
+            x.orderVar = -1;
             if (!x.init(*this)) { return; }
         }
         for (auto &x : disjointCons) { x.encode(*this); }
@@ -435,6 +451,7 @@ struct DefaultLparseTranslator : LparseTranslator {
     DisjointConsVec    disjointCons;
     MinimizeList       minimize;
     StmPrinter         printer;
+    LparseOutputter   *out;
     unsigned           auxUid = 0;
     bool               minimizeChanged_ = false;
     std::set<FWSignature> seenSigs;
@@ -575,6 +592,16 @@ bool LinearConstraint::Generate::init() {
 }
 
 bool LinearConstraint::encode(DefaultLparseTranslator &x) {
+    if (x.native()) {
+        LparseOutputter::LinearTermVec terms;
+        for (auto &y : coefs) { terms.emplace_back(y.first, x.orderVariable(*x.boundMap.find(y.second))); }
+        // the head is the disjunction of all constraints sharing it
+        unsigned aux = x.out->newUid();
+        x.out->printChoiceRule({aux}, {});
+        x.out->printBasicRule(atom->lparseUid(*x.out), {static_cast<int>(aux)});
+        x.out->printLinearConstraint(aux, terms, bound);
+        return true;
+    }
     Generate gen(*this, x);
     return gen.init();
 }
@@ -676,7 +703,7 @@ struct LparseHandler : StmHandler {
         : trans(domains, [&out, debug](Statement const &x) {
             if ((unsigned)debug & (unsigned)LparseDebug::LPARSE) { std::cerr << "%%"; x.printPlain(std::cerr); }
             x.printLparse(out);
-        }) 
+        }, &out) 
         , out(out)
         , debug(debug) { }
     virtual void operator()(Statement &x) { 
@@ -847,6 +874,130 @@ void PlainLparseOutputter::printSymbol(unsigned atomUid, Value v)           { ou
 void PlainLparseOutputter::finishSymbols()                                  { out << "0\nB+\n0\nB-\n" << falseUid() << "\n0\n1\n"; }
 PlainLparseOutputter::~PlainLparseOutputter()                               { }
 
+// }}}
+// {{{ definition of DedupLparseOutputter
+
+DedupLparseOutputter::DedupLparseOutputter(ULparseOutputter &&out, unsigned window)
+    : out_(std::move(out))
+    , ring_(std::max(window, 1u)) { }
+void DedupLparseOutputter::incremental() { out_->incremental(); }
+void DedupLparseOutputter::printBasicRule(unsigned head, LitVec const &body) {
+    key_.assign({BASIC, int(head)});
+    key_.insert(key_.end(), body.begin(), body.end());
+    std::sort(key_.begin() + 2, key_.end());
+    key_.erase(std::unique(key_.begin() + 2, key_.end()), key_.end());
+    if (add(key_)) { out_->printBasicRule(head, body); }
+}
+void DedupLparseOutputter::printChoiceRule(AtomVec const &head, LitVec const &body) {
+    key_.assign({CHOICE, int(head.size())});
+    key_.insert(key_.end(), head.begin(), head.end());
+    std::sort(key_.begin() + 2, key_.end());
+    auto it = key_.insert(key_.end(), body.begin(), body.end());
+    std::sort(it, key_.end());
+    key_.erase(std::unique(key_.begin() + 2 + head.size(), key_.end()), key_.end());
+    if (add(key_)) { out_->printChoiceRule(head, body); }
+}
+void DedupLparseOutputter::printCardinalityRule(unsigned head, unsigned lower, LitVec const &body) {
+    key_.assign({CARDINALITY, int(head), int(lower)});
+    key_.insert(key_.end(), body.begin(), body.end());
+    std::sort(key_.begin() + 3, key_.end());
+    if (add(key_)) { out_->printCardinalityRule(head, lower, body); }
+}
+void DedupLparseOutputter::printWeightRule(unsigned head, unsigned lower, LitWeightVec const &body) {
+    LitWeightVec sorted(body);
+    std::sort(sorted.begin(), sorted.end());
+    key_.assign({WEIGHT, int(head), int(lower)});
+    for (auto &x : sorted) {
+        key_.emplace_back(x.first);
+        key_.emplace_back(x.second);
+    }
+    if (add(key_)) { out_->printWeightRule(head, lower, body); }
+}
+void DedupLparseOutputter::printMinimize(LitWeightVec const &body) { out_->printMinimize(body); }
+void DedupLparseOutputter::printDisjunctiveRule(AtomVec const &head, LitVec const &body) {
+    key_.assign({DISJUNCTIVE, int(head.size())});
+    key_.insert(key_.end(), head.begin(), head.end());
+    std::sort(key_.begin() + 2, key_.end());
+    auto it = key_.insert(key_.end(), body.begin(), body.end());
+    std::sort(it, key_.end());
+    key_.erase(std::unique(key_.begin() + 2 + head.size(), key_.end()), key_.end());
+    if (add(key_)) { out_->printDisjunctiveRule(head, body); }
+}
+bool DedupLparseOutputter::add(Key const &key) {
+    size_t hash = get_value_hash(key);
+    for (auto range = index_.equal_range(hash); range.first != range.second; ++range.first) {
+        if (ring_[range.first->second] == key) {
+            ++removed_;
+            return false;
+        }
+    }
+    if (key.front() == BASIC && subsumed(key)) {
+        ++removed_;
+        return false;
+    }
+    evict(next_);
+    ring_[next_] = key;
+    index_.emplace(hash, next_);
+    if (key.front() == BASIC) { heads_.emplace(key[1], next_); }
+    next_ = (next_ + 1) % ring_.size();
+    return true;
+}
+bool DedupLparseOutputter::subsumed(Key const &key) const {
+    // NOTE: only a few rules with the same head are inspected to keep this cheap
+    unsigned tries = 16;
+    for (auto range = heads_.equal_range(key[1]); range.first != range.second && tries--; ++range.first) {
+        Key const &other = ring_[range.first->second];
+        if (other.size() < key.size() && std::includes(key.begin() + 2, key.end(), other.begin() + 2, other.end())) {
+            return true;
+        }
+    }
+    return false;
+}
+void DedupLparseOutputter::evict(unsigned slot) {
+    Key &key = ring_[slot];
+    if (key.empty()) { return; }
+    for (auto range = index_.equal_range(get_value_hash(key)); range.first != range.second; ++range.first) {
+        if (range.first->second == slot) {
+            index_.erase(range.first);
+            break;
+        }
+    }
+    if (key.front() == BASIC) {
+        for (auto range = heads_.equal_range(key[1]); range.first != range.second; ++range.first) {
+            if (range.first->second == slot) {
+                heads_.erase(range.first);
+                break;
+            }
+        }
+    }
+    key.clear();
+}
+void DedupLparseOutputter::clear() {
+    for (auto &key : ring_) { key.clear(); }
+    index_.clear();
+    heads_.clear();
+    next_ = 0;
+}
+unsigned DedupLparseOutputter::falseUid() { return out_->falseUid(); }
+unsigned DedupLparseOutputter::newUid() { return out_->newUid(); }
+void DedupLparseOutputter::finishRules() {
+    out_->removedRules(removed_);
+    removed_ = 0;
+    clear();
+    out_->finishRules();
+}
+void DedupLparseOutputter::printSymbol(unsigned atomUid, Value v) { out_->printSymbol(atomUid, v); }
+void DedupLparseOutputter::printExternal(unsigned atomUid, TruthValue type) { out_->printExternal(atomUid, type); }
+void DedupLparseOutputter::finishSymbols() { out_->finishSymbols(); }
+bool &DedupLparseOutputter::disposeMinimize() { return out_->disposeMinimize(); }
+bool DedupLparseOutputter::csp() const { return out_->csp(); }
+unsigned DedupLparseOutputter::printOrderVariable(OrderVec const &order) { return out_->printOrderVariable(order); }
+void DedupLparseOutputter::printLinearConstraint(unsigned head, LinearTermVec const &terms, int bound) { out_->printLinearConstraint(head, terms, bound); }
+bool DedupLparseOutputter::nativeAggregates() const { return out_->nativeAggregates(); }
+void DedupLparseOutputter::printSumConstraint(unsigned head, LitCoefVec const &lits, int bound) { out_->printSumConstraint(head, lits, bound); }
+void DedupLparseOutputter::removedRules(unsigned n) { out_->removedRules(n); }
+DedupLparseOutputter::~DedupLparseOutputter() { }
+
 // }}}
 // {{{ definition of OutputBase
 
@@ -912,18 +1063,22 @@ void OutputBase::checkOutPreds() {
     auto eq = [](OutputPredicates::value_type const &x, OutputPredicates::value_type const &y) { 
         return std::get<1>(x) == std::get<1>(y) && std::get<2>(x) == std::get<2>(y); 
     };
-    std::sort(outPreds.begin(), outPreds.end(), le);
-    outPreds.erase(std::unique(outPreds.begin(), outPreds.end(), eq), outPreds.end());
-    for (auto &x : outPreds) {
-        if (std::get<1>(x) != Signature("", 0) && !std::get<2>(x)) {
-            auto it(domains.find(std::get<1>(x)));
-            if (it == domains.end()) {
+    // NOTE: only show statements added since the last call are checked
+    auto mid = outPreds.begin() + std::min<size_t>(outPredsChecked, outPreds.size());
+    std::sort(mid, outPreds.end(), le);
+    for (auto it = mid; it != outPreds.end(); ++it) {
+        if (std::get<1>(*it) != Signature("", 0) && !std::get<2>(*it) && (it == mid || !eq(*(it-1), *it)) && !std::binary_search(outPreds.begin(), mid, *it, le)) {
+            auto jt(domains.find(std::get<1>(*it)));
+            if (jt == domains.end()) {
                 GRINGO_REPORT(W_ATOM_UNDEFINED) 
-                    << std::get<0>(x) << ": info: no atoms over signature occur in program:\n"
-                    << "  " << *std::get<1>(x) << "\n";
+                    << std::get<0>(*it) << ": info: no atoms over signature occur in program:\n"
+                    << "  " << *std::get<1>(*it) << "\n";
             }
         }
     }
+    std::inplace_merge(outPreds.begin(), mid, outPreds.end(), le);
+    outPreds.erase(std::unique(outPreds.begin(), outPreds.end(), eq), outPreds.end());
+    outPredsChecked = outPreds.size();
 }
 ValVec OutputBase::atoms(int atomset, std::function<bool(unsigned)> const &isTrue) const {
     Gringo::ValVec ret;
@@ -954,47 +1109,101 @@ PredicateDomain::element_type *OutputBase::find2(Gringo::Value val) {
     }
     return nullptr;
 }
-std::pair<unsigned, unsigned> OutputBase::simplify(AssignmentLookup assignment) {
+std::pair<unsigned, unsigned> OutputBase::simplify(AssignmentLookup assignment, std::vector<unsigned> const &changed) {
     // TODO: would be nice to have this one in the statistics output
     handler->simplify(assignment);
     unsigned facts = 0;
     unsigned deleted = 0;
-    for (auto &x : domains) {
-        unsigned offset = 0;
-        x.second.indices.clear();
-        x.second.fullIndices.clear();
-        x.second.exports.exports.erase(std::remove_if(x.second.exports.begin(), x.second.exports.end(), [&](Gringo::PredicateDomain::element_type &y) -> bool {
-            y.second.generation(offset);
-            if (y.second.hasUid()) {
-                auto value = assignment(y.second.uid());
-                if (!value.first) {
-                    switch (value.second) {
-                        case TruthValue::True: {
-                            // NOTE: externals cannot become facts here
-                            //       because they might get new definitions while grounding
-                            //       because there is no distinction between true and weak true
-                            //       these definitions might be skipped if a weak true external 
-                            //       is made a fact here
-                            if (!y.second.fact(false)) { ++facts; }
-                            y.second.setFact(true);
-                            break;
-                        }
-                        case TruthValue::False: {
-                            if (offset < x.second.exports.incOffset)  { --x.second.exports.incOffset; }
-                            if (offset < x.second.exports.showOffset) { --x.second.exports.showOffset; }
-                            x.second.domain.erase(y.first);
-                            ++deleted;
-                            return true;
-                        }
-                        default: { break; }
+    std::unordered_map<PredicateDomain*, std::unordered_set<PredicateDomain::element_type*>> falseAtoms;
+    // marks atoms that became true as facts and collects atoms that became false
+    // NOTE: facts need not be looked up because their truth value cannot change anymore
+    auto check = [&](PredicateDomain &dom, PredicateDomain::element_type &y) {
+        if (y.second.hasUid() && !y.second.fact(false)) {
+            auto value = assignment(y.second.uid());
+            if (!value.first) {
+                switch (value.second) {
+                    case TruthValue::True: {
+                        // NOTE: externals cannot become facts here
+                        //       because they might get new definitions while grounding
+                        //       because there is no distinction between true and weak true
+                        //       these definitions might be skipped if a weak true external 
+                        //       is made a fact here
+                        ++facts;
+                        y.second.setFact(true);
+                        break;
                     }
+                    case TruthValue::False: { falseAtoms[&dom].emplace(&y); break; }
+                    default:                { break; }
                 }
             }
+        }
+    };
+    // registers an atom for later lookups by uid and checks its current assignment
+    auto add = [&](PredicateDomain &dom, PredicateDomain::element_type &y) {
+        if (y.second.hasUid()) {
+            unsigned uid = y.second.uid();
+            if (uidAtoms.size() <= uid) { uidAtoms.resize(uid + 1); }
+            uidAtoms[uid] = y.first;
+            check(dom, y);
+        }
+        else if (!y.second.fact(false)) { uidPending.emplace_back(y.first); }
+    };
+    // first: atoms that did not have a uid when last checked
+    ValVec pending;
+    pending.swap(uidPending);
+    for (auto &x : pending) {
+        auto it = domains.find(x.sig());
+        if (it != domains.end()) {
+            auto jt = it->second.domain.find(x);
+            if (jt != it->second.domain.end() && jt->second.defined()) { add(it->second, *jt); }
+        }
+    }
+    // second: atoms exported since the last call
+    for (auto &x : domains) {
+        auto &exports = x.second.exports;
+        for (auto it = exports.begin() + exports.simplifyOffset, ie = exports.end(); it != ie; ++it) {
+            add(x.second, *it);
+        }
+        exports.simplifyOffset = exports.size();
+    }
+    // third: atoms whose assignment changed since the last call
+    for (auto uid : changed) {
+        if (uid < uidAtoms.size() && (uidAtoms[uid].type() == Value::ID || uidAtoms[uid].type() == Value::FUNC)) {
+            auto it = domains.find(uidAtoms[uid].sig());
+            if (it != domains.end()) {
+                auto jt = it->second.domain.find(uidAtoms[uid]);
+                if (jt != it->second.domain.end() && jt->second.defined() && jt->second.hasUid() && jt->second.uid() == uid) {
+                    check(it->second, *jt);
+                }
+            }
+        }
+    }
+    // NOTE: domains without false atoms are left as is to keep their indices
+    //       and atoms before the first false atom keep their generation
+    for (auto &x : falseAtoms) {
+        auto &dom     = *x.first;
+        auto &exports = dom.exports;
+        unsigned offset = 0;
+        bool shift = false;
+        dom.indices.clear();
+        dom.fullIndices.clear();
+        exports.exports.erase(std::remove_if(exports.begin(), exports.end(), [&](Gringo::PredicateDomain::element_type &y) -> bool {
+            if (x.second.find(&y) != x.second.end()) {
+                if (offset < exports.incOffset)      { --exports.incOffset; }
+                if (offset < exports.showOffset)     { --exports.showOffset; }
+                if (offset < exports.simplifyOffset) { --exports.simplifyOffset; }
+                uidAtoms[y.second.uid()] = Value();
+                dom.domain.erase(y.first);
+                ++deleted;
+                shift = true;
+                return true;
+            }
+            if (shift) { y.second.generation(offset); }
             ++offset;
             return false;
-        }), x.second.exports.end());
-        x.second.exports.generation_     = 0;
-        x.second.exports.nextGeneration_ = x.second.exports.size();
+        }), exports.end());
+        exports.generation_     = 0;
+        exports.nextGeneration_ = exports.size();
     }
     return {facts, deleted};
 }
@@ -321,6 +321,41 @@ WeightRule *WeightRule::clone() const {
 bool WeightRule::isIncomplete() const { return false; }
 WeightRule::~WeightRule() { }
 
+// }}}
+// {{{ definition of SumConstraint
+
+SumConstraint::SumConstraint(SAuxAtom head, int bound, ULitWeightVec &&body) : head(std::move(head)), body(std::move(body)), bound(bound) { }
+void SumConstraint::printPlain(std::ostream &out) const {
+    out << *head << ":-#sum{";
+    if (!body.empty()) {
+        auto it(body.begin()), ie(body.end());
+        out << it->second << ":";
+        it->first->printPlain(out);
+        for (++it; it != ie; ++it) { 
+            out << ";" << it->second << ":";
+            it->first->printPlain(out);
+        }
+    }
+    out << "}>=" << bound << ".\n";
+}
+void SumConstraint::toLparse(LparseTranslator &x) {
+    for (auto &y : body) { Term::replace(y.first, y.first->toLparse(x)); }
+    x(*this);
+}
+void SumConstraint::printLparse(LparseOutputter &out) const {
+    if(!head->uid) { head->uid = out.newUid(); }
+    LparseOutputter::LitCoefVec lits;
+    for (auto &x : body) { lits.emplace_back(x.first->lparseUid(out), x.second); }
+    out.printChoiceRule({head->uid}, {});
+    out.printSumConstraint(head->uid, lits, bound);
+}
+SumConstraint *SumConstraint::clone() const {
+    auto ret(make_unique<SumConstraint>(head, bound, get_clone(body)));
+    return ret.release();
+}
+bool SumConstraint::isIncomplete() const { return false; }
+SumConstraint::~SumConstraint() { }
+
 // }}}
 // {{{ definition of HeadAggregateState
 
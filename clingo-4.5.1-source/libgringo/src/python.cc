@@ -28,8 +28,10 @@
 #include "gringo/locatable.hh"
 #include "gringo/logger.hh"
 #include "gringo/control.hh"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <limits>
 
 #if PY_MAJOR_VERSION >= 3
 #define PyString_FromString PyUnicode_FromString
@@ -109,6 +111,7 @@ bool pyToVals(PyObject *obj, ValVec &vals) { return pyToVals({obj, true}, vals);
 PyObject *valToPy(Value v);
 template <class T>
 PyObject *valsToPy(T const & vals);
+PyObject *assumptionsToPy(Gringo::Control::Assumptions const &ass);
 
 template <typename T>
 bool protect(T f) {
@@ -1058,6 +1061,17 @@ struct SolveFuture {
         if (!protect([self]() { PyUnblock b; (void)b; self->future->cancel(); })) { return nullptr; }
         Py_RETURN_NONE;
     }
+    static PyObject *unsat_core(SolveFuture *self, PyObject *args, PyObject *kwds) {
+        static char const *kwlist[] = {"minimize", "time_limit", nullptr};
+        PyObject *pyMin = Py_False;
+        double timeLimit = 0;
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "|Od", const_cast<char **>(kwlist), &pyMin, &timeLimit)) { return nullptr; }
+        int minimize = PyObject_IsTrue(pyMin);
+        if (minimize == -1) { return nullptr; }
+        Gringo::Control::Assumptions core;
+        if (!protect([self, minimize, timeLimit, &core]() { PyUnblock b; (void)b; core = self->future->unsatCore(minimize, timeLimit); })) { return nullptr; }
+        return assumptionsToPy(core);
+    }
 };
 
 PyMethodDef SolveFuture::methods[] = {
@@ -1084,6 +1098,11 @@ Interrupts the running search.
 
 Note that unlike other functions of this class, this function can safely be
 called from other threads.)"},
+    {"unsat_core", (PyCFunction)unsat_core, METH_KEYWORDS | METH_VARARGS,
+R"(unsat_core(self, minimize, time_limit) -> list of (atom, boolean) tuples
+
+Waits for the search to finish and returns the unsatisfiable core of the
+search (see Control.unsat_core).)"},
     {nullptr, nullptr, 0, nullptr}
 };
 
@@ -1734,6 +1753,62 @@ struct DomainProxy {
         return DomainIter::new_(std::move(elem));
     }
 
+    // Returns a triple of lists holding the atoms (or whether they are in
+    // the domain if atoms is null), and their fact and external flags.
+    static PyObject* flagsToPy(ValVec const *atoms, std::vector<unsigned> const &flags) {
+        Object pyFirst = PyList_New(flags.size());
+        if (!pyFirst) { return nullptr; }
+        Object pyFacts = PyList_New(flags.size());
+        if (!pyFacts) { return nullptr; }
+        Object pyExternals = PyList_New(flags.size());
+        if (!pyExternals) { return nullptr; }
+        for (size_t i = 0; i != flags.size(); ++i) {
+            PyObject *first = atoms ? valToPy((*atoms)[i]) : PyBool_FromLong(flags[i] & Gringo::DomainProxy::FOUND);
+            if (!first) { return nullptr; }
+            PyList_SET_ITEM(pyFirst.get(), i, first);
+            PyList_SET_ITEM(pyFacts.get(), i, PyBool_FromLong(flags[i] & Gringo::DomainProxy::FACT));
+            PyList_SET_ITEM(pyExternals.get(), i, PyBool_FromLong(flags[i] & Gringo::DomainProxy::EXTERNAL));
+        }
+        return PyTuple_Pack(3, pyFirst.get(), pyFacts.get(), pyExternals.get());
+    }
+
+    static PyObject* scan(DomainProxy *self, PyObject *pyargs, PyObject *pykwds) {
+        static char const *kwlist[] = {"name", "arity", "offset", "size", nullptr};
+        char const *name;
+        int arity;
+        Py_ssize_t offset = 0;
+        Py_ssize_t size   = 1024;
+        if (!PyArg_ParseTupleAndKeywords(pyargs, pykwds, "si|nn", const_cast<char**>(kwlist), &name, &arity, &offset, &size)) { return nullptr; }
+        if (offset < 0 || size < 0) { return PyErr_Format(PyExc_RuntimeError, "offset and size must be non-negative"); }
+        ValVec atoms;
+        std::vector<unsigned> flags;
+        if (!protect([self, name, arity, offset, size, &atoms, &flags]() {
+            Signature sig(name, arity);
+            // only allocate space for the atoms actually available
+            size_t available = self->proxy->length(sig);
+            size_t n = std::min<size_t>(size, available - std::min<size_t>(offset, available));
+            atoms.resize(n);
+            flags.resize(n);
+            n = self->proxy->scan(sig, offset, n, atoms.data(), flags.data());
+            atoms.resize(n);
+            flags.resize(n);
+        })) { return nullptr; }
+        return flagsToPy(&atoms, flags);
+    }
+
+    static PyObject* lookup_many(DomainProxy *self, PyObject *pyargs) {
+        PyObject *pyAtoms;
+        if (!PyArg_ParseTuple(pyargs, "O", &pyAtoms)) { return nullptr; }
+        ValVec atoms;
+        if (!pyToVals(pyAtoms, atoms)) { return nullptr; }
+        std::vector<unsigned> flags;
+        if (!protect([self, &atoms, &flags]() {
+            flags.resize(atoms.size());
+            self->proxy->lookup(atoms.data(), atoms.size(), flags.data());
+        })) { return nullptr; }
+        return flagsToPy(nullptr, flags);
+    }
+
     static PyObject* signatures(DomainProxy *self) {
         std::vector<FWSignature> ret;
         if (!protect([self, &ret]() { ret = self->proxy->signatures(); })) { return nullptr; }
@@ -1764,6 +1839,39 @@ arity -- the arity of the signature
 R"(signatures(self) -> list((str, int))
 
 Returns the list of predicate signatures occurring in the program.
+)"},
+    {"scan", (PyCFunction)scan, METH_KEYWORDS | METH_VARARGS,
+R"(scan(self, name, arity, offset, size) -> (list(term), list(bool), list(bool))
+
+Returns a batch of at most size domain elements with the given signature
+starting at position offset as a triple of lists holding the atoms and whether
+they are facts or externals, respectively. This is much faster than iterating
+over large domains element by element.
+
+Arguments:
+name  -- the name of the signature
+arity -- the arity of the signature
+
+Keyword Arguments:
+offset -- position of the first element in the domain (default: 0)
+size   -- maximum number of elements to return (default: 1024)
+
+Example:
+
+offset = 0
+while True:
+    atoms, facts, externals = prg.domains.scan("p", 1, offset, 4096)
+    if not atoms: break
+    offset += len(atoms)
+)"},
+    {"lookup_many", (PyCFunction)lookup_many, METH_VARARGS,
+R"(lookup_many(self, atoms) -> (list(bool), list(bool), list(bool))
+
+Looks up a list of atoms at once. Returns a triple of lists holding whether
+each atom is in the domain, is a fact, or is an external, respectively.
+
+Arguments:
+atoms -- the list of atoms to look up
 )"},
     {nullptr, nullptr, 0, nullptr}
 };
@@ -1956,6 +2064,17 @@ struct ControlWrap {
         if (!protect([self, filename]() { self->ctl->load(filename); })) { return nullptr; }
         Py_RETURN_NONE;
     }
+    static PyObject *load_facts(ControlWrap *self, PyObject *args, PyObject *kwds) {
+        if (!checkBlocked(self, "load_facts")) { return nullptr; }
+        static char const *kwlist[] = {"path", "predicate", "format", "header", nullptr};
+        char const *filename, *predicate, *format = "";
+        PyObject *pyHeader = Py_False;
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "ss|sO", const_cast<char **>(kwlist), &filename, &predicate, &format, &pyHeader)) { return nullptr; }
+        int header = PyObject_IsTrue(pyHeader);
+        if (header == -1) { return nullptr; }
+        if (!protect([self, filename, predicate, format, header]() { self->ctl->loadFacts(filename, predicate, format, header); })) { return nullptr; }
+        Py_RETURN_NONE;
+    }
     static PyObject *ground(ControlWrap *self, PyObject *args, PyObject *kwds) { 
         if (!checkBlocked(self, "ground")) { return nullptr; }
         Gringo::Control::GroundVec parts;
@@ -2089,12 +2208,15 @@ struct ControlWrap {
         Py_XDECREF(self->stats);
         self->stats = nullptr;
         PyObject *pyAss = nullptr;
-        static char const *kwlist[] = {"assumptions", nullptr};
-        if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", const_cast<char **>(kwlist), &pyAss)) { return nullptr; }
+        Py_ssize_t size = 0;
+        static char const *kwlist[] = {"assumptions", "queue_size", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "|On", const_cast<char **>(kwlist), &pyAss, &size)) { return nullptr; }
+        if (size < 0) { return PyErr_Format(PyExc_RuntimeError, "queue size must be non-negative"); }
+        unsigned queueSize = size > std::numeric_limits<unsigned>::max() ? std::numeric_limits<unsigned>::max() : size;
         Gringo::Control::Assumptions ass;
         if (!getAssumptions(pyAss, ass)) { return nullptr; }
         Gringo::SolveIter *iter;
-        if (!protect([self, &iter, &ass]() { iter = (self->ctl->solveIter(std::move(ass))); })) { return nullptr; }
+        if (!protect([self, &iter, &ass, queueSize]() { iter = (self->ctl->solveIter(std::move(ass), queueSize)); })) { return nullptr; }
         PyObject *ret = SolveIter::new_(*iter);
         return ret;
     }
@@ -2118,6 +2240,18 @@ struct ControlWrap {
         })) { return nullptr; }
         return SolveResult::get(ret);
     }
+    static PyObject *unsat_core(ControlWrap *self, PyObject *args, PyObject *kwds) {
+        if (!checkBlocked(self, "unsat_core")) { return nullptr; }
+        static char const *kwlist[] = {"minimize", "time_limit", nullptr};
+        PyObject *pyMin = Py_False;
+        double timeLimit = 0;
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "|Od", const_cast<char **>(kwlist), &pyMin, &timeLimit)) { return nullptr; }
+        int minimize = PyObject_IsTrue(pyMin);
+        if (minimize == -1) { return nullptr; }
+        Gringo::Control::Assumptions core;
+        if (!protect([self, minimize, timeLimit, &core]() { PyUnblock b; (void)b; core = self->ctl->unsatCore(minimize, timeLimit); })) { return nullptr; }
+        return assumptionsToPy(core);
+    }
     static PyObject *cleanup_domains(ControlWrap *self) {
         if (!checkBlocked(self, "cleanup_domains")) { return nullptr; }
         if (!protect([self]() { self->ctl->cleanupDomains(); })) { return nullptr; }
@@ -2259,6 +2393,34 @@ Extend the logic program with a (non-ground) logic program in a file.
 
 Arguments:
 path -- path to program)"},
+    // load_facts
+    {"load_facts",      (PyCFunction)load_facts,      METH_KEYWORDS | METH_VARARGS,
+R"(load_facts(self, path, predicate, format, header) -> None
+
+Extend the base part of the logic program with one fact per row of a table.
+
+Each row of the table becomes an atom over the given predicate name whose
+arguments are the fields of the row. Fields are mapped to numbers, constants,
+or strings. The file is memory mapped and its rows are parsed in parallel.
+
+Arguments:
+path      -- path to the table
+predicate -- name of the predicate
+
+Keyword Arguments:
+format    -- "csv", "tsv", or "bin" for the binary columnar format
+             (default: determined by the file extension)
+header    -- whether the first line of a delimited file is skipped
+             (default: False)
+
+Example:
+
+#script (python)
+def main(prg):
+    prg.load_facts("edges.csv", "edge")
+    prg.ground([("base", [])])
+    prg.solve()
+#end.)"},
     // solve_async
     {"solve_async",         (PyCFunction)solve_async,         METH_KEYWORDS | METH_VARARGS,  
 R"(solve_async(self, assumptions, on_model, on_finish) -> SolveFuture
@@ -2306,7 +2468,7 @@ q
 SAT False)"},
     // solve_iter
     {"solve_iter",          (PyCFunction)solve_iter,          METH_KEYWORDS | METH_VARARGS,  
-R"(solve_iter(self, assumptions) -> SolveIter
+R"(solve_iter(self, assumptions, queue_size) -> SolveIter
 
 Returns a SolveIter object, which can be used to iterate over models.
 
@@ -2314,6 +2476,13 @@ Keyword Arguments:
 assumptions -- a list of (atom, boolean) tuples that serve as assumptions for
                the solve call, e.g. - solving under assumptions [(Fun("a"),
                True)] only admits answer sets that contain atom a
+queue_size  -- if greater than zero, the search runs ahead of the iterator in
+               the background buffering up to queue_size models; the size
+               must not exceed 65536 (default: 0)
+
+Note that models obtained with a positive queue_size are copies. They provide
+the shown atoms and all atoms (Model.SHOWN and Model.ATOMS) and their costs but
+do not support Model.add_clause.
 
 Example:
  
@@ -2349,6 +2518,35 @@ This function releases the GIL but it is not thread-safe.
 
 Take a look at Control.solve_async for an example on how to use the model
 callback.)"},
+    // unsat_core
+    {"unsat_core", (PyCFunction)unsat_core, METH_KEYWORDS | METH_VARARGS,
+R"(unsat_core(self, minimize, time_limit) -> list of (atom, boolean) tuples
+
+Returns the assumptions the unsatisfiability of the last solve call depends
+on. The list is empty if the last search was not unsatisfiable (or if it is
+unsatisfiable independent of the assumptions).
+
+Keyword Arguments:
+minimize   -- whether to remove assumptions that are not needed for the
+              unsatisfiability by solving again (default: False)
+time_limit -- stop minimizing after time_limit seconds and return the core
+              found so far; 0 means no limit (default: 0)
+
+Note that the core is computed by the sequential solver; if several solving
+threads are used, all assumptions are returned unless minimize is True.
+
+Example:
+
+#script (python)
+import gringo
+
+def main(prg):
+    prg.add("p", "{a;b;c}. :- a, b.")
+    prg.ground([("p", [])])
+    prg.solve([(gringo.Fun("a"), True), (gringo.Fun("b"), True), (gringo.Fun("c"), True)])
+    print prg.unsat_core(True)
+
+#end.)"},
     // cleanup_domains
     {"cleanup_domains", (PyCFunction)cleanup_domains, METH_NOARGS,
 R"(cleanup_domains(self) -> None
@@ -2779,6 +2977,23 @@ PyObject *valsToPy(T const &vals) {
     return list.release();
 }
 
+PyObject *assumptionsToPy(Gringo::Control::Assumptions const &ass) {
+    Object list = PyList_New(ass.size());
+    if (!list) { return nullptr; }
+    int i = 0;
+    for (auto &x : ass) {
+        Object pyAtom = valToPy(x.first);
+        if (!pyAtom) { return nullptr; }
+        Object pyBool = PyBool_FromLong(x.second);
+        if (!pyBool) { return nullptr; }
+        Object pyPair = PyTuple_Pack(2, pyAtom.get(), pyBool.get());
+        if (!pyPair) { return nullptr; }
+        if (PyList_SetItem(list, i, pyPair.release()) < 0) { return nullptr; }
+        ++i;
+    }
+    return list.release();
+}
+
 bool pyToVals(Object obj, ValVec &vals) {
     Object it = PyObject_GetIter(obj);
     if (!it) { return false; }
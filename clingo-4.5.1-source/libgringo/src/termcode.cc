@@ -0,0 +1,213 @@
+// {{{ GPL License
+
+// This file is part of gringo - a grounder for logic programs.
+// Copyright (C) 2013  Roland Kaminski
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// }}}
+
+#include "gringo/termcode.hh"
+#include "gringo/logger.hh"
+#include <algorithm>
+#include <cmath>
+
+namespace Gringo {
+
+// {{{ definition of TermCode
+
+TermCode::TermCode(Term const &term) {
+    compileEval(term);
+    compileMatch(term);
+    stack_.resize(std::max(evalCode_.size(), matchCode_.size()) + 1);
+}
+
+void TermCode::compileEval(Term const &term) {
+    if (auto t = dynamic_cast<ValTerm const*>(&term)) {
+        evalCode_.emplace_back(Op::VAL, term, t->value);
+    }
+    else if (auto t = dynamic_cast<VarTerm const*>(&term)) {
+        evalCode_.emplace_back(Op::VAR, term, Value(), t->ref.get());
+    }
+    else if (auto t = dynamic_cast<LinearTerm const*>(&term)) {
+        evalCode_.emplace_back(Op::LINEAR, term, Value(), t->var->ref.get(), t->m, t->n);
+    }
+    else if (auto t = dynamic_cast<UnOpTerm const*>(&term)) {
+        compileEval(*t->arg);
+        switch (t->op) {
+            case UnOp::NEG: { evalCode_.emplace_back(Op::NEG, term); break; }
+            case UnOp::ABS: { evalCode_.emplace_back(Op::ABS, term); break; }
+            case UnOp::NOT: { evalCode_.emplace_back(Op::NOT, term); break; }
+        }
+    }
+    else if (auto t = dynamic_cast<BinOpTerm const*>(&term)) {
+        compileEval(*t->left);
+        compileEval(*t->right);
+        evalCode_.emplace_back(static_cast<Op>(static_cast<int>(Op::XOR) + static_cast<int>(t->op)), term);
+    }
+    else if (auto t = dynamic_cast<FunctionTerm const*>(&term)) {
+        for (auto &x : t->args) { compileEval(*x); }
+        evalCode_.emplace_back(Op::FUN, term, Value(), nullptr, 1, 0, t->args.size());
+    }
+    else { evalCode_.emplace_back(Op::TERM, term); }
+}
+
+void TermCode::compileMatch(Term const &term) {
+    if (auto t = dynamic_cast<ValTerm const*>(&term)) {
+        matchCode_.emplace_back(Op::VAL, term, t->value);
+    }
+    else if (auto t = dynamic_cast<VarTerm const*>(&term)) {
+        matchCode_.emplace_back(Op::VAR, term, Value(), t->ref.get());
+    }
+    else if (auto t = dynamic_cast<LinearTerm const*>(&term)) {
+        matchCode_.emplace_back(Op::LINEAR, term, Value(), nullptr, t->m, t->n);
+    }
+    else if (auto t = dynamic_cast<UnOpTerm const*>(&term)) {
+        if (t->op == UnOp::NEG) {
+            matchCode_.emplace_back(Op::NEG, term);
+            compileMatch(*t->arg);
+        }
+        else { matchCode_.emplace_back(Op::TERM, term); }
+    }
+    else if (auto t = dynamic_cast<FunctionTerm const*>(&term)) {
+        matchCode_.emplace_back(Op::FUN, term, Value(), nullptr, 1, 0, t->args.size());
+        for (auto &x : t->args) { compileMatch(*x); }
+    }
+    else { matchCode_.emplace_back(Op::TERM, term); }
+}
+
+Value TermCode::undefinedOp(Term const &term, bool &undefined) {
+    undefined = true;
+    GRINGO_REPORT(W_OPERATION_UNDEFINED)
+        << term.loc() << ": info: operation undefined:\n"
+        << "  " << term << "\n";
+    return Value::createNum(0);
+}
+
+Value TermCode::eval(bool &undefined) const {
+    assert(!empty());
+    Value *top = stack_.data();
+    for (auto &instr : evalCode_) {
+        switch (instr.op) {
+            case Op::VAL: { *top++ = instr.val; break; }
+            case Op::VAR: { *top++ = *instr.ref; break; }
+            case Op::LINEAR: {
+                Value value = *instr.ref;
+                *top++ = value.type() == Value::NUM
+                    ? Value::createNum(instr.m * value.num() + instr.n)
+                    : undefinedOp(*instr.term, undefined);
+                break;
+            }
+            case Op::NEG: {
+                Value &value = top[-1];
+                if (value.type() == Value::NUM)                                    { value = Value::createNum(-value.num()); }
+                else if (value.type() == Value::ID || value.type() == Value::FUNC) { value = value.flipSign(); }
+                else                                                               { value = undefinedOp(*instr.term, undefined); }
+                break;
+            }
+            case Op::ABS: 
+            case Op::NOT: {
+                Value &value = top[-1];
+                if (value.type() != Value::NUM) { value = undefinedOp(*instr.term, undefined); }
+                else if (instr.op == Op::ABS)   { value = Value::createNum(std::abs(value.num())); }
+                else                            { value = Value::createNum(~value.num()); }
+                break;
+            }
+            case Op::XOR:
+            case Op::OR:
+            case Op::AND:
+            case Op::ADD:
+            case Op::SUB:
+            case Op::MUL:
+            case Op::DIV:
+            case Op::MOD:
+            case Op::POW: {
+                Value r = *--top;
+                Value &l = top[-1];
+                if (l.type() == Value::NUM && r.type() == Value::NUM && (instr.op != Op::DIV || r.num() != 0)) {
+                    int x = l.num(), y = r.num();
+                    switch (instr.op) {
+                        case Op::ADD: { l = Value::createNum(x + y); break; }
+                        case Op::SUB: { l = Value::createNum(x - y); break; }
+                        case Op::MUL: { l = Value::createNum(x * y); break; }
+                        default:      { l = Value::createNum(Gringo::eval(static_cast<BinOp>(static_cast<int>(instr.op) - static_cast<int>(Op::XOR)), x, y)); break; }
+                    }
+                }
+                else { l = undefinedOp(*instr.term, undefined); }
+                break;
+            }
+            case Op::FUN: {
+                top -= instr.arity;
+                args_.assign(top, top + instr.arity);
+                *top++ = Value::createFun(static_cast<FunctionTerm const*>(instr.term)->name, args_);
+                break;
+            }
+            case Op::TERM: { *top++ = instr.term->eval(undefined); break; }
+        }
+    }
+    assert(top == stack_.data() + 1);
+    return stack_.front();
+}
+
+bool TermCode::match(Value const &x) const {
+    assert(!empty());
+    Value *top = stack_.data();
+    *top++ = x;
+    for (auto &instr : matchCode_) {
+        Value value = *--top;
+        switch (instr.op) {
+            case Op::VAL: {
+                if (instr.val != value) { return false; }
+                break;
+            }
+            case Op::VAR: {
+                if (static_cast<VarTerm const*>(instr.term)->bindRef) { *instr.ref = value; }
+                else if (value != *instr.ref)                         { return false; }
+                break;
+            }
+            case Op::LINEAR: {
+                if (value.type() != Value::NUM) { return false; }
+                assert(instr.m != 0);
+                int c(value.num() - instr.n);
+                if (c % instr.m != 0 || !static_cast<LinearTerm const*>(instr.term)->var->match(Value::createNum(c / instr.m))) { return false; }
+                break;
+            }
+            case Op::NEG: {
+                if (value.type() == Value::NUM)                                    { *top++ = Value::createNum(-value.num()); }
+                else if (value.type() == Value::ID || value.type() == Value::FUNC) { *top++ = value.flipSign(); }
+                else                                                               { return false; }
+                break;
+            }
+            case Op::FUN: {
+                if (value.type() != Value::FUNC) { return false; }
+                Signature s(*value.sig());
+                if (s.sign() || s.name() != static_cast<FunctionTerm const*>(instr.term)->name || s.length() != instr.arity) { return false; }
+                // the first argument is matched first
+                FWValVec args(value.args());
+                for (auto it = args.end(), ie = args.begin(); it != ie; ) { *top++ = *--it; }
+                break;
+            }
+            default: {
+                if (!instr.term->match(value)) { return false; }
+                break;
+            }
+        }
+    }
+    assert(top == stack_.data());
+    return true;
+}
+
+// }}}
+
+} // namespace Gringo
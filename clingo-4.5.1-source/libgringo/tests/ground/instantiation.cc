@@ -59,6 +59,7 @@ class TestInstantiation : public CppUnit::TestFixture {
         CPPUNIT_TEST(test_optimize);
         CPPUNIT_TEST(test_neg);
         CPPUNIT_TEST(test_tuple);
+        CPPUNIT_TEST(test_range);
     CPPUNIT_TEST_SUITE_END();
 public:
     typedef std::string S;
@@ -99,6 +100,7 @@ public:
     void test_optimize();
     void test_neg();
     void test_tuple();
+    void test_range();
 
     virtual ~TestInstantiation();
 };
@@ -1216,6 +1218,31 @@ void TestInstantiation::test_tuple() {
             "p(((),())).\n"));
 }
 
+void TestInstantiation::test_range() {
+    CPPUNIT_ASSERT_EQUAL(
+        std::string(
+            "a(10).\n"
+            "a(8).\n"
+            "a(9).\n"
+            "b(10).\n"
+            "b(11).\n"
+            "b(7).\n"
+            "b(8).\n"
+            "b(9).\n"
+            "c(10).\n"
+            "c(9).\n"
+            "e(1,-1).\n"
+            "e(3,-2).\n"
+            "e(5,-3).\n"),
+        ground(
+            "n(5).\n"
+            "a(X):-X=1..10,X>7.\n"
+            "b(X):-n(N),X=1..N*N,2*X+1>=3*N,Z=X,Z<12.\n"
+            "c(X):-X=1..10,X<a,X>=9.\n"
+            "d(X):-X=1..10,X>a.\n"
+            "e(X,Y):-n(N),X=1..N,Y=-N..N,-2*Y=X+1.\n", {"a(", "b(", "c(", "d(", "e("}));
+}
+
 TestInstantiation::~TestInstantiation() { }
 
 // }}}
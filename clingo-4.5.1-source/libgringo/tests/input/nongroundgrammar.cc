@@ -116,6 +116,7 @@ public:
     // {{{ statements
     virtual void rule(Location const &loc, HdLitUid head);
     virtual void rule(Location const &loc, HdLitUid head, BdLitVecUid body);
+    virtual void fact(Location const &loc, Value atom);
     virtual void define(Location const &loc, FWString name, TermUid value, bool defaultDef);
     virtual void optimize(Location const &loc, TermUid weight, TermUid priority, TermVecUid cond, BdLitVecUid body);
     virtual void showsig(Location const &loc, FWSignature sig, bool csp);
@@ -124,6 +125,7 @@ public:
     virtual void lua(Location const &loc, FWString code);
     virtual void block(Location const &loc, FWString name, IdVecUid args);
     virtual void external(Location const &loc, LitUid head, BdLitVecUid body);
+    virtual void query(Location const &loc, LitUid lit);
     // }}}
 
     std::string toString();
@@ -199,11 +201,13 @@ class TestNongroundGrammar : public CppUnit::TestFixture {
         CPPUNIT_TEST(test_conjunction);
         CPPUNIT_TEST(test_disjunction);
         CPPUNIT_TEST(test_rule);
+        CPPUNIT_TEST(test_fact);
         CPPUNIT_TEST(test_define);
         CPPUNIT_TEST(test_optimize);
         CPPUNIT_TEST(test_show);
         CPPUNIT_TEST(test_include);
         CPPUNIT_TEST(test_csp);
+        CPPUNIT_TEST(test_query);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -218,11 +222,13 @@ public:
     void test_conjunction();
     void test_disjunction();
     void test_rule();
+    void test_fact();
     void test_define();
     void test_optimize();
     void test_show();
     void test_include();
     void test_csp();
+    void test_query();
 
     virtual ~TestNongroundGrammar();
 
@@ -544,6 +550,11 @@ void TestNongroundProgramBuilder::rule(Location const &, HdLitUid head) {
     statements_.emplace_back(str());
 }
 
+void TestNongroundProgramBuilder::fact(Location const &, Value atom) {
+    current_ << atom << ".";
+    statements_.emplace_back(str());
+}
+
 void TestNongroundProgramBuilder::rule(Location const &, HdLitUid head, BdLitVecUid bodyuid) {
     current_ << heads_.erase(head);
     StringVec body(bodies_.erase(bodyuid));
@@ -617,6 +628,11 @@ void TestNongroundProgramBuilder::external(Location const &, LitUid head, BdLitV
     statements_.emplace_back(str());
 }
 
+void TestNongroundProgramBuilder::query(Location const &, LitUid lit) {
+    current_ << "#query " << lits_.erase(lit) << ".";
+    statements_.emplace_back(str());
+}
+
 
 // }}}
 // {{{ auxiliary functions
@@ -724,7 +740,8 @@ void TestNongroundGrammar::test_term() {
     CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np(((1,2,3)))."), parse("p((1,2,3))."));
     CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np((();();();(1,2);(3,)))."), parse("p((;;;1,2;3,))."));
     // unary operations
-    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np((-1))."), parse("p(-1)."));
+    // (plain facts like p(-1) are read by the lexer - see test_fact)
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np((-1)):-q."), parse("p(-1):-q."));
     CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np((~1))."), parse("p(~1)."));
     // binary operations
     CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np((1**2))."), parse("p(1**2)."));
@@ -933,6 +950,16 @@ void TestNongroundGrammar::test_rule() {
     CPPUNIT_ASSERT_EQUAL(std::string("#program base().\n#false:-b;c."), parse(":-b,c."));
 }
 
+void TestNongroundGrammar::test_fact() {
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np(1).\nq(a,\"x\\\"y\",-2,f(b,3),g)."), parse("p(1). q ( a, \"x\\\"y\" , -2,f(b,3), g() ) ."));
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np(1).\nq:-r.\ns(2)."), parse("p(1). q :- r. s(2)."));
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np(1).\n#program b(t).\nq(t).\nq((-t))."), parse("p(1).\n#program b(t).\nq(t).\nq(-t)."));
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\n-p(1).\np(f(g(1)))."), parse("-p(1). p(f(g(1)))."));
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np(1):-q.\np(1)."), parse("p(1) :- q. p(1)."));
+    // negative numbers are values and not unary operations
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\np(-1).\np((-1)):-q."), parse("p(-1). p(-1) :- q."));
+}
+
 void TestNongroundGrammar::test_define() {
     CPPUNIT_ASSERT_EQUAL(std::string("#program base().\n#const a=10."), parse("#const a=10."));
 }
@@ -965,6 +992,11 @@ void TestNongroundGrammar::test_csp() {
     CPPUNIT_ASSERT_EQUAL(std::string("#program base().\n#false:-a;b;not #disjoint{a:1$*$a:a,a,b:1$*$b:b}."), parse("#disjoint{a:$a:a,a; b:$b:b} :- a, b."));
 }
 
+void TestNongroundGrammar::test_query() {
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\n#query p(a,X)."), parse("#query p(a,X)."));
+    CPPUNIT_ASSERT_EQUAL(std::string("#program base().\n#query -p(f(1),_)."), parse("#query -p(f(1),_)."));
+}
+
 TestNongroundGrammar::~TestNongroundGrammar() { }
 
 // }}}
@@ -36,6 +36,7 @@ class TestIncremental : public CppUnit::TestFixture {
         CPPUNIT_TEST(test_projectionBug);
         CPPUNIT_TEST(test_lp);
         CPPUNIT_TEST(test_csp);
+        CPPUNIT_TEST(test_simplify);
     CPPUNIT_TEST_SUITE_END();
     using S = std::string;
 
@@ -48,6 +49,7 @@ public:
     void test_projectionBug();
     void test_lp();
     void test_csp();
+    void test_simplify();
     virtual ~TestIncremental();
 };
 
@@ -345,6 +347,57 @@ void TestIncremental::test_projectionBug() {
             ));
 }
 
+void TestIncremental::test_simplify() {
+    std::stringstream ss;
+    Output::PlainLparseOutputter plo(ss);
+    Output::OutputBase out({}, plo);
+    FWSignature sig = Signature("p", 1);
+    out.domains.emplace_back(std::piecewise_construct, std::forward_as_tuple(sig), std::forward_as_tuple());
+    PredicateDomain &dom = out.domains.find(sig)->second;
+    auto add = [&](int i, unsigned uid) {
+        auto ret = dom.insert(FUN("p", {NUM(i)}), false);
+        if (uid) { std::get<0>(ret)->second.uid(uid); }
+    };
+    std::map<unsigned, TruthValue> vals;
+    unsigned lookups = 0;
+    auto assignment = [&](unsigned uid) {
+        ++lookups;
+        auto it = vals.find(uid);
+        return std::make_pair(false, it == vals.end() ? TruthValue::Open : it->second);
+    };
+    auto print = [&]() {
+        std::ostringstream oss;
+        for (auto &x : dom.exports) { oss << x.get().first << (x.get().second.fact(false) ? "!" : "") << " "; }
+        return oss.str();
+    };
+    for (int i = 1; i <= 5; ++i) { add(i, i + 1); }
+    vals[3] = TruthValue::True;
+    vals[4] = TruthValue::False;
+    CPPUNIT_ASSERT_EQUAL((std::make_pair(1u, 1u)), out.simplify(assignment, {}));
+    CPPUNIT_ASSERT_EQUAL(5u, lookups);
+    CPPUNIT_ASSERT_EQUAL(S("p(1) p(2)! p(4) p(5) "), print());
+    // nothing exported or changed since the last call
+    lookups = 0;
+    CPPUNIT_ASSERT_EQUAL((std::make_pair(0u, 0u)), out.simplify(assignment, {}));
+    CPPUNIT_ASSERT_EQUAL(0u, lookups);
+    // only changed and new atoms are looked up; deleted and unknown uids are ignored
+    vals[5] = TruthValue::False;
+    vals[7] = TruthValue::False;
+    add(6, 7);
+    add(7, 0);
+    lookups = 0;
+    CPPUNIT_ASSERT_EQUAL((std::make_pair(0u, 2u)), out.simplify(assignment, {4, 5, 100}));
+    CPPUNIT_ASSERT_EQUAL(2u, lookups);
+    CPPUNIT_ASSERT_EQUAL(S("p(1) p(2)! p(5) p(7) "), print());
+    // atoms without uid are looked up once they get one
+    dom.domain.find(FUN("p", {NUM(7)}))->second.uid(8);
+    vals[8] = TruthValue::True;
+    lookups = 0;
+    CPPUNIT_ASSERT_EQUAL((std::make_pair(1u, 0u)), out.simplify(assignment, {}));
+    CPPUNIT_ASSERT_EQUAL(1u, lookups);
+    CPPUNIT_ASSERT_EQUAL(S("p(1) p(2)! p(5) p(7)! "), print());
+}
+
 TestIncremental::~TestIncremental() { }
 
 // }}}
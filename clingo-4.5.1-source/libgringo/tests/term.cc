@@ -19,6 +19,7 @@
 // }}}
 
 #include "gringo/bug.hh"
+#include "gringo/termcode.hh"
 #include "tests/tests.hh"
 #include "tests/term_helper.hh"
 
@@ -43,6 +44,7 @@ class TestTerm : public CppUnit::TestFixture {
         CPPUNIT_TEST(test_undefined);
         CPPUNIT_TEST(test_project);
         CPPUNIT_TEST(test_match);
+        CPPUNIT_TEST(test_code);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -60,6 +62,7 @@ public:
     void test_undefined();
     void test_project();
     void test_match();
+    void test_code();
 
     virtual ~TestTerm();
 
@@ -342,6 +345,33 @@ void TestTerm::test_match() {
     CPPUNIT_ASSERT(!bindVars(fun("p", binop(BinOp::SUB, val(NUM(4)), binop(BinOp::MUL, val(NUM(3)), var("X"))), unop(UnOp::NEG, var("X"))))->match(FUN("p", {NUM(1), NUM(2)})));
 }
 
+void TestTerm::test_code() {
+    bool undefined = false;
+    auto a(fun("f", val(NUM(1)), binop(BinOp::ADD, val(NUM(2)), val(NUM(3))), unop(UnOp::NEG, fun("g", val(ID("a")))), fun("h")));
+    Value expected(a->eval(undefined));
+    CPPUNIT_ASSERT_EQUAL(expected, TermCode(*a).eval(undefined));
+    CPPUNIT_ASSERT_MESSAGE("term must not be undefined", !undefined);
+    auto b(fun("f", binop(BinOp::DIV, val(NUM(7)), binop(BinOp::SUB, val(NUM(1)), val(NUM(1)))), unop(UnOp::ABS, val(ID("a")))));
+    expected = b->eval(undefined);
+    CPPUNIT_ASSERT_EQUAL(expected, TermCode(*b).eval(undefined));
+    CPPUNIT_ASSERT_MESSAGE("term has to be undefined", undefined);
+    CPPUNIT_ASSERT_EQUAL(size_t(4), messages.size());
+    CPPUNIT_ASSERT_EQUAL(messages[0], messages[2]);
+    CPPUNIT_ASSERT_EQUAL(messages[1], messages[3]);
+    auto c(bindVars(fun("p", binop(BinOp::SUB, val(NUM(4)), binop(BinOp::MUL, val(NUM(3)), var("X"))), unop(UnOp::NEG, var("X")))));
+    TermCode code(*c);
+    CPPUNIT_ASSERT(code.match(FUN("p", {NUM(-2), NUM(-2)})));
+    CPPUNIT_ASSERT(code.match(FUN("p", {NUM(-5), NUM(-3)})));
+    CPPUNIT_ASSERT(!code.match(FUN("p", {NUM(2), NUM(2)})));
+    CPPUNIT_ASSERT(!code.match(FUN("p", {NUM(1), NUM(2)})));
+    CPPUNIT_ASSERT(!code.match(FUN("p", {NUM(-2)})));
+    CPPUNIT_ASSERT(!code.match(FUN("p", {NUM(-2), NUM(-2)}).flipSign()));
+    auto d(bindVars(unop(UnOp::NEG, fun("f", var("X")))));
+    TermCode neg(*d);
+    CPPUNIT_ASSERT(neg.match(FUN("f", {NUM(0)}).flipSign()));
+    CPPUNIT_ASSERT(!neg.match(FUN("f", {NUM(0)})));
+}
+
 TestTerm::~TestTerm() { }
 
 // }}}